@@ -0,0 +1,201 @@
+/*
+ * FILE: alloc_tracker.cpp
+ *
+ * WHAT:
+ * Implements the Allocation Tracker: the size header, the phase and thread
+ * counters, and the report.
+ */
+
+#include "alloc_tracker.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <atomic>
+
+/*
+ * CONSTANT: ALLOC_HEADER_BYTES
+ *
+ * WHAT:
+ * Bytes in front of each block (its size). 16 keeps the alignment malloc
+ * guarantees for any type.
+ */
+#define ALLOC_HEADER_BYTES 16
+
+/*
+ * STRUCT: phase_counters_t / thread_counters_t
+ *
+ * WHAT:
+ * Relaxed atomic tallies. Thread slots are cache-line aligned so threads
+ * counting their own allocations do not contend.
+ */
+typedef struct _phase_counters
+{
+    std::atomic<long long> allocations;
+    std::atomic<long long> frees;
+    std::atomic<long long> bytes;
+    std::atomic<long long> peak_live_bytes;
+} phase_counters_t;
+
+typedef struct alignas(64) _thread_counters
+{
+    std::atomic<long long> allocations;
+    std::atomic<long long> bytes;
+} thread_counters_t;
+
+static phase_counters_t s_phases[ALLOC_PHASE_COUNT];
+static thread_counters_t s_threads[ALLOC_MAX_THREAD_SLOTS];
+static std::atomic<int> s_thread_slots_used(0);
+static std::atomic<int> s_phase(ALLOC_PHASE_STARTUP);
+static std::atomic<long long> s_live_bytes(0);
+static std::atomic<long long> s_peak_live_bytes(0);
+static thread_local int t_thread_slot = -1;
+
+static const char* PHASE_NAMES[ALLOC_PHASE_COUNT] = { "Startup", "Setup", "Play", "Shutdown" };
+
+/*
+ * HELPER: raise_to
+ *
+ * WHAT:
+ * Lock-free maximum: raises `*p_peak` to `value` if it is lower.
+ */
+static void raise_to(std::atomic<long long>* p_peak, long long value)
+{
+    long long peak = p_peak->load(std::memory_order_relaxed);
+    while (value > peak && !p_peak->compare_exchange_weak(peak, value, std::memory_order_relaxed)) {}
+}
+
+/*
+ * HELPER: record_allocation / record_free
+ */
+static void record_allocation(size_t size)
+{
+    if (t_thread_slot < 0)
+    {
+        t_thread_slot = s_thread_slots_used.fetch_add(1, std::memory_order_relaxed);
+        if (t_thread_slot >= ALLOC_MAX_THREAD_SLOTS) t_thread_slot = ALLOC_MAX_THREAD_SLOTS - 1;
+    }
+    phase_counters_t* p_phase = &s_phases[s_phase.load(std::memory_order_relaxed)];
+    p_phase->allocations.fetch_add(1, std::memory_order_relaxed);
+    p_phase->bytes.fetch_add((long long)size, std::memory_order_relaxed);
+    s_threads[t_thread_slot].allocations.fetch_add(1, std::memory_order_relaxed);
+    s_threads[t_thread_slot].bytes.fetch_add((long long)size, std::memory_order_relaxed);
+
+    long long live = s_live_bytes.fetch_add((long long)size, std::memory_order_relaxed) + (long long)size;
+    raise_to(&s_peak_live_bytes, live);
+    raise_to(&p_phase->peak_live_bytes, live);
+}
+
+static void record_free(size_t size)
+{
+    s_phases[s_phase.load(std::memory_order_relaxed)].frees.fetch_add(1, std::memory_order_relaxed);
+    s_live_bytes.fetch_sub((long long)size, std::memory_order_relaxed);
+}
+
+/*
+ * FUNCTION: tracked_malloc
+ */
+void* tracked_malloc(size_t size)
+{
+    if (size > SIZE_MAX - ALLOC_HEADER_BYTES) return NULL;
+    char* p_base = (char*)malloc(size + ALLOC_HEADER_BYTES);
+    if (p_base == NULL) return NULL;
+    *(size_t*)p_base = size;
+    record_allocation(size);
+    return p_base + ALLOC_HEADER_BYTES;
+}
+
+/*
+ * FUNCTION: tracked_calloc
+ */
+void* tracked_calloc(size_t count, size_t size)
+{
+    if (size != 0 && count > (SIZE_MAX - ALLOC_HEADER_BYTES) / size) return NULL;
+    char* p_base = (char*)calloc(1, count * size + ALLOC_HEADER_BYTES);
+    if (p_base == NULL) return NULL;
+    *(size_t*)p_base = count * size;
+    record_allocation(count * size);
+    return p_base + ALLOC_HEADER_BYTES;
+}
+
+/*
+ * FUNCTION: tracked_realloc
+ */
+void* tracked_realloc(void* p_block, size_t size)
+{
+    if (p_block == NULL) return tracked_malloc(size);
+    if (size > SIZE_MAX - ALLOC_HEADER_BYTES) return NULL;
+
+    char* p_base = (char*)p_block - ALLOC_HEADER_BYTES;
+    size_t old_size = *(size_t*)p_base;
+    char* p_new_base = (char*)realloc(p_base, size + ALLOC_HEADER_BYTES);
+    if (p_new_base == NULL) return NULL; // The old block is untouched
+    *(size_t*)p_new_base = size;
+    record_free(old_size);
+    record_allocation(size);
+    return p_new_base + ALLOC_HEADER_BYTES;
+}
+
+/*
+ * FUNCTION: tracked_free
+ */
+void tracked_free(void* p_block)
+{
+    if (p_block == NULL) return;
+    char* p_base = (char*)p_block - ALLOC_HEADER_BYTES;
+    record_free(*(size_t*)p_base);
+    free(p_base);
+}
+
+/*
+ * FUNCTION: set_allocation_phase
+ */
+void set_allocation_phase(int phase)
+{
+    if (phase >= 0 && phase < ALLOC_PHASE_COUNT) s_phase.store(phase, std::memory_order_relaxed);
+}
+
+/*
+ * FUNCTION: get_allocation_count
+ */
+long long get_allocation_count()
+{
+    long long total = 0;
+    for (int p = 0; p < ALLOC_PHASE_COUNT; p++) total += s_phases[p].allocations.load(std::memory_order_relaxed);
+    return total;
+}
+
+/*
+ * FUNCTION: print_allocation_report
+ */
+void print_allocation_report()
+{
+    const double MB = 1024.0 * 1024.0;
+    long long allocations = 0, frees = 0;
+
+    printf("\n--- Allocation Report ---\n");
+    printf("%-10s | %10s | %10s | %10s | %13s\n", "PHASE", "ALLOCS", "FREES", "ALLOC MB", "PEAK LIVE MB");
+    for (int p = 0; p < ALLOC_PHASE_COUNT; p++)
+    {
+        const phase_counters_t* p_phase = &s_phases[p];
+        long long phase_allocations = p_phase->allocations.load(std::memory_order_relaxed);
+        long long phase_frees = p_phase->frees.load(std::memory_order_relaxed);
+        allocations += phase_allocations;
+        frees += phase_frees;
+        if (phase_allocations == 0 && phase_frees == 0) continue;
+        printf("%-10s | %10lld | %10lld | %10.1f | %13.1f\n", PHASE_NAMES[p], phase_allocations, phase_frees,
+            p_phase->bytes.load(std::memory_order_relaxed) / MB, p_phase->peak_live_bytes.load(std::memory_order_relaxed) / MB);
+    }
+
+    int slots = s_thread_slots_used.load(std::memory_order_relaxed);
+    if (slots > ALLOC_MAX_THREAD_SLOTS) slots = ALLOC_MAX_THREAD_SLOTS;
+    // Threads are numbered in the order of their first allocation
+    printf("%-10s | %10s | %10s\n", "THREAD", "ALLOCS", "ALLOC MB");
+    for (int t = 0; t < slots; t++)
+    {
+        printf("%-10d | %10lld | %10.1f\n", t + 1, s_threads[t].allocations.load(std::memory_order_relaxed), s_threads[t].bytes.load(std::memory_order_relaxed) / MB);
+    }
+    if (s_thread_slots_used.load(std::memory_order_relaxed) > ALLOC_MAX_THREAD_SLOTS) printf("(threads past %d share the last row)\n", ALLOC_MAX_THREAD_SLOTS);
+
+    printf("Peak: %.1f MB live. Still live: %.1f MB in %lld blocks.\n",
+        s_peak_live_bytes.load(std::memory_order_relaxed) / MB, s_live_bytes.load(std::memory_order_relaxed) / MB, allocations - frees);
+}
@@ -0,0 +1,99 @@
+/*
+ * FILE: alloc_tracker.h
+ *
+ * WHAT:
+ * Defines the Allocation Tracker: drop-in replacements for malloc, calloc,
+ * realloc and free that count every heap allocation the engine makes, by
+ * run phase and by thread, along with the live and peak bytes.
+ * `print_allocation_report` shows the totals at the end of a run.
+ *
+ * WHY:
+ * The Memory Budget Manager (memory_budget.h) accounts for the big,
+ * long-lived structures it is told about. It cannot see churn: the small
+ * per-turn buffers of the simulation loop that are allocated and freed
+ * thousands of times. Counting at the allocator shows that churn per phase
+ * and lets the verifier prove that the paths meant to be allocation-free
+ * (feedback, filter, warm entropy passes) really are.
+ *
+ * HOW:
+ * Each block carries a 16-byte header holding its size (16 keeps the
+ * malloc alignment). Counters are relaxed atomics; per-thread counters live
+ * in a slot claimed on the thread's first allocation.
+ *
+ * RULES:
+ * Memory from `tracked_*` must be released with `tracked_free`, and memory
+ * from plain malloc (libraries) with plain free. C++ `new` (single_flight,
+ * fixed-size objects) is not tracked.
+ */
+
+#pragma once
+#ifndef ALLOC_TRACKER_H
+#define ALLOC_TRACKER_H
+#include <stddef.h>
+
+/*
+ * CONSTANTS: Allocation Phases
+ *
+ * WHAT:
+ * What the process is doing, set by the mode that runs it (the phase is
+ * process-wide, so only the main thread changes it between parallel parts):
+ * - STARTUP: Loading, dictionaries, caches, initial views.
+ * - SETUP: Per-run preparation (openers, partition tables, thread buffers).
+ * - PLAY: The game loops (tournament games, replay days, interactive turns).
+ * - SHUTDOWN: Reports and cleanup.
+ */
+#define ALLOC_PHASE_STARTUP 0
+#define ALLOC_PHASE_SETUP 1
+#define ALLOC_PHASE_PLAY 2
+#define ALLOC_PHASE_SHUTDOWN 3
+#define ALLOC_PHASE_COUNT 4
+
+/*
+ * CONSTANT: ALLOC_MAX_THREAD_SLOTS
+ *
+ * WHAT:
+ * Threads counted separately; any beyond share the last slot.
+ */
+#define ALLOC_MAX_THREAD_SLOTS 64
+
+/*
+ * FUNCTION: tracked_malloc / tracked_calloc / tracked_realloc / tracked_free
+ *
+ * WHAT:
+ * Same contracts as the C library functions (NULL on failure, realloc of
+ * NULL allocates, free of NULL does nothing). A realloc counts as one
+ * allocation of the new size and one free of the old.
+ */
+void* tracked_malloc(size_t size);
+void* tracked_calloc(size_t count, size_t size);
+void* tracked_realloc(void* p_block, size_t size);
+void tracked_free(void* p_block);
+
+/*
+ * FUNCTION: set_allocation_phase
+ *
+ * WHAT:
+ * Attributes the allocations that follow to `phase` (ALLOC_PHASE_*).
+ */
+void set_allocation_phase(int phase);
+
+/*
+ * FUNCTION: get_allocation_count
+ *
+ * WHAT:
+ * Allocations made so far, by all threads. Two readings around a code path
+ * with nothing else running give the allocations of that path.
+ */
+long long get_allocation_count();
+
+/*
+ * FUNCTION: print_allocation_report
+ *
+ * WHAT:
+ * Per phase: allocations, frees, bytes allocated and the peak live bytes
+ * reached during the phase. Per thread: allocations and bytes. Then the
+ * process peak and what is still live (leaks, if printed after cleanup).
+ */
+void print_allocation_report();
+
+#endif
@@ -0,0 +1,392 @@
+/*
+ * FILE: auto_tuner.cpp
+ *
+ * WHAT:
+ * Implements the Startup Auto-Tuner.
+ *
+ * HOW:
+ * The benchmark is the real hot path: `calculate_entropy_for_candidates`
+ * over a strided sample of the dictionary (up to 1024 guesses) against two
+ * answer sets the size of typical mid-game positions. Every combination of
+ * kernel, tile and thread count is timed (best of a few repeats). The
+ * default wins ties: another combination must be clearly faster to replace
+ * it, so timer noise cannot flip the choice from run to run.
+ *
+ * The thread count is measured on the candidate loop and only ever applied
+ * to it (`num_threads`); the process-wide team size, which also sizes the
+ * game-level parallel regions, is left alone.
+ *
+ * TUNING FILE FORMAT:
+ * `<machine> <size class> <kernel> <tile> <threads> <ms>` per line, where
+ * the machine is "hostname/logical CPUs/placement policy" and the size
+ * class is the word count rounded up to a power of two.
+ */
+
+#include "auto_tuner.h"
+#include "entropy_calculator.h"
+#include "pattern_cache.h"
+#include "alloc_tracker.h"
+#include "thread_placement.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <omp.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+/*
+ * CONSTANTS: Benchmark Shape
+ *
+ * WHAT:
+ * - BENCHMARK_MAX_GUESSES: Guesses scored per pass (bounds the time and the
+ * pattern rows the warm-up fills).
+ * - BENCHMARK_ANSWER_SIZES: Answer-set sizes per pass.
+ * - BENCHMARK_REPEATS: Passes per combination (the fastest counts).
+ * - BENCHMARK_MARGIN: A challenger must beat the default by this factor.
+ */
+#define BENCHMARK_MAX_GUESSES 1024
+#define BENCHMARK_REPEATS 3
+#define BENCHMARK_MARGIN 0.97
+static const int BENCHMARK_ANSWER_SIZES[] = { 32, 256 };
+static const int CANDIDATE_TILES[] = { 0, 16, 64, 256 };
+
+/*
+ * HELPER: kernel_name
+ */
+static const char* kernel_name(int kernel)
+{
+    return (kernel == ENTROPY_KERNEL_ROW_LOOKUP) ? "row-lookup" : "direct";
+}
+
+/*
+ * HELPER: apply_tuning_config
+ *
+ * WHAT:
+ * Installs `config` as the global configuration and sets the schedule of
+ * the candidate loop (`schedule(runtime)`). Its thread count is read by
+ * the loop itself (`get_tuned_thread_count`).
+ */
+static void apply_tuning_config(const tuning_config_t* p_config)
+{
+    g_tuning_config = *p_config;
+    if (p_config->candidate_tile > 0) omp_set_schedule(omp_sched_dynamic, p_config->candidate_tile);
+    else omp_set_schedule(omp_sched_static, 0);
+}
+
+/*
+ * HELPER: make_machine_key
+ *
+ * WHAT:
+ * "hostname/logical CPUs/placement policy", with anything but letters,
+ * digits, '-' and '.' in the host name replaced so the key is a single
+ * token.
+ *
+ * WHY:
+ * A thread count is only meaningful for the team it was measured with;
+ * `--placement=cores`, for one, runs a smaller team on the same machine.
+ */
+static void make_machine_key(char* key, size_t key_size)
+{
+    char host[64] = "unknown";
+#ifdef _WIN32
+    DWORD host_size = sizeof(host);
+    if (!GetComputerNameA(host, &host_size)) strcpy_s(host, sizeof(host), "unknown");
+#else
+    if (gethostname(host, sizeof(host)) != 0) strcpy_s(host, sizeof(host), "unknown");
+    host[sizeof(host) - 1] = '\0';
+#endif
+    for (char* p = host; *p != '\0'; p++)
+    {
+        bool is_plain = (*p >= 'a' && *p <= 'z') || (*p >= 'A' && *p <= 'Z') || (*p >= '0' && *p <= '9') || *p == '-' || *p == '.';
+        if (!is_plain) *p = '_';
+    }
+    sprintf_s(key, key_size, "%s/%d/%s", host, omp_get_num_procs(), placement_policy_name(g_placement_policy));
+}
+
+/*
+ * HELPER: size_class
+ *
+ * WHAT:
+ * The word count rounded up to a power of two, so the daily used-words
+ * filter (a few words fewer each day) does not force a retune.
+ */
+static int size_class(int count)
+{
+    int size = 1;
+    while (size < count) size <<= 1;
+    return size;
+}
+
+/*
+ * HELPER: parse_tuning_line
+ *
+ * WHAT:
+ * Splits one tuning file line. Returns false for comments and bad lines.
+ */
+static bool parse_tuning_line(char* line, char** p_machine, int* p_size, tuning_config_t* p_config)
+{
+    if (line[0] == '#' || line[0] == '\n' || line[0] == '\0') return false;
+
+    char* p_space = strchr(line, ' ');
+    if (p_space == NULL) return false;
+    *p_space = '\0';
+    *p_machine = line;
+
+    char* p = p_space + 1;
+    char* p_end = NULL;
+    long fields[4];
+    for (int i = 0; i < 4; i++)
+    {
+        fields[i] = strtol(p, &p_end, 10);
+        if (p_end == p) return false;
+        p = p_end;
+    }
+    double ms = strtod(p, &p_end);
+    if (p_end == p) return false;
+
+    if (fields[1] != ENTROPY_KERNEL_DIRECT && fields[1] != ENTROPY_KERNEL_ROW_LOOKUP) return false;
+    if (fields[2] < 0 || fields[3] < 0) return false;
+
+    *p_size = (int)fields[0];
+    p_config->entropy_kernel = (int)fields[1];
+    p_config->candidate_tile = (int)fields[2];
+    p_config->thread_count = (int)fields[3];
+    p_config->benchmark_ms = ms;
+    return true;
+}
+
+/*
+ * HELPER: load_tuning_entry
+ *
+ * RETURNS:
+ * - true if the tuning file has an entry for this machine and size class.
+ */
+static bool load_tuning_entry(const char* machine, int size, tuning_config_t* p_config)
+{
+    FILE* fp = NULL;
+    if (fopen_s(&fp, TUNING_FILE_NAME, "r") != 0 || fp == NULL) return false;
+
+    bool found = false;
+    char line[256];
+    while (!found && fgets(line, sizeof(line), fp) != NULL)
+    {
+        char* line_machine = NULL;
+        int line_size = 0;
+        tuning_config_t entry;
+        if (parse_tuning_line(line, &line_machine, &line_size, &entry) && line_size == size && strcmp(line_machine, machine) == 0)
+        {
+            *p_config = entry;
+            found = true;
+        }
+    }
+    fclose(fp);
+    return found;
+}
+
+/*
+ * HELPER: save_tuning_entry
+ *
+ * WHAT:
+ * Rewrites the tuning file with this machine's entry for `size` replaced
+ * (other machines and size classes are kept).
+ */
+static void save_tuning_entry(const char* machine, int size, const tuning_config_t* p_config)
+{
+    // 1. Keep the other entries
+    char* p_kept = NULL;
+    size_t kept_length = 0;
+    FILE* fp = NULL;
+    if (fopen_s(&fp, TUNING_FILE_NAME, "r") == 0 && fp != NULL)
+    {
+        char line[256];
+        while (fgets(line, sizeof(line), fp) != NULL)
+        {
+            char parsed[256];
+            strcpy_s(parsed, sizeof(parsed), line);
+            char* line_machine = NULL;
+            int line_size = 0;
+            tuning_config_t entry;
+            if (!parse_tuning_line(parsed, &line_machine, &line_size, &entry)) continue;
+            if (line_size == size && strcmp(line_machine, machine) == 0) continue;
+
+            size_t length = strlen(line);
+            char* p_grown = (char*)tracked_realloc(p_kept, kept_length + length + 1);
+            if (p_grown == NULL) break;
+            p_kept = p_grown;
+            memcpy(p_kept + kept_length, line, length + 1);
+            kept_length += length;
+        }
+        fclose(fp);
+    }
+
+    // 2. Write them back with the new entry
+    if (fopen_s(&fp, TUNING_FILE_NAME, "w") != 0 || fp == NULL)
+    {
+        printf("Warning: Could not write '%s'. The calibration will run again next time.\n", TUNING_FILE_NAME);
+        tracked_free(p_kept);
+        return;
+    }
+    fprintf(fp, "# machine size_class kernel(0=direct,1=row-lookup) tile threads benchmark_ms\n");
+    if (p_kept != NULL) fputs(p_kept, fp);
+    fprintf(fp, "%s %d %d %d %d %.3f\n", machine, size, p_config->entropy_kernel, p_config->candidate_tile, p_config->thread_count, p_config->benchmark_ms);
+    fclose(fp);
+    tracked_free(p_kept);
+}
+
+/*
+ * HELPER: time_benchmark_pass
+ *
+ * WHAT:
+ * Applies `config` and returns the fastest of BENCHMARK_REPEATS passes over
+ * every answer-set size, in milliseconds.
+ */
+static double time_benchmark_pass(const tuning_config_t* p_config, dictionary_entry_t* p_guesses, int guess_count,
+    dictionary_entry_t** pp_answers, int answer_count)
+{
+    apply_tuning_config(p_config);
+
+    double best = 1e30;
+    for (int repeat = 0; repeat < BENCHMARK_REPEATS; repeat++)
+    {
+        double start = omp_get_wtime();
+        for (size_t s = 0; s < sizeof(BENCHMARK_ANSWER_SIZES) / sizeof(BENCHMARK_ANSWER_SIZES[0]); s++)
+        {
+            int answers = (BENCHMARK_ANSWER_SIZES[s] < answer_count) ? BENCHMARK_ANSWER_SIZES[s] : answer_count;
+            calculate_entropy_for_candidates(p_guesses, guess_count, pp_answers, answers);
+        }
+        double elapsed = (omp_get_wtime() - start) * 1000.0;
+        if (elapsed < best) best = elapsed;
+    }
+    return best;
+}
+
+/*
+ * HELPER: run_calibration
+ *
+ * WHAT:
+ * 1. Sample the guesses (a scratch copy: the pass overwrites entropies) and
+ * the answers, both strided so they span the alphabet.
+ * 2. Warm the pattern rows of the sampled guesses, untimed (a real run
+ * pays that once too).
+ * 3. Time the default, then every other combination against it.
+ *
+ * RETURNS:
+ * - false if the scratch memory could not be allocated.
+ */
+static bool run_calibration(const dictionary_entry_t* p_dictionary, int count, tuning_config_t* p_best)
+{
+    const int max_answers = BENCHMARK_ANSWER_SIZES[sizeof(BENCHMARK_ANSWER_SIZES) / sizeof(BENCHMARK_ANSWER_SIZES[0]) - 1];
+    int guess_count = (count < BENCHMARK_MAX_GUESSES) ? count : BENCHMARK_MAX_GUESSES;
+    int answer_count = (count < max_answers) ? count : max_answers;
+    if (guess_count <= 0) return false;
+
+    // 1. Samples
+    dictionary_entry_t* p_guesses = (dictionary_entry_t*)tracked_malloc(sizeof(dictionary_entry_t) * guess_count);
+    dictionary_entry_t** pp_answers = (dictionary_entry_t**)tracked_malloc(sizeof(dictionary_entry_t*) * answer_count);
+    if (!p_guesses || !pp_answers) { tracked_free(p_guesses); tracked_free(pp_answers); return false; }
+
+    for (int i = 0; i < guess_count; i++) p_guesses[i] = p_dictionary[(long long)i * count / guess_count];
+    for (int i = 0; i < answer_count; i++) pp_answers[i] = (dictionary_entry_t*)&p_dictionary[(long long)i * count / answer_count];
+
+    // 2. Warm-up
+    int kernel_count = (g_p_pattern_cache != NULL) ? 2 : 1;
+    tuning_config_t config = { (kernel_count == 2) ? ENTROPY_KERNEL_ROW_LOOKUP : ENTROPY_KERNEL_DIRECT, 0, 0, 0.0, "calibrated" };
+    apply_tuning_config(&config);
+    calculate_entropy_for_candidates(p_guesses, guess_count, pp_answers, answer_count);
+
+    // 3. Default first, then the challengers
+    int default_threads = omp_get_max_threads();
+    int thread_options[3] = { default_threads, default_threads / 2, 1 };
+    *p_best = config;
+    p_best->benchmark_ms = time_benchmark_pass(&config, p_guesses, guess_count, pp_answers, answer_count);
+
+    for (int k = 0; k < kernel_count; k++)
+    {
+        for (size_t t = 0; t < sizeof(CANDIDATE_TILES) / sizeof(CANDIDATE_TILES[0]); t++)
+        {
+            for (int n = 0; n < 3; n++)
+            {
+                int threads = thread_options[n];
+                if (threads < 1 || (n > 0 && threads == thread_options[n - 1])) continue;
+
+                config.entropy_kernel = (k == 0) ? ENTROPY_KERNEL_DIRECT : ENTROPY_KERNEL_ROW_LOOKUP;
+                config.candidate_tile = CANDIDATE_TILES[t];
+                config.thread_count = (threads == default_threads) ? 0 : threads;
+
+                double ms = time_benchmark_pass(&config, p_guesses, guess_count, pp_answers, answer_count);
+                if (ms < p_best->benchmark_ms * BENCHMARK_MARGIN)
+                {
+                    *p_best = config;
+                    p_best->benchmark_ms = ms;
+                }
+            }
+        }
+    }
+
+    tracked_free(p_guesses);
+    tracked_free(pp_answers);
+    return true;
+}
+
+/*
+ * FUNCTION: select_tuning_config
+ */
+void select_tuning_config(const dictionary_entry_t* p_dictionary, int count, bool allow_calibration, bool force_calibration)
+{
+    char machine[96];
+    make_machine_key(machine, sizeof(machine));
+    int size = size_class(count);
+
+    tuning_config_t config = { (g_p_pattern_cache != NULL) ? ENTROPY_KERNEL_ROW_LOOKUP : ENTROPY_KERNEL_DIRECT, 0, 0, 0.0, "defaults" };
+
+    // 1. Known machine
+    if (!force_calibration && load_tuning_entry(machine, size, &config))
+    {
+        config.source = "tuning file";
+    }
+    // 2. Measure
+    else if (allow_calibration || force_calibration)
+    {
+        printf("Calibrating entropy kernels for %s (%d words)...", machine, count);
+        fflush(stdout);
+        tuning_config_t best;
+        if (run_calibration(p_dictionary, count, &best))
+        {
+            config = best;
+            config.source = "calibrated";
+            save_tuning_entry(machine, size, &config);
+            printf(" Done (%.1f ms per pass).\n", config.benchmark_ms);
+        }
+        else
+        {
+            printf(" Failed. Using defaults.\n");
+        }
+    }
+
+    apply_tuning_config(&config);
+}
+
+/*
+ * FUNCTION: format_tuning_config
+ */
+void format_tuning_config(char* buffer, size_t buffer_size)
+{
+    char tile[16];
+    if (g_tuning_config.candidate_tile > 0) sprintf_s(tile, sizeof(tile), "%d", g_tuning_config.candidate_tile);
+    else strcpy_s(tile, sizeof(tile), "static");
+
+    int threads = get_tuned_thread_count();
+    sprintf_s(buffer, buffer_size, "%s kernel, tile %s, %d threads (%s)", kernel_name(g_tuning_config.entropy_kernel), tile, threads,
+        (g_tuning_config.source != NULL) ? g_tuning_config.source : "defaults");
+}
+
+/*
+ * FUNCTION: get_tuned_thread_count
+ */
+int get_tuned_thread_count()
+{
+    return (g_tuning_config.thread_count > 0) ? g_tuning_config.thread_count : omp_get_max_threads();
+}
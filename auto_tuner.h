@@ -0,0 +1,105 @@
+/*
+ * FILE: auto_tuner.h
+ *
+ * WHAT:
+ * Defines the interface for the Startup Auto-Tuner. It picks three knobs of
+ * the entropy engine for this machine and this vocabulary size:
+ * - Kernel: compute each feedback pattern directly, or tally it from the
+ * guess's pattern-cache row (see pattern_cache.h).
+ * - Tile: how many candidates an OpenMP thread claims at a time in the
+ * candidate loop (0 = one static block per thread).
+ * - Threads: the OpenMP team size for every parallel region.
+ * The choice is measured once with a short micro-benchmark on the loaded
+ * dictionary and kept per machine in a tuning file, so later runs start with
+ * it for free. `--tune` forces a fresh calibration.
+ *
+ * WHY:
+ * The best combination depends on cache sizes, core count and SMT, and on
+ * how many words there are. A fixed default that suits a desktop wastes
+ * time on a laptop or a 64-core server, and guessing is no substitute for
+ * a measurement.
+ */
+
+#pragma once
+#ifndef AUTO_TUNER_H
+#define AUTO_TUNER_H
+#include "wordle_types.h"
+
+/*
+ * CONSTANTS: Entropy Kernels
+ */
+#define ENTROPY_KERNEL_DIRECT 0
+#define ENTROPY_KERNEL_ROW_LOOKUP 1
+
+/*
+ * CONSTANT: TUNING_FILE_NAME
+ *
+ * WHAT:
+ * One line per machine and vocabulary size class, in the working directory.
+ */
+#define TUNING_FILE_NAME "WordleChampion.tuning"
+
+/*
+ * STRUCT: tuning_config_t
+ *
+ * FIELDS:
+ * - entropy_kernel: ENTROPY_KERNEL_*.
+ * - candidate_tile: Candidates per work unit (0 = static split).
+ * - thread_count: Threads of the candidate loop (0 = the OpenMP default).
+ * - benchmark_ms: Best time of the benchmark pass (0 if never measured).
+ * - source: Where the values came from ("defaults", "tuning file", "calibrated").
+ */
+typedef struct _tuning_config
+{
+    int entropy_kernel;
+    int candidate_tile;
+    int thread_count;
+    double benchmark_ms;
+    const char* source;
+} tuning_config_t;
+
+/*
+ * GLOBAL: g_tuning_config
+ *
+ * WHAT:
+ * The configuration in effect. Read by the entropy engine on every call.
+ */
+extern tuning_config_t g_tuning_config;
+
+/*
+ * FUNCTION: select_tuning_config
+ *
+ * WHAT:
+ * Fills `g_tuning_config` and applies it:
+ * 1. Unless `force_calibration`, use the tuning file's entry for this
+ * machine and vocabulary size, if there is one.
+ * 2. Otherwise, if `allow_calibration`, benchmark the variants on the
+ * dictionary and save the winner to the tuning file.
+ * 3. Otherwise keep the defaults.
+ *
+ * NOTE:
+ * Call after the pattern cache is set up; without one the row-lookup kernel
+ * is not a candidate.
+ */
+void select_tuning_config(const dictionary_entry_t* p_dictionary, int count, bool allow_calibration, bool force_calibration);
+
+/*
+ * FUNCTION: format_tuning_config
+ *
+ * WHAT:
+ * One-line description for the run headers, e.g.
+ * "row-lookup kernel, tile 64, 8 threads (tuning file)".
+ */
+void format_tuning_config(char* buffer, size_t buffer_size);
+
+/*
+ * FUNCTION: get_tuned_thread_count
+ *
+ * WHAT:
+ * Team size for the candidate loop (`num_threads`): the tuned count, or the
+ * current OpenMP default when the tuner kept it. Nothing else uses it, so
+ * the game-level parallel regions keep the default team.
+ */
+int get_tuned_thread_count();
+
+#endif
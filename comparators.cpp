@@ -19,6 +19,7 @@
  */
 
 #include "comparators.h"
+#include "alloc_tracker.h"
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
@@ -40,16 +41,19 @@
   * Plurals are weak guesses in Wordle (often end in S, which is common but
   * structurally boring). Pronouns and Singular nouns are stronger answers.
   */
-static int noun_type_diff(const dictionary_entry_t* entry1, const dictionary_entry_t* entry2)
+static int noun_type_position(char noun_type)
 {
     static const char order[] = { 'R', 'S', 'N', 'P' };
-    int posA = 4; int posB = 4;
     for (int i = 0; i < 4; ++i)
     {
-        if (entry1->noun_type == order[i]) posA = i;
-        if (entry2->noun_type == order[i]) posB = i;
+        if (noun_type == order[i]) return i;
     }
-    return posA - posB;
+    return 4;
+}
+
+static int noun_type_diff(const dictionary_entry_t* entry1, const dictionary_entry_t* entry2)
+{
+    return noun_type_position(entry1->noun_type) - noun_type_position(entry2->noun_type);
 }
 
 /*
@@ -62,29 +66,32 @@ static int noun_type_diff(const dictionary_entry_t* entry1, const dictionary_ent
  * WHY:
  * Past tense (ED) and 3rd Person (S) are weak guesses. Base forms are better.
  */
-static int verb_type_diff(const dictionary_entry_t* entry1, const dictionary_entry_t* entry2)
+static int verb_type_position(char verb_type)
 {
     static const char order[] = { 'N', 'P', 'S', 'T' };
-    int posA = 4; int posB = 4;
     for (int i = 0; i < 4; ++i)
     {
-        if (entry1->verb_type == order[i]) posA = i;
-        if (entry2->verb_type == order[i]) posB = i;
+        if (verb_type == order[i]) return i;
     }
-    return posA - posB;
+    return 4;
+}
+
+static int verb_type_diff(const dictionary_entry_t* entry1, const dictionary_entry_t* entry2)
+{
+    return verb_type_position(entry1->verb_type) - verb_type_position(entry2->verb_type);
 }
 
 /*
  * HELPER: entropy_diff
  *
  * WHAT:
- * Compares floating point Entropy.
+ * Compares the fixed-point entropy scores (equal splits score exactly equal).
  * Note: Returns 1 if E1 < E2 because we want DESCENDING order (High to Low).
  */
 static int entropy_diff(const dictionary_entry_t* entry1, const dictionary_entry_t* entry2)
 {
-    if (entry1->entropy < entry2->entropy) return 1;
-    else if (entry1->entropy > entry2->entropy) return -1;
+    if (entry1->entropy_score < entry2->entropy_score) return 1;
+    else if (entry1->entropy_score > entry2->entropy_score) return -1;
     else return 0;
 }
 
@@ -295,4 +302,153 @@ int compare_dictionary_entries_by_entropy_no_filter_desc(const void* p1, const v
 
     // 3. Tie-Breakers
     return compare_with_entropy_tie_breaker(entry1, entry2);
-}
\ No newline at end of file
+}
+
+/*
+ * FUNCTION: compare_dictionary_entries_by_mismatches_asc
+ *
+ * WHAT:
+ * Sorts pointers to dictionary entries.
+ * Primary Key: Game State (Valid > Invalid).
+ * Secondary Key: Feedback Mismatches (Fewest first = most likely).
+ * Tertiary Key: Rank Tie-Breaker Chain.
+ *
+ * WHY:
+ * Used by the noise-tolerant filter to list the most likely answers when the
+ * entered feedback contains a mistake. Among equally likely words, common
+ * words are shown first.
+ */
+int compare_dictionary_entries_by_mismatches_asc(const void* p1, const void* p2)
+{
+    const dictionary_entry_t* entry1 = *(const dictionary_entry_t**)p1;
+    const dictionary_entry_t* entry2 = *(const dictionary_entry_t**)p2;
+
+    int result = eliminated_diff(entry1, entry2);
+    if (result != 0) return result;
+
+    if (entry1->feedback_mismatches < entry2->feedback_mismatches) return -1;
+    if (entry1->feedback_mismatches > entry2->feedback_mismatches) return 1;
+
+    result = rank_diff(entry1, entry2);
+    if (result != 0) return result;
+
+    return compare_with_rank_tie_breaker(entry1, entry2);
+}
+
+// --- RADIX SORT OF THE ENTROPY VIEWS ---
+
+/*
+ * STRUCT: entropy_sort_key_t
+ *
+ * WHAT:
+ * One view entry and its place in an entropy order as a 128-bit unsigned
+ * key, so that key order is comparator order:
+ * - high: The eliminated flag and the inverted score (which comes first
+ * depends on the view).
+ * - low: The tie-breaker chain: duplicate flag (1 bit), noun position (3),
+ * verb position (3), inverted rank (32), letters (5 each).
+ */
+typedef struct _entropy_sort_key
+{
+    unsigned long long high;
+    unsigned long long low;
+    dictionary_entry_t* pEntry;
+} entropy_sort_key_t;
+
+/*
+ * CONSTANT: ENTROPY_KEY_SCORE_BITS
+ *
+ * WHAT:
+ * Bits of the score in the key. Scores stay below 2^36 (16 bits of entropy); larger ones (none
+ * are produced) would all sort as equal here.
+ */
+#define ENTROPY_KEY_SCORE_BITS 40
+
+/*
+ * HELPER: make_entropy_sort_key
+ *
+ * RETURNS:
+ * - false if the word has a character outside 'A'-'Z' (the 5-bit letter
+ * codes could not reproduce `strncmp`).
+ */
+static bool make_entropy_sort_key(dictionary_entry_t* pEntry, bool is_valid_first, entropy_sort_key_t* pKey)
+{
+    const unsigned long long SCORE_MASK = (1ULL << ENTROPY_KEY_SCORE_BITS) - 1;
+    unsigned long long score = (pEntry->entropy_score < 0) ? 0 : (unsigned long long)pEntry->entropy_score;
+    if (score > SCORE_MASK) score = SCORE_MASK;
+    unsigned long long eliminated = pEntry->is_eliminated ? 1 : 0;
+
+    if (is_valid_first) pKey->high = (eliminated << ENTROPY_KEY_SCORE_BITS) | (SCORE_MASK - score);
+    else pKey->high = ((SCORE_MASK - score) << 1) | eliminated;
+
+    // Higher ranks first: flip the sign bit for unsigned order, then invert
+    unsigned int rank_key = ~((unsigned int)pEntry->frequency_rank ^ 0x80000000u);
+    unsigned long long low = pEntry->contains_duplicate_letters ? 1 : 0;
+    low = (low << 3) | (unsigned long long)noun_type_position(pEntry->noun_type);
+    low = (low << 3) | (unsigned long long)verb_type_position(pEntry->verb_type);
+    low = (low << 32) | rank_key;
+    for (int i = 0; i < WORDLE_WORD_LENGTH; i++)
+    {
+        char letter = pEntry->word[i];
+        if (letter < 'A' || letter > 'Z') return false;
+        low = (low << 5) | (unsigned long long)(letter - 'A');
+    }
+    pKey->low = low;
+    pKey->pEntry = pEntry;
+    return true;
+}
+
+/*
+ * FUNCTION: radix_sort_entropy_view
+ *
+ * WHAT:
+ * 1. Build the keys (bail out on a word the key cannot encode).
+ * 2. LSD radix sort, 8 bits per pass: the 8 bytes of `low`, then of `high`.
+ * A pass whose byte is the same for every key is skipped (the scores of
+ * one view share their top bytes, and most tie-breaker bytes are constant).
+ * 3. Write the pointers back in key order.
+ */
+bool radix_sort_entropy_view(dictionary_entry_t** pp_view, int count, bool is_valid_first)
+{
+    if (count <= 1) return true;
+
+    entropy_sort_key_t* p_keys = (entropy_sort_key_t*)tracked_malloc(sizeof(entropy_sort_key_t) * count);
+    entropy_sort_key_t* p_scratch = (entropy_sort_key_t*)tracked_malloc(sizeof(entropy_sort_key_t) * count);
+    if (p_keys == NULL || p_scratch == NULL) { tracked_free(p_keys); tracked_free(p_scratch); return false; }
+
+    // 1. Keys
+    for (int i = 0; i < count; i++)
+    {
+        if (!make_entropy_sort_key(pp_view[i], is_valid_first, &p_keys[i])) { tracked_free(p_keys); tracked_free(p_scratch); return false; }
+    }
+
+    // 2. Passes (counting sort per byte is stable, so earlier passes break later ties)
+    for (int pass = 0; pass < 16; pass++)
+    {
+        int shift = (pass % 8) * 8;
+        bool is_high = (pass >= 8);
+        int counts[256] = { 0 };
+        for (int i = 0; i < count; i++)
+        {
+            unsigned long long key = is_high ? p_keys[i].high : p_keys[i].low;
+            counts[(key >> shift) & 0xFF]++;
+        }
+        unsigned long long first = is_high ? p_keys[0].high : p_keys[0].low;
+        if (counts[(first >> shift) & 0xFF] == count) continue;
+
+        int offset = 0;
+        for (int b = 0; b < 256; b++) { int c = counts[b]; counts[b] = offset; offset += c; }
+        for (int i = 0; i < count; i++)
+        {
+            unsigned long long key = is_high ? p_keys[i].high : p_keys[i].low;
+            p_scratch[counts[(key >> shift) & 0xFF]++] = p_keys[i];
+        }
+        entropy_sort_key_t* p_swap = p_keys; p_keys = p_scratch; p_scratch = p_swap;
+    }
+
+    // 3. Write back
+    for (int i = 0; i < count; i++) pp_view[i] = p_keys[i].pEntry;
+    tracked_free(p_keys);
+    tracked_free(p_scratch);
+    return true;
+}
@@ -79,4 +79,40 @@ int compare_master_entries_eliminated_then_alpha(const void* p1, const void* p2)
  */
 int compare_dictionary_entries_by_entropy_no_filter_desc(const void* p1, const void* p2);
 
-#endif
\ No newline at end of file
+/*
+ * FUNCTION: compare_dictionary_entries_by_mismatches_asc
+ *
+ * WHAT:
+ * Sorts a list of pointers to dictionary entries based on:
+ * 1. Game State: Non-eliminated words come first.
+ * 2. Feedback Mismatches: Fewest disagreements with the entered feedback first.
+ * 3. Tie-Breakers: Rank, then the Rank tie-breaker chain.
+ *
+ * WHY:
+ * Used by the noise-tolerant filter to show the most likely answers first
+ * when the entered feedback cannot be fully trusted.
+ */
+int compare_dictionary_entries_by_mismatches_asc(const void* p1, const void* p2);
+
+/*
+ * FUNCTION: radix_sort_entropy_view
+ *
+ * WHAT:
+ * Sorts a view into exactly the order of
+ * `compare_dictionary_entries_by_entropy_desc` (`is_valid_first`) or
+ * `compare_dictionary_entries_by_entropy_no_filter_desc`, by LSD radix sort
+ * on a key packed from the entropy score and the tie-breaker chain.
+ *
+ * RETURNS:
+ * - false if out of memory or a word falls outside 'A'-'Z'; the view is then
+ * untouched and the caller sorts it with the comparator.
+ *
+ * WHY:
+ * Entropy scores are integers (see entropy_calculator.h), so the whole
+ * comparator chain fits in a fixed-width key. Sorting the ~15,000-word views
+ * after every guess then costs a few linear passes instead of N log N
+ * comparator callbacks.
+ */
+bool radix_sort_entropy_view(dictionary_entry_t** pp_view, int count, bool is_valid_first);
+
+#endif
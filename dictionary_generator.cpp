@@ -0,0 +1,246 @@
+/*
+ * FILE: dictionary_generator.cpp
+ *
+ * WHAT:
+ * Implements the Synthetic Dictionary Generator.
+ *
+ * HOW:
+ * 1. Draw words letter by letter from the model's weights (SplitMix64
+ * stream from the seed) and mark each new one in a bitmap over all 26^5
+ * possible words (1.5 MB), which rejects duplicates in O(1).
+ * 2. Walk the bitmap in order: the bit index is the word in base 26, so
+ * this yields the words alphabetically. Each word gets its rank and tags
+ * from the same stream and goes through `parse_dictionary_line`, so the
+ * entries are exactly what the file loader would build.
+ */
+
+#include "dictionary_generator.h"
+#include "load_dictionary.h"
+#include "alloc_tracker.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * CONSTANT: ENGLISH_LETTER_WEIGHTS
+ *
+ * WHAT:
+ * Relative letter frequencies of English text (percent), A to Z.
+ */
+static const double ENGLISH_LETTER_WEIGHTS[26] = {
+    8.2, 1.5, 2.8, 4.3, 12.7, 2.2, 2.0, 6.1, 7.0, 0.15, 0.77, 4.0, 2.4,
+    6.7, 7.5, 1.9, 0.095, 6.0, 6.3, 9.1, 2.8, 0.98, 2.4, 0.15, 2.0, 0.074
+};
+
+/*
+ * CONSTANTS: Tag Proportions
+ *
+ * WHAT:
+ * Cumulative shares of each noun and verb tag, and the share of the obscure
+ * rank "005", as measured on the real `AllWords.txt`.
+ */
+static const char NOUN_TAGS[] = { 'S', 'N', 'P', 'R' };
+static const double NOUN_TAG_CUMULATIVE[] = { 0.486, 0.765, 0.9995, 1.0 };
+static const char VERB_TAGS[] = { 'N', 'P', 'S', 'T' };
+static const double VERB_TAG_CUMULATIVE[] = { 0.660, 0.824, 0.941, 1.0 };
+static const double OBSCURE_RANK_SHARE = 0.24;
+
+/*
+ * HELPER: next_random
+ *
+ * WHAT:
+ * SplitMix64 step (same mixer as the Zobrist keys).
+ */
+static unsigned long long next_random(unsigned long long* p_state)
+{
+    unsigned long long x = (*p_state += 0x9E3779B97F4A7C15ULL);
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+/*
+ * HELPER: next_unit
+ *
+ * WHAT:
+ * Uniform double in [0, 1).
+ */
+static double next_unit(unsigned long long* p_state)
+{
+    return (double)(next_random(p_state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/*
+ * HELPER: pick_cumulative
+ */
+static int pick_cumulative(const double* p_cumulative, int count, double u)
+{
+    for (int i = 0; i < count - 1; i++)
+    {
+        if (u < p_cumulative[i]) return i;
+    }
+    return count - 1;
+}
+
+/*
+ * FUNCTION: parse_letter_model
+ */
+int parse_letter_model(const char* name)
+{
+    if (strcmp(name, "english") == 0) return SYNTHETIC_LETTERS_ENGLISH;
+    if (strcmp(name, "uniform") == 0) return SYNTHETIC_LETTERS_UNIFORM;
+    if (strcmp(name, "skewed") == 0) return SYNTHETIC_LETTERS_SKEWED;
+    return -1;
+}
+
+/*
+ * FUNCTION: letter_model_name
+ */
+const char* letter_model_name(int letter_model)
+{
+    if (letter_model == SYNTHETIC_LETTERS_UNIFORM) return "uniform";
+    if (letter_model == SYNTHETIC_LETTERS_SKEWED) return "skewed";
+    return "english";
+}
+
+/*
+ * FUNCTION: parse_synthetic_spec
+ */
+bool parse_synthetic_spec(const char* text, synthetic_dictionary_spec_t* p_spec)
+{
+    p_spec->word_count = 0;
+    p_spec->seed = 1;
+    p_spec->letter_model = SYNTHETIC_LETTERS_ENGLISH;
+
+    char* p_end = NULL;
+    long count = strtol(text, &p_end, 10);
+    if (p_end == text || count <= 0 || count > 0x7FFFFFFF) return false;
+    p_spec->word_count = (int)count;
+    if (*p_end == '\0') return true;
+    if (*p_end != ',') return false;
+
+    const char* p_seed = p_end + 1;
+    p_spec->seed = strtoull(p_seed, &p_end, 10);
+    if (p_end == p_seed) return false;
+    if (*p_end == '\0') return true;
+    if (*p_end != ',') return false;
+
+    p_spec->letter_model = parse_letter_model(p_end + 1);
+    return p_spec->letter_model >= 0;
+}
+
+/*
+ * FUNCTION: generate_synthetic_dictionary
+ *
+ * WHAT:
+ * 1. Build the cumulative letter distribution for the model.
+ * 2. Draw distinct words into the bitmap (bounded attempts, so a model that
+ * cannot reach the count fails instead of spinning).
+ * 3. Emit the marked words in alphabetical order with ranks and tags.
+ */
+bool generate_synthetic_dictionary(const synthetic_dictionary_spec_t* p_spec, dictionary_entry_t** pp_dictionary, int* p_count)
+{
+    *pp_dictionary = NULL;
+    *p_count = 0;
+
+    long long universe = 1;
+    for (int i = 0; i < WORDLE_WORD_LENGTH; i++) universe *= 26;
+    if (p_spec->word_count <= 0 || p_spec->word_count > universe / 2)
+    {
+        printf("Synthetic dictionary size must be between 1 and %lld.\n", universe / 2);
+        return false;
+    }
+
+    // 1. Letter distribution
+    double cumulative[26];
+    double total = 0.0;
+    for (int c = 0; c < 26; c++)
+    {
+        double weight = ENGLISH_LETTER_WEIGHTS[c];
+        if (p_spec->letter_model == SYNTHETIC_LETTERS_UNIFORM) weight = 1.0;
+        else if (p_spec->letter_model == SYNTHETIC_LETTERS_SKEWED) weight = weight * weight;
+        total += weight;
+        cumulative[c] = total;
+    }
+    for (int c = 0; c < 26; c++) cumulative[c] /= total;
+
+    unsigned char* p_bitmap = (unsigned char*)tracked_calloc((size_t)(universe + 7) / 8, 1);
+    dictionary_entry_t* p_dictionary = (dictionary_entry_t*)tracked_malloc(sizeof(dictionary_entry_t) * p_spec->word_count);
+    if (!p_bitmap || !p_dictionary)
+    {
+        printf("Out of memory generating the synthetic dictionary.\n");
+        tracked_free(p_bitmap); tracked_free(p_dictionary);
+        return false;
+    }
+
+    // 2. Distinct words
+    unsigned long long state = p_spec->seed;
+    int distinct = 0;
+    long long attempts_left = (long long)p_spec->word_count * 200 + 10000;
+    while (distinct < p_spec->word_count && attempts_left-- > 0)
+    {
+        long long index = 0;
+        for (int i = 0; i < WORDLE_WORD_LENGTH; i++)
+        {
+            index = index * 26 + pick_cumulative(cumulative, 26, next_unit(&state));
+        }
+        unsigned char bit = (unsigned char)(1u << (index & 7));
+        if (p_bitmap[index >> 3] & bit) continue;
+        p_bitmap[index >> 3] |= bit;
+        distinct++;
+    }
+    if (distinct < p_spec->word_count)
+    {
+        printf("The '%s' letter model only produced %d distinct words of the %d requested.\n",
+            letter_model_name(p_spec->letter_model), distinct, p_spec->word_count);
+        tracked_free(p_bitmap); tracked_free(p_dictionary);
+        return false;
+    }
+
+    // 3. Alphabetical emit
+    int count = 0;
+    for (long long index = 0; index < universe && count < distinct; index++)
+    {
+        if ((p_bitmap[index >> 3] & (1u << (index & 7))) == 0) continue;
+
+        char line[16];
+        long long rest = index;
+        for (int i = WORDLE_WORD_LENGTH - 1; i >= 0; i--)
+        {
+            line[i] = (char)('A' + rest % 26);
+            rest /= 26;
+        }
+
+        int rank = (next_unit(&state) < OBSCURE_RANK_SHARE) ? 5 : 5 * (int)(next_unit(&state) * 21.0);
+        char noun = NOUN_TAGS[pick_cumulative(NOUN_TAG_CUMULATIVE, 4, next_unit(&state))];
+        char verb = VERB_TAGS[pick_cumulative(VERB_TAG_CUMULATIVE, 4, next_unit(&state))];
+        sprintf_s(line + WORDLE_WORD_LENGTH, sizeof(line) - WORDLE_WORD_LENGTH, "%03d%c%c", rank, noun, verb);
+
+        if (parse_dictionary_line(line, &p_dictionary[count])) count++;
+    }
+
+    tracked_free(p_bitmap);
+    *pp_dictionary = p_dictionary;
+    *p_count = count;
+    return true;
+}
+
+/*
+ * FUNCTION: write_dictionary_file
+ */
+bool write_dictionary_file(const char* path, const dictionary_entry_t* p_dictionary, int count)
+{
+    FILE* fp = NULL;
+    if (fopen_s(&fp, path, "w") != 0 || fp == NULL)
+    {
+        printf("Could not create '%s'.\n", path);
+        return false;
+    }
+    for (int i = 0; i < count; i++)
+    {
+        const dictionary_entry_t* pEntry = &p_dictionary[i];
+        fprintf(fp, "%s%03d%c%c\n", pEntry->word, pEntry->frequency_rank, pEntry->noun_type, pEntry->verb_type);
+    }
+    fclose(fp);
+    return true;
+}
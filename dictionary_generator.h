@@ -0,0 +1,99 @@
+/*
+ * FILE: dictionary_generator.h
+ *
+ * WHAT:
+ * Defines the interface for the Synthetic Dictionary Generator. It produces
+ * dictionaries in the `AllWords.txt` format (word, frequency rank, noun and
+ * verb tags) of any size, from a seed and a letter model:
+ * - english: Letters drawn with English letter frequencies.
+ * - uniform: Every letter equally likely (the hardest case for filtering).
+ * - skewed: English frequencies squared, so a few letters dominate (large
+ * pattern buckets, the hardest case for entropy splits).
+ * Ranks and tags follow the proportions of the real `AllWords.txt`.
+ *
+ * WHY:
+ * The real dictionary has about 6,500 words, so it cannot show how entropy,
+ * filtering and tournaments scale to 20k, 50k or 100k vocabularies or to
+ * unusual letter statistics. The same seed always gives the same file, so a
+ * scale run can be repeated exactly.
+ *
+ * NOTE:
+ * Words are WORDLE_WORD_LENGTH letters, like every other part of the engine.
+ */
+
+#pragma once
+#ifndef DICTIONARY_GENERATOR_H
+#define DICTIONARY_GENERATOR_H
+#include "wordle_types.h"
+
+/*
+ * CONSTANTS: Letter Models
+ */
+#define SYNTHETIC_LETTERS_ENGLISH 0
+#define SYNTHETIC_LETTERS_UNIFORM 1
+#define SYNTHETIC_LETTERS_SKEWED 2
+
+/*
+ * STRUCT: synthetic_dictionary_spec_t
+ *
+ * FIELDS:
+ * - word_count: Distinct words to generate.
+ * - seed: Any value; equal seeds give equal dictionaries.
+ * - letter_model: SYNTHETIC_LETTERS_*.
+ */
+typedef struct _synthetic_dictionary_spec
+{
+    int word_count;
+    unsigned long long seed;
+    int letter_model;
+} synthetic_dictionary_spec_t;
+
+/*
+ * FUNCTION: parse_letter_model
+ *
+ * WHAT:
+ * "english", "uniform" or "skewed" to SYNTHETIC_LETTERS_*.
+ *
+ * RETURNS:
+ * - The model, or -1 for an unknown name.
+ */
+int parse_letter_model(const char* name);
+
+/*
+ * FUNCTION: letter_model_name
+ */
+const char* letter_model_name(int letter_model);
+
+/*
+ * FUNCTION: parse_synthetic_spec
+ *
+ * WHAT:
+ * Parses "N[,seed[,model]]" (seed defaults to 1, model to english).
+ *
+ * RETURNS:
+ * - false if N is not positive or the seed or model is malformed.
+ */
+bool parse_synthetic_spec(const char* text, synthetic_dictionary_spec_t* p_spec);
+
+/*
+ * FUNCTION: generate_synthetic_dictionary
+ *
+ * WHAT:
+ * Allocates and fills a dictionary (sorted alphabetically, like the real
+ * file) exactly as `read_dictionary_file` would have parsed it.
+ *
+ * RETURNS:
+ * - false if memory runs out or the model cannot produce that many distinct
+ * words (a message is printed).
+ */
+bool generate_synthetic_dictionary(const synthetic_dictionary_spec_t* p_spec, dictionary_entry_t** pp_dictionary, int* p_count);
+
+/*
+ * FUNCTION: write_dictionary_file
+ *
+ * WHAT:
+ * Writes entries in the fixed-width `AllWords.txt` layout, one per line.
+ */
+bool write_dictionary_file(const char* path, const dictionary_entry_t* p_dictionary, int count);
+
+#endif
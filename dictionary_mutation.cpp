@@ -0,0 +1,244 @@
+/*
+ * FILE: dictionary_mutation.cpp
+ *
+ * WHAT:
+ * Implements runtime add/remove operations on a dictionary, keeping the
+ * opener entropy, the pattern histograms and the generation counter current.
+ *
+ * HOW:
+ * The heavy lifting is done by the partition table. Every guess row holds a
+ * histogram of its patterns against every answer, so one changed word only
+ * moves one count per row (O(N)), instead of re-running the O(N^2) entropy pass.
+ *
+ * WHY:
+ * The historical replay retires one answer per day, the startup pipeline
+ * applies "Used Words" after the precompute has already started, and a
+ * long-running server should pick up new words without reloading from disk.
+ */
+
+#include "dictionary_mutation.h"
+#include "load_dictionary.h"
+#include "alloc_tracker.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * FUNCTION: init_mutable_dictionary
+ *
+ * WHAT:
+ * Copies the source entries, builds the partition table and applies the
+ * resulting opener entropy to every entry.
+ */
+bool init_mutable_dictionary(mutable_dictionary_t* p_md, const dictionary_entry_t* p_source, int count)
+{
+    p_md->p_entries = NULL;
+    p_md->count = 0;
+    p_md->capacity = 0;
+    p_md->generation = 0;
+    if (count <= 0) return false;
+
+    p_md->p_entries = (dictionary_entry_t*)tracked_malloc(sizeof(dictionary_entry_t) * count);
+    if (p_md->p_entries == NULL) return false;
+    memcpy(p_md->p_entries, p_source, sizeof(dictionary_entry_t) * count);
+
+    if (!build_partition_table(&p_md->table, p_md->p_entries, count))
+    {
+        tracked_free(p_md->p_entries);
+        p_md->p_entries = NULL;
+        return false;
+    }
+
+    p_md->count = count;
+    p_md->capacity = count;
+    partition_table_apply_entropy(&p_md->table, p_md->p_entries);
+    return true;
+}
+
+/*
+ * FUNCTION: find_dictionary_word
+ *
+ * WHAT:
+ * Standard binary search over the (alphabetical) entry array.
+ *
+ * WHY:
+ * `AllWords.txt` is stored in alphabetical order and the mutation API
+ * preserves it, so lookups stay O(log N).
+ */
+int find_dictionary_word(const dictionary_entry_t* p_entries, int count, const char* word)
+{
+    int lo = 0;
+    int hi = count - 1;
+    while (lo <= hi)
+    {
+        int mid = lo + (hi - lo) / 2;
+        int cmp = strncmp(p_entries[mid].word, word, WORDLE_WORD_LENGTH);
+        if (cmp == 0) return mid;
+        if (cmp < 0) lo = mid + 1; else hi = mid - 1;
+    }
+    return -1;
+}
+
+/*
+ * HELPER: find_insert_position
+ *
+ * WHAT:
+ * Returns the index of the first entry that sorts after `word`.
+ */
+static int find_insert_position(const dictionary_entry_t* p_entries, int count, const char* word)
+{
+    int lo = 0;
+    int hi = count;
+    while (lo < hi)
+    {
+        int mid = lo + (hi - lo) / 2;
+        if (strncmp(p_entries[mid].word, word, WORDLE_WORD_LENGTH) < 0) lo = mid + 1; else hi = mid;
+    }
+    return lo;
+}
+
+/*
+ * FUNCTION: mutable_dictionary_add_word
+ *
+ * WHAT:
+ * 1. Parse the line into a fresh entry (same parser as the file loader).
+ * 2. Grow the entry array if needed and insert alphabetically.
+ * 3. Insert the matching partition table row (O(N)).
+ * 4. Refresh opener entropy and bump the generation.
+ */
+bool mutable_dictionary_add_word(mutable_dictionary_t* p_md, const char* line)
+{
+    dictionary_entry_t new_entry;
+    if (!parse_dictionary_line(line, &new_entry)) return false;
+    if (find_dictionary_word(p_md->p_entries, p_md->count, new_entry.word) >= 0) return false;
+
+    // 2. Grow (doubling) and insert in alphabetical position
+    if (p_md->count + 1 > p_md->capacity)
+    {
+        int new_capacity = (p_md->capacity > 0) ? p_md->capacity * 2 : 64;
+        dictionary_entry_t* p_new = (dictionary_entry_t*)tracked_realloc(p_md->p_entries, sizeof(dictionary_entry_t) * new_capacity);
+        if (p_new == NULL) return false;
+        p_md->p_entries = p_new;
+        p_md->capacity = new_capacity;
+    }
+
+    int index = find_insert_position(p_md->p_entries, p_md->count, new_entry.word);
+    memmove(p_md->p_entries + index + 1, p_md->p_entries + index, sizeof(dictionary_entry_t) * (p_md->count - index));
+    p_md->p_entries[index] = new_entry;
+    p_md->count++;
+
+    // 3. Patch the partition table
+    if (!partition_table_insert_word(&p_md->table, p_md->p_entries, p_md->count, index))
+    {
+        // Roll back the entry so rows and entries stay aligned
+        memmove(p_md->p_entries + index, p_md->p_entries + index + 1, sizeof(dictionary_entry_t) * (p_md->count - index - 1));
+        p_md->count--;
+        return false;
+    }
+
+    // 4. Derived data
+    partition_table_apply_entropy(&p_md->table, p_md->p_entries);
+    p_md->generation++;
+    return true;
+}
+
+/*
+ * FUNCTION: mutable_dictionary_remove_word
+ *
+ * WHAT:
+ * 1. Locate the word.
+ * 2. Remove it from the partition table (must happen BEFORE the entry is
+ * shifted out, since the table reads the word text from the array).
+ * 3. Remove the entry, refresh opener entropy and bump the generation.
+ */
+bool mutable_dictionary_remove_word(mutable_dictionary_t* p_md, const char* word)
+{
+    int index = find_dictionary_word(p_md->p_entries, p_md->count, word);
+    if (index < 0) return false;
+
+    partition_table_remove_word(&p_md->table, p_md->p_entries, index);
+
+    memmove(p_md->p_entries + index, p_md->p_entries + index + 1, sizeof(dictionary_entry_t) * (p_md->count - index - 1));
+    p_md->count--;
+
+    partition_table_apply_entropy(&p_md->table, p_md->p_entries);
+    p_md->generation++;
+    return true;
+}
+
+/*
+ * HELPER: compare_int_asc
+ *
+ * WHAT:
+ * `qsort` comparator for ascending ints.
+ */
+static int compare_int_asc(const void* p1, const void* p2)
+{
+    int a = *(const int*)p1;
+    int b = *(const int*)p2;
+    return (a > b) - (a < b);
+}
+
+/*
+ * FUNCTION: mutable_dictionary_remove_words
+ *
+ * WHAT:
+ * 1. Resolve every word to an index (binary search), sort and de-duplicate.
+ * 2. Batch-remove them from the partition table (BEFORE the entries move).
+ * 3. Compact the entry array in one pass, refresh entropy, bump generation.
+ */
+int mutable_dictionary_remove_words(mutable_dictionary_t* p_md, const char* p_words, int word_count)
+{
+    if (word_count <= 0) return 0;
+    int* p_indices = (int*)tracked_malloc(sizeof(int) * word_count);
+    if (p_indices == NULL) return 0;
+
+    // 1. Resolve
+    int index_count = 0;
+    for (int i = 0; i < word_count; i++)
+    {
+        int index = find_dictionary_word(p_md->p_entries, p_md->count, p_words + (size_t)i * WORDLE_WORD_LENGTH);
+        if (index >= 0) p_indices[index_count++] = index;
+    }
+    qsort(p_indices, index_count, sizeof(int), compare_int_asc);
+    int unique_count = 0;
+    for (int i = 0; i < index_count; i++)
+    {
+        if (unique_count == 0 || p_indices[unique_count - 1] != p_indices[i]) p_indices[unique_count++] = p_indices[i];
+    }
+
+    if (unique_count > 0)
+    {
+        // 2. Partition table
+        partition_table_remove_words(&p_md->table, p_md->p_entries, p_indices, unique_count);
+
+        // 3. Entries
+        int kept = 0;
+        int next = 0;
+        for (int i = 0; i < p_md->count; i++)
+        {
+            if (next < unique_count && p_indices[next] == i) { next++; continue; }
+            if (kept != i) p_md->p_entries[kept] = p_md->p_entries[i];
+            kept++;
+        }
+        p_md->count = kept;
+
+        partition_table_apply_entropy(&p_md->table, p_md->p_entries);
+        p_md->generation++;
+    }
+
+    tracked_free(p_indices);
+    return unique_count;
+}
+
+/*
+ * FUNCTION: free_mutable_dictionary
+ */
+void free_mutable_dictionary(mutable_dictionary_t* p_md)
+{
+    if (p_md->p_entries != NULL) tracked_free(p_md->p_entries);
+    p_md->p_entries = NULL;
+    p_md->count = 0;
+    p_md->capacity = 0;
+    free_partition_table(&p_md->table);
+}
@@ -0,0 +1,140 @@
+/*
+ * FILE: dictionary_mutation.h
+ *
+ * WHAT:
+ * Defines the interface for a dictionary that can gain or lose words at
+ * runtime while keeping all derived data current:
+ * - Per-word metadata (duplicate letters, tags) via the normal line parser.
+ * - Opener entropy for every word.
+ * - The per-guess pattern histograms (partition table) behind that entropy.
+ * - A generation counter that caches use to detect stale entries.
+ *
+ * WHY:
+ * Adding a newly accepted word or retiring a fresh "Used Word" used to mean
+ * reloading `AllWords.txt` and repeating the O(N^2) entropy pass. With this
+ * API, each changed word costs O(N), so a long-running process (server,
+ * replay, pipelined startup) never needs a restart to pick up changes.
+ */
+
+#pragma once
+#ifndef DICTIONARY_MUTATION_H
+#define DICTIONARY_MUTATION_H
+#include "wordle_types.h"
+#include "partition_table.h"
+
+/*
+ * STRUCT: mutable_dictionary_t
+ *
+ * WHAT:
+ * A dictionary array (kept in alphabetical order) plus its partition table.
+ *
+ * FIELDS:
+ * - p_entries: The entries. `entropy_score` always holds the current opener entropy.
+ * - count / capacity: Used and allocated entries.
+ * - table: Pattern histograms, row `i` belongs to `p_entries[i]`.
+ * - generation: Incremented on every successful add/remove. A cache whose
+ * entries depend on the word SET records the generation it is current for
+ * and treats a mismatch as "invalidate everything" (the replay's Turn 2
+ * memo advances its own copy only for the removals it invalidated for).
+ * Caches keyed by word identity need no check: pattern rows are found by
+ * the `dictionary_index` stamp each entry carries, which moves with the
+ * entry and is -1 for added words (see pattern_cache.h).
+ *
+ * WHY:
+ * NOTE: Adding a word may `realloc` `p_entries`, and both operations shift
+ * entries. Pointer views (entropy/rank sorted arrays) must be rebuilt after
+ * any mutation.
+ */
+typedef struct _mutable_dictionary
+{
+    dictionary_entry_t* p_entries;
+    int count;
+    int capacity;
+    partition_table_t table;
+    unsigned int generation;
+} mutable_dictionary_t;
+
+/*
+ * FUNCTION: init_mutable_dictionary
+ *
+ * WHAT:
+ * Copies `p_source` into a new mutable dictionary, builds the partition
+ * table (the one-off O(N^2) step) and fills in the opener entropy.
+ *
+ * RETURNS:
+ * - true if successful, false if memory allocation fails.
+ */
+bool init_mutable_dictionary(mutable_dictionary_t* p_md, const dictionary_entry_t* p_source, int count);
+
+/*
+ * FUNCTION: find_dictionary_word
+ *
+ * WHAT:
+ * Binary search for `word` in an alphabetically ordered dictionary array.
+ *
+ * RETURNS:
+ * - The index of the entry, or -1 if it is not present.
+ */
+int find_dictionary_word(const dictionary_entry_t* p_entries, int count, const char* word);
+
+/*
+ * FUNCTION: mutable_dictionary_add_word
+ *
+ * WHAT:
+ * Parses `line` (same fixed-width format as `AllWords.txt`, e.g. "CAKES095PS"),
+ * inserts it in alphabetical position, and updates the partition table and
+ * every word's opener entropy.
+ *
+ * RETURNS:
+ * - false if the line is malformed, the word already exists, or memory
+ * allocation fails.
+ *
+ * COST:
+ * O(N) feedback computations + O(N) entropy refresh.
+ */
+bool mutable_dictionary_add_word(mutable_dictionary_t* p_md, const char* line);
+
+/*
+ * FUNCTION: mutable_dictionary_remove_word
+ *
+ * WHAT:
+ * Removes `word` (first 5 characters are used) from the dictionary, the
+ * partition table and the answer pool, then refreshes opener entropy.
+ *
+ * RETURNS:
+ * - false if the word is not present.
+ *
+ * COST:
+ * O(N) feedback computations + O(N) entropy refresh.
+ */
+bool mutable_dictionary_remove_word(mutable_dictionary_t* p_md, const char* word);
+
+/*
+ * FUNCTION: mutable_dictionary_remove_words
+ *
+ * WHAT:
+ * Removes every word in `p_words` (packed, 5 bytes each, any order) that is
+ * present in the dictionary, as one batch.
+ *
+ * RETURNS:
+ * - The number of words actually removed (words not present are ignored).
+ *
+ * COST:
+ * O(N x removed) feedback computations, with the table and entry array each
+ * compacted once. The generation is bumped once per call.
+ *
+ * WHY:
+ * The startup pipeline applies the whole "Used Words" list after the
+ * precompute has finished; one call per word would move the table per word.
+ */
+int mutable_dictionary_remove_words(mutable_dictionary_t* p_md, const char* p_words, int word_count);
+
+/*
+ * FUNCTION: free_mutable_dictionary
+ *
+ * WHAT:
+ * Releases the entries and the partition table.
+ */
+void free_mutable_dictionary(mutable_dictionary_t* p_md);
+
+#endif
@@ -16,6 +16,8 @@
  */
 
 #include "duplicate_dictionary.h"
+#include "comparators.h"
+#include "alloc_tracker.h"
 #include <memory.h>
 #include <stdlib.h>
 
@@ -55,7 +57,7 @@ bool duplicate_dictionary_pointers(const dictionary_entry_t* p_source_dictionary
     // 2. Allocate Memory for the View
     // We allocate an array of POINTERS (dictionary_entry_t*), not structs.
     dictionary_entry_t** p_target_pointer_array =
-        (dictionary_entry_t**)malloc(sizeof(dictionary_entry_t*) * source_dictionary_count);
+        (dictionary_entry_t**)tracked_malloc(sizeof(dictionary_entry_t*) * source_dictionary_count);
 
     if (p_target_pointer_array == NULL)
     {
@@ -72,12 +74,17 @@ bool duplicate_dictionary_pointers(const dictionary_entry_t* p_source_dictionary
     }
 
     // 4. Sort the View
-    // Use the standard library QuickSort.
+    // The entropy views have an integer key and are radix sorted into the same order.
+    // Everything else uses the standard library QuickSort.
     // Note: We are sorting elements of size `sizeof(pointer)`, using the custom comparator.
-    qsort(p_target_pointer_array,
-        source_dictionary_count,
-        sizeof(dictionary_entry_t*),
-        compare_func);
+    bool is_entropy_view = (compare_func == compare_dictionary_entries_by_entropy_desc || compare_func == compare_dictionary_entries_by_entropy_no_filter_desc);
+    if (!is_entropy_view || !radix_sort_entropy_view(p_target_pointer_array, source_dictionary_count, compare_func == compare_dictionary_entries_by_entropy_desc))
+    {
+        qsort(p_target_pointer_array,
+            source_dictionary_count,
+            sizeof(dictionary_entry_t*),
+            compare_func);
+    }
 
     // 5. Return the Result
     *pp_target_pointer_array = p_target_pointer_array;
@@ -12,6 +12,12 @@
  * patterns, avoiding expensive malloc/free calls in the hot path.
  * 3. OpenMP Parallelism: The outer loops are parallelized to utilize all
  * available CPU cores, reducing calculation time from seconds to milliseconds.
+ * 4. Duplicate-free Guesses: Most guesses have five distinct letters. For
+ * them a non-green letter is yellow exactly when the answer contains it, so
+ * each pattern is five compares against a letter mask built once per pass.
+ * 5. Integer Scores: Entropy is a fixed-point score summed from a table of
+ * c*log2(c) integers, so no log() runs per bucket and every kernel agrees
+ * to the last bit (see entropy_calculator.h).
  *
  * WHY:
  * Entropy calculation is the bottleneck. Computing entropy for 5,000 words against
@@ -21,6 +27,10 @@
  */
 
 #include "entropy_calculator.h"
+#include "pattern_cache.h"
+#include "auto_tuner.h"
+#include "trace_probes.h"
+#include "alloc_tracker.h"
 #include <memory.h>
 #include <string.h>
 #include <math.h>
@@ -28,10 +38,6 @@
 #include <stdlib.h>
 #include <omp.h> // REQUIRED: OpenMP Header for multi-threading
 
- // CONSTANT: 3^5 = 243 possible patterns (B, Y, G)
- // 0 = Black, 1 = Yellow, 2 = Green
-#define MAX_PATTERNS 243 
-
 /*
  * FUNCTION: get_feedback_pattern
  *
@@ -151,51 +157,436 @@ static int compute_feedback_index(const char* guess, const char* answer)
     return index;
 }
 
+/*
+ * STRUCT: answer_profile_t
+ *
+ * WHAT:
+ * One valid answer packed for the duplicate-free kernel: its letters by
+ * position and the set of letters it contains (bit 0 = 'A', 26 bits).
+ *
+ * WHY:
+ * Built once per entropy pass and read by every guess, contiguously, instead
+ * of following each answer pointer and re-counting its letters.
+ */
+typedef struct _answer_profile
+{
+    char letters[WORDLE_WORD_LENGTH];
+    unsigned int letter_mask;
+} answer_profile_t;
+
+/*
+ * STATIC: t_p_profile_buffer, t_profile_capacity
+ *
+ * WHAT:
+ * The calling thread's answer-profile buffer, bound by
+ * `bind_entropy_profile_buffer` (NULL / 0 when none is bound).
+ */
+static thread_local answer_profile_t* t_p_profile_buffer = NULL;
+static thread_local int t_profile_capacity = 0;
+
+/*
+ * FUNCTION: entropy_profile_buffer_bytes
+ *
+ * RETURNS:
+ * - The bytes a profile buffer for `answer_capacity` answers needs.
+ */
+size_t entropy_profile_buffer_bytes(int answer_capacity)
+{
+    return sizeof(answer_profile_t) * (size_t)(answer_capacity > 0 ? answer_capacity : 1);
+}
+
+/*
+ * FUNCTION: bind_entropy_profile_buffer
+ *
+ * WHAT:
+ * Records the thread's buffer. The caller keeps ownership.
+ */
+void bind_entropy_profile_buffer(void* p_buffer, int answer_capacity)
+{
+    t_p_profile_buffer = (answer_profile_t*)p_buffer;
+    t_profile_capacity = (p_buffer != NULL) ? answer_capacity : 0;
+}
+
+/*
+ * HELPER: build_answer_profiles
+ *
+ * WHAT:
+ * Fills the thread's bound profile buffer when it is large enough, otherwise
+ * a fresh one.
+ *
+ * RETURNS:
+ * - The profiles, or NULL if out of memory (the passes then use the general
+ * kernel only). `*p_is_owned` is set when the caller must free them.
+ */
+static answer_profile_t* build_answer_profiles(dictionary_entry_t** ppValidAnswers, int numValidAnswers, bool* p_is_owned)
+{
+    *p_is_owned = (t_p_profile_buffer == NULL || numValidAnswers > t_profile_capacity);
+    answer_profile_t* pProfiles = *p_is_owned ? (answer_profile_t*)tracked_malloc(entropy_profile_buffer_bytes(numValidAnswers)) : t_p_profile_buffer;
+    if (pProfiles == NULL) return NULL;
+
+    for (int i = 0; i < numValidAnswers; i++)
+    {
+        pProfiles[i].letter_mask = 0;
+        for (int j = 0; j < WORDLE_WORD_LENGTH; j++)
+        {
+            char letter = ppValidAnswers[i]->word[j];
+            pProfiles[i].letters[j] = letter;
+            pProfiles[i].letter_mask |= 1u << (letter - 'A');
+        }
+    }
+    return pProfiles;
+}
+
+/*
+ * FUNCTION: compute_distinct_feedback_index
+ *
+ * WHAT:
+ * `compute_feedback_index` for a guess WITHOUT duplicate letters.
+ *
+ * WHY:
+ * A guess letter that is not green appears nowhere else in the guess, so no
+ * other position can consume the answer's copies of it: it is yellow iff the
+ * answer contains it at all, whatever the answer's own duplicates. That
+ * removes the 26-entry count array and the second pass. Guesses WITH
+ * duplicate letters must keep using `compute_feedback_index`.
+ */
+static inline int compute_distinct_feedback_index(const char* guess, const answer_profile_t* pAnswer)
+{
+    int index = 0;
+
+    // Horner's rule from the most significant position (4) down to the LSD (0)
+    for (int i = WORDLE_WORD_LENGTH - 1; i >= 0; i--)
+    {
+        index *= 3;
+        if (guess[i] == pAnswer->letters[i]) index += 2;
+        else index += (int)((pAnswer->letter_mask >> (guess[i] - 'A')) & 1u);
+    }
+    return index;
+}
+
+/*
+ * FUNCTION: get_feedback_index
+ *
+ * WHAT:
+ * Public wrapper around `compute_feedback_index`.
+ *
+ * WHY:
+ * Keeps the hot-path version `static` (so the compiler can inline it into the
+ * entropy loop) while still letting other modules share the exact encoding.
+ */
+int get_feedback_index(const char* guess, const char* answer)
+{
+    return compute_feedback_index(guess, answer);
+}
+
+/*
+ * FUNCTION: encode_feedback_pattern
+ *
+ * WHAT:
+ * "GGBYY" -> base-3 index (B=0, Y=1, G=2, position 0 is the LSD).
+ */
+int encode_feedback_pattern(const char* result_pattern)
+{
+    int index = 0;
+    int multiplier = 1;
+    for (int i = 0; i < WORDLE_WORD_LENGTH; i++)
+    {
+        if (result_pattern[i] == 'G') index += 2 * multiplier;
+        else if (result_pattern[i] == 'Y') index += multiplier;
+        multiplier *= 3;
+    }
+    return index;
+}
+
+/*
+ * FUNCTION: decode_feedback_index
+ *
+ * WHAT:
+ * Base-3 index -> "GGBYY" (writes 5 characters plus the terminator).
+ */
+void decode_feedback_index(int pattern_index, char* result_pattern)
+{
+    const char DIGIT_TO_CHAR[3] = { 'B', 'Y', 'G' };
+    for (int i = 0; i < WORDLE_WORD_LENGTH; i++)
+    {
+        result_pattern[i] = DIGIT_TO_CHAR[pattern_index % 3];
+        pattern_index /= 3;
+    }
+    result_pattern[WORDLE_WORD_LENGTH] = '\0';
+}
+
+/*
+ * CONSTANT: C_LOG2_C_TABLE_SIZE
+ *
+ * WHAT:
+ * Counts below this take c*log2(c) from the table (128 KB). Buckets rarely
+ * hold more answers than that, and the low entries that nearly every
+ * bucket uses stay in L1.
+ */
+#define C_LOG2_C_TABLE_SIZE 16384
+
+/*
+ * HELPER: compute_c_log2_c_score
+ */
+static long long compute_c_log2_c_score(int c)
+{
+    if (c <= 1) return 0;
+    return llround((double)c * log2((double)c) * (double)ENTROPY_SCORE_ONE);
+}
+
+/*
+ * STATIC: s_c_log2_c_scores
+ *
+ * WHAT:
+ * c*log2(c) scores for every c below C_LOG2_C_TABLE_SIZE, filled by a
+ * static initializer before `main` runs, so the passes never check for it.
+ */
+static long long s_c_log2_c_scores[C_LOG2_C_TABLE_SIZE];
+
+static bool build_c_log2_c_table()
+{
+    for (int c = 0; c < C_LOG2_C_TABLE_SIZE; c++) s_c_log2_c_scores[c] = compute_c_log2_c_score(c);
+    return true;
+}
+
+static const bool s_is_c_log2_c_table_built = build_c_log2_c_table();
+
+/*
+ * FUNCTION: get_c_log2_c_score
+ */
+long long get_c_log2_c_score(int c)
+{
+    return (c < C_LOG2_C_TABLE_SIZE) ? s_c_log2_c_scores[c] : compute_c_log2_c_score(c);
+}
+
+/*
+ * FUNCTION: calculate_entropy_score_from_sum
+ *
+ * WHAT:
+ * (n*log2(n) - Sum) / n in integers. A single bucket gives exactly 0; the
+ * clamp only guards against a sum that was not built from a split of n.
+ */
+long long calculate_entropy_score_from_sum(long long sum_c_log2_c, int total)
+{
+    if (total <= 1) return 0;
+    long long numerator = get_c_log2_c_score(total) - sum_c_log2_c;
+    if (numerator <= 0) return 0;
+    return (numerator + total / 2) / total;
+}
+
+/*
+ * FUNCTION: calculate_entropy_score_from_histogram
+ *
+ * WHAT:
+ * H = -Sum( p * log2(p) ) over the 243 pattern buckets, p = counts[i] / total,
+ * rewritten as log2(n) - Sum( c * log2(c) ) / n so the sum is of integers.
+ *
+ * WHY:
+ * The one place the bucket-to-entropy formula lives. Anything that keeps its
+ * own histograms (e.g., the partition table) gets identical scores to the
+ * direct entropy pass, so tie-breaking between words never depends on which
+ * path computed them.
+ */
+long long calculate_entropy_score_from_histogram(const int* counts, int total)
+{
+    if (total <= 1) return 0;
+
+    long long sum = 0;
+    for (int i = 0; i < MAX_PATTERNS; i++) sum += get_c_log2_c_score(counts[i]);
+    return calculate_entropy_score_from_sum(sum, total);
+}
+
+/*
+ * HELPER: summarize_sorted_codes
+ *
+ * WHAT:
+ * Sorts `codes` (insertion sort: at most SMALL_SET_MAX_ANSWERS bytes, so it
+ * stays in L1 and mostly in registers) and walks the runs of equal codes.
+ * Each run is one non-empty bucket, and the integer entropy sum has the
+ * same terms as the histogram scan.
+ */
+static void summarize_sorted_codes(unsigned char* codes, int n, small_set_stats_t* pStats)
+{
+    for (int i = 1; i < n; i++)
+    {
+        unsigned char code = codes[i];
+        int j = i - 1;
+        while (j >= 0 && codes[j] > code) { codes[j + 1] = codes[j]; j--; }
+        codes[j + 1] = code;
+    }
+
+    long long sum = 0;
+    memset(pStats, 0, sizeof(small_set_stats_t));
+    for (int start = 0; start < n; )
+    {
+        int end = start + 1;
+        while (end < n && codes[end] == codes[start]) end++;
+        int c = end - start;
+        sum += get_c_log2_c_score(c);
+        pStats->bucket_count++;
+        pStats->sum_squares += (long)c * c;
+        if (c > pStats->max_bucket) pStats->max_bucket = c;
+        if (c == 1) pStats->singleton_count++;
+        start = end;
+    }
+    pStats->entropy_score = calculate_entropy_score_from_sum(sum, n);
+}
+
+/*
+ * FUNCTION: calculate_small_set_stats
+ */
+void calculate_small_set_stats(const char* guess, dictionary_entry_t** ppValidAnswers, int numValidAnswers, small_set_stats_t* pStats)
+{
+    unsigned char codes[SMALL_SET_MAX_ANSWERS];
+    for (int i = 0; i < numValidAnswers; i++)
+    {
+        codes[i] = (unsigned char)compute_feedback_index(guess, ppValidAnswers[i]->word);
+    }
+    summarize_sorted_codes(codes, numValidAnswers, pStats);
+}
+
 /*
  * FUNCTION: calculate_entropy_internal
  *
  * WHAT:
- * Calculates the Shannon Entropy for a single `guess` against a list of `validAnswers`.
+ * Calculates the Shannon Entropy for a single guess against a list of `validAnswers`.
  * Formula: H = -Sum( p(x) * log2(p(x)) )
  * Where x is a feedback pattern, and p(x) is the probability of getting that pattern.
+ * With `pProfiles` (the answers' profiles, same order) a duplicate-free guess
+ * takes the mask kernel; the histogram, and so the entropy, is the same.
  *
  * WHY:
  * Higher entropy means the guess splits the set of possible answers into smaller,
  * more uniform groups. A guess with 0.0 entropy provides no new information.
  */
-static double calculate_entropy_internal(const char* guess, dictionary_entry_t** ppValidAnswers, int numValidAnswers)
+static long long calculate_entropy_internal(const dictionary_entry_t* pGuess, dictionary_entry_t** ppValidAnswers, int numValidAnswers, const answer_profile_t* pProfiles)
 {
-    if (numValidAnswers <= 1) return 0.0;
+    if (numValidAnswers <= 1) return 0;
+
+    const char* guess = pGuess->word;
+    bool use_masks = (pProfiles != NULL && !pGuess->contains_duplicate_letters);
+
+    // Late turns: a few codes sorted in place beat clearing and scanning 243 buckets.
+    if (numValidAnswers <= SMALL_SET_MAX_ANSWERS)
+    {
+        small_set_stats_t stats;
+        if (!use_masks)
+        {
+            calculate_small_set_stats(guess, ppValidAnswers, numValidAnswers, &stats);
+            return stats.entropy_score;
+        }
+        unsigned char codes[SMALL_SET_MAX_ANSWERS];
+        for (int i = 0; i < numValidAnswers; i++) codes[i] = (unsigned char)compute_distinct_feedback_index(guess, &pProfiles[i]);
+        summarize_sorted_codes(codes, numValidAnswers, &stats);
+        return stats.entropy_score;
+    }
 
     // Optimization: Use a fixed-size array on the stack.
     // This histogram counts how many answers result in each of the 243 patterns.
     int counts[MAX_PATTERNS] = { 0 };
 
     // 1. Tally pattern frequencies
-    for (int i = 0; i < numValidAnswers; i++)
+    if (use_masks)
     {
-        // Generate the pattern index (0-242) and increment the bucket
-        int pattern_idx = compute_feedback_index(guess, ppValidAnswers[i]->word);
-        counts[pattern_idx]++;
+        for (int i = 0; i < numValidAnswers; i++) counts[compute_distinct_feedback_index(guess, &pProfiles[i])]++;
+    }
+    else
+    {
+        for (int i = 0; i < numValidAnswers; i++)
+        {
+            // Generate the pattern index (0-242) and increment the bucket
+            int pattern_idx = compute_feedback_index(guess, ppValidAnswers[i]->word);
+            counts[pattern_idx]++;
+        }
     }
 
     // 2. Calculate Shannon Entropy
-    double entropy = 0.0;
-    const double LOG2_E = 1.44269504089; // log2(e) pre-calculated for speed
-    double inv_num = 1.0 / (double)numValidAnswers;
+    return calculate_entropy_score_from_histogram(counts, numValidAnswers);
+}
+
+/*
+ * FUNCTION: calculate_entropy_for_entry
+ *
+ * WHAT:
+ * `calculate_entropy_internal` for a dictionary entry. When `use_cache` is
+ * set, the histogram (or, for small sets, the sorted code array) is filled
+ * from the guess's cached pattern row instead of recomputing each pattern.
+ *
+ * WHY:
+ * A row lookup is one byte load per answer instead of two passes over both
+ * words. The histogram (and therefore the entropy) is identical either way.
+ */
+static long long calculate_entropy_for_entry(const dictionary_entry_t* pGuess, dictionary_entry_t** ppValidAnswers, int numValidAnswers, bool use_cache, const answer_profile_t* pProfiles)
+{
+    if (numValidAnswers <= 1) return 0;
 
+    const unsigned char* p_row = NULL;
+    if (use_cache)
+    {
+        p_row = pattern_cache_acquire_row(g_p_pattern_cache, pGuess->dictionary_index);
+        TRACE_CACHE_LOOKUP(TRACE_CACHE_PATTERN_ROW, (p_row != NULL) ? 1 : 0);
+    }
+    if (p_row == NULL) return calculate_entropy_internal(pGuess, ppValidAnswers, numValidAnswers, pProfiles);
+
+    if (numValidAnswers <= SMALL_SET_MAX_ANSWERS)
+    {
+        unsigned char codes[SMALL_SET_MAX_ANSWERS];
+        for (int i = 0; i < numValidAnswers; i++) codes[i] = p_row[ppValidAnswers[i]->dictionary_index];
+        pattern_cache_release_row(g_p_pattern_cache, pGuess->dictionary_index);
+
+        small_set_stats_t stats;
+        summarize_sorted_codes(codes, numValidAnswers, &stats);
+        return stats.entropy_score;
+    }
+
+    int counts[MAX_PATTERNS] = { 0 };
+    for (int i = 0; i < numValidAnswers; i++)
+    {
+        counts[p_row[ppValidAnswers[i]->dictionary_index]]++;
+    }
+    pattern_cache_release_row(g_p_pattern_cache, pGuess->dictionary_index);
+
+    return calculate_entropy_score_from_histogram(counts, numValidAnswers);
+}
+
+/*
+ * FUNCTION: calculate_partition_stats
+ *
+ * WHAT:
+ * 1. Tally the pattern histogram (same loop as `calculate_entropy_internal`).
+ * 2. Single pass over the buckets for entropy, Sum( c^2 ), max and non-empty count.
+ * 3. The guess itself can only win if it is still a valid answer.
+ */
+void calculate_partition_stats(const dictionary_entry_t* pGuess, dictionary_entry_t** ppValidAnswers, int numValidAnswers, partition_stats_t* pStats)
+{
+    memset(pStats, 0, sizeof(partition_stats_t));
+    pStats->pEntry = pGuess;
+    if (numValidAnswers <= 0) return;
+
+    // 1. Tally pattern frequencies
+    for (int i = 0; i < numValidAnswers; i++)
+    {
+        pStats->histogram[compute_feedback_index(pGuess->word, ppValidAnswers[i]->word)]++;
+    }
+
+    // 2. Fused bucket scan
+    double inv_num = 1.0 / (double)numValidAnswers;
+    long long sum = 0;
+    long sum_squares = 0;
     for (int i = 0; i < MAX_PATTERNS; i++)
     {
-        if (counts[i] > 0)
-        {
-            // p = Probability of this pattern occurring
-            double p = counts[i] * inv_num;
-            // H -= p * ln(p)
-            entropy -= p * log(p);
-        }
+        int c = pStats->histogram[i];
+        if (c == 0) continue;
+        sum += get_c_log2_c_score(c);
+        sum_squares += (long)c * c;
+        if (c > pStats->max_bucket) pStats->max_bucket = c;
+        pStats->bucket_count++;
     }
+    pStats->entropy_score = calculate_entropy_score_from_sum(sum, numValidAnswers);
+    pStats->expected_remaining = (double)sum_squares * inv_num;
 
-    return entropy * LOG2_E; // Convert natural log result to base-2 bits
+    // 3. Win chance this turn (uniform prior over the valid answers)
+    pStats->win_probability = pGuess->is_eliminated ? 0.0 : inv_num;
 }
 
 /*
@@ -222,7 +613,7 @@ void calculate_entropy_on_dictionary(dictionary_entry_t* pDictionary, int dictio
 
     if (validCount == 0) return;
 
-    dictionary_entry_t** ppValid = (dictionary_entry_t**)malloc(sizeof(dictionary_entry_t*) * validCount);
+    dictionary_entry_t** ppValid = (dictionary_entry_t**)tracked_malloc(sizeof(dictionary_entry_t*) * validCount);
     if (!ppValid) return;
 
     int idx = 0;
@@ -233,6 +624,10 @@ void calculate_entropy_on_dictionary(dictionary_entry_t* pDictionary, int dictio
 
     // 2. Calculate Entropy (Parallelized)
     // We use OpenMP "dynamic" scheduling because some words might finish faster than others.
+    bool use_cache = (g_tuning_config.entropy_kernel == ENTROPY_KERNEL_ROW_LOOKUP && g_p_pattern_cache != NULL && pattern_cache_covers(g_p_pattern_cache, ppValid, validCount));
+    bool is_profiles_owned = false;
+    answer_profile_t* pProfiles = use_cache ? NULL : build_answer_profiles(ppValid, validCount, &is_profiles_owned);
+    TRACE_ENTROPY_START(TRACE_ENTROPY_DICTIONARY, validCount, validCount, use_cache ? 1 : 0);
 #pragma omp parallel for schedule(dynamic)
     for (int i = 0; i < dictionaryCount; i++)
     {
@@ -240,15 +635,17 @@ void calculate_entropy_on_dictionary(dictionary_entry_t* pDictionary, int dictio
         // In Hard Mode, we can't play them anyway.
         if (pDictionary[i].is_eliminated)
         {
-            pDictionary[i].entropy = 0.0;
+            pDictionary[i].entropy_score = 0;
         }
         else
         {
-            pDictionary[i].entropy = calculate_entropy_internal(pDictionary[i].word, ppValid, validCount);
+            pDictionary[i].entropy_score = calculate_entropy_for_entry(&pDictionary[i], ppValid, validCount, use_cache, pProfiles);
         }
     }
+    TRACE_ENTROPY_END(TRACE_ENTROPY_DICTIONARY, validCount, validCount);
 
-    free(ppValid);
+    if (is_profiles_owned) tracked_free(pProfiles);
+    tracked_free(ppValid);
 }
 
 /*
@@ -266,11 +663,85 @@ void calculate_entropy_on_dictionary(dictionary_entry_t* pDictionary, int dictio
 void calculate_entropy_for_candidates(dictionary_entry_t* pCandidates, int candidateCount,
     dictionary_entry_t** ppValidAnswers, int validAnswerCount)
 {
+    // The kernel and the schedule (tile size) are chosen by the auto-tuner (auto_tuner.h).
+    // Answers from outside the cached universe (e.g., added at runtime) cannot use the cache.
+    bool use_cache = (g_tuning_config.entropy_kernel == ENTROPY_KERNEL_ROW_LOOKUP && g_p_pattern_cache != NULL && pattern_cache_covers(g_p_pattern_cache, ppValidAnswers, validAnswerCount));
+    bool is_profiles_owned = false;
+    answer_profile_t* pProfiles = use_cache ? NULL : build_answer_profiles(ppValidAnswers, validAnswerCount, &is_profiles_owned);
+    TRACE_ENTROPY_START(TRACE_ENTROPY_CANDIDATES, candidateCount, validAnswerCount, use_cache ? 1 : 0);
+
     // OpenMP Parallel Loop
     // Calculates H(Candidate | ValidAnswers) for every word in the dictionary.
-#pragma omp parallel for schedule(static)
+#pragma omp parallel for schedule(runtime) num_threads(get_tuned_thread_count())
     for (int i = 0; i < candidateCount; i++)
     {
-        pCandidates[i].entropy = calculate_entropy_internal(pCandidates[i].word, ppValidAnswers, validAnswerCount);
+        pCandidates[i].entropy_score = calculate_entropy_for_entry(&pCandidates[i], ppValidAnswers, validAnswerCount, use_cache, pProfiles);
     }
-}
\ No newline at end of file
+    TRACE_ENTROPY_END(TRACE_ENTROPY_CANDIDATES, candidateCount, validAnswerCount);
+
+    if (is_profiles_owned) tracked_free(pProfiles);
+}
+
+/*
+ * HELPER: score_candidate_range
+ *
+ * WHAT:
+ * The candidate loop of `calculate_entropy_for_candidates` over
+ * `[begin, end)`, restricted to candidates whose `is_eliminated` flag equals
+ * `is_eliminated`.
+ */
+static void score_candidate_range(dictionary_entry_t* pCandidates, int begin, int end, bool is_eliminated,
+    dictionary_entry_t** ppValidAnswers, int validAnswerCount, bool use_cache, const answer_profile_t* pProfiles)
+{
+#pragma omp parallel for schedule(runtime) num_threads(get_tuned_thread_count())
+    for (int i = begin; i < end; i++)
+    {
+        if (pCandidates[i].is_eliminated != is_eliminated) continue;
+        pCandidates[i].entropy_score = calculate_entropy_for_entry(&pCandidates[i], ppValidAnswers, validAnswerCount, use_cache, pProfiles);
+    }
+}
+
+/*
+ * FUNCTION: calculate_entropy_for_candidates_until
+ *
+ * WHAT:
+ * 1. No deadline: exactly `calculate_entropy_for_candidates`.
+ * 2. Score every candidate that may still be the answer.
+ * 3. Score the eliminated ones a chunk at a time until the deadline passes;
+ * the rest are zeroed.
+ */
+bool calculate_entropy_for_candidates_until(dictionary_entry_t* pCandidates, int candidateCount,
+    dictionary_entry_t** ppValidAnswers, int validAnswerCount, double deadline)
+{
+    // 1. Unbounded
+    if (deadline <= 0.0)
+    {
+        calculate_entropy_for_candidates(pCandidates, candidateCount, ppValidAnswers, validAnswerCount);
+        return true;
+    }
+
+    bool use_cache = (g_tuning_config.entropy_kernel == ENTROPY_KERNEL_ROW_LOOKUP && g_p_pattern_cache != NULL && pattern_cache_covers(g_p_pattern_cache, ppValidAnswers, validAnswerCount));
+    bool is_profiles_owned = false;
+    answer_profile_t* pProfiles = use_cache ? NULL : build_answer_profiles(ppValidAnswers, validAnswerCount, &is_profiles_owned);
+    TRACE_ENTROPY_START(TRACE_ENTROPY_CANDIDATES, candidateCount, validAnswerCount, use_cache ? 1 : 0);
+
+    // 2. Possible answers
+    score_candidate_range(pCandidates, 0, candidateCount, false, ppValidAnswers, validAnswerCount, use_cache, pProfiles);
+
+    // 3. Burners, while time remains
+    int scored_end = 0;
+    while (scored_end < candidateCount && omp_get_wtime() < deadline)
+    {
+        int chunk_end = (scored_end + ENTROPY_DEADLINE_CHUNK < candidateCount) ? scored_end + ENTROPY_DEADLINE_CHUNK : candidateCount;
+        score_candidate_range(pCandidates, scored_end, chunk_end, true, ppValidAnswers, validAnswerCount, use_cache, pProfiles);
+        scored_end = chunk_end;
+    }
+    for (int i = scored_end; i < candidateCount; i++)
+    {
+        if (pCandidates[i].is_eliminated) pCandidates[i].entropy_score = 0;
+    }
+    TRACE_ENTROPY_END(TRACE_ENTROPY_CANDIDATES, candidateCount, validAnswerCount);
+
+    if (is_profiles_owned) tracked_free(pProfiles);
+    return (scored_end == candidateCount);
+}
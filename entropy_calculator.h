@@ -17,6 +17,20 @@
 #define ENTROPY_CALCULATOR_H
 #include "wordle_types.h"
 
+ /*
+  * CONSTANT: MAX_PATTERNS
+  *
+  * WHAT:
+  * 3^5 = 243 possible feedback patterns (B, Y, G per position).
+  * Pattern indices are base-3 integers: 0 = Black, 1 = Yellow, 2 = Green,
+  * with position 0 as the least significant digit.
+  *
+  * WHY:
+  * Shared by every module that builds per-pattern histograms (the entropy
+  * engine, the incremental partition table, etc.).
+  */
+#define MAX_PATTERNS 243
+
  /*
   * FUNCTION: get_feedback_pattern
   *
@@ -31,6 +45,207 @@
   */
 void get_feedback_pattern(const char* guess, const char* answer, char* result_pattern);
 
+/*
+ * FUNCTION: get_feedback_index
+ *
+ * WHAT:
+ * Returns the integer pattern index (0-242) for a guess against an answer.
+ * This is the same encoding used internally by the entropy engine.
+ *
+ * WHY:
+ * Modules that maintain their own pattern histograms (e.g., the incremental
+ * partition table used by the historical replay) need the exact same encoding
+ * without going through the slower string form.
+ */
+int get_feedback_index(const char* guess, const char* answer);
+
+/*
+ * FUNCTION: encode_feedback_pattern / decode_feedback_index
+ *
+ * WHAT:
+ * Convert between the feedback string form ("GGBYY") and the integer pattern
+ * index (0-242) used by `get_feedback_index`.
+ *
+ * WHY:
+ * User input and log output use strings, while the filters compare integer
+ * codes. Encoding the observed result once per turn turns every per-word
+ * comparison into a single integer compare.
+ */
+int encode_feedback_pattern(const char* result_pattern);
+void decode_feedback_index(int pattern_index, char* result_pattern);
+
+/*
+ * CONSTANTS: Entropy Scores
+ *
+ * WHAT:
+ * Entropy is kept as a fixed-point integer score, bits * 2^32
+ * (ENTROPY_SCORE_ONE = 1 bit). No split of one answer set can exceed
+ * log2(243) < 8 bits, so every score fits in 35 bits, and converting one to
+ * a double for display or arithmetic is exact.
+ *
+ * WHY:
+ * Scores are built from integer c*log2(c) terms (`get_c_log2_c_score`), and
+ * an integer sum does not depend on the order of its terms. The histogram
+ * scan, the sorted small-set runs, the cached rows, the partition table's
+ * running sums and any vectorized kernel all give the same score for the
+ * same split on any thread, so ties between guesses are exact and the
+ * entropy views can be radix sorted on the score.
+ */
+#define ENTROPY_SCORE_FRACTION_BITS 32
+#define ENTROPY_SCORE_ONE (1LL << ENTROPY_SCORE_FRACTION_BITS)
+#define ENTROPY_SCORE_TO_BITS(score) ((double)(score) / (double)ENTROPY_SCORE_ONE)
+
+/*
+ * CONSTANT: ENTROPY_SCORE_FORMAT
+ *
+ * WHAT:
+ * Identifies how scores are computed and compared (1 = floating-point bits,
+ * 2 = the fixed-point scores above). Bump it with any change that can turn
+ * a score or a tie out differently.
+ *
+ * WHY:
+ * Decisions outlive the process in the shared state cache; its version key
+ * includes this (and ENTROPY_SCORE_FRACTION_BITS), so files written under
+ * other scoring are refused instead of serving stale decisions.
+ */
+#define ENTROPY_SCORE_FORMAT 2
+
+/*
+ * FUNCTION: get_c_log2_c_score
+ *
+ * WHAT:
+ * c * log2(c) as a fixed-point score (0 for c <= 1). Small counts come from
+ * a table built once at startup; larger ones are computed the same way on
+ * demand, so a given count always has the same value.
+ */
+long long get_c_log2_c_score(int c);
+
+/*
+ * FUNCTION: calculate_entropy_score_from_sum
+ *
+ * WHAT:
+ * H = log2(n) - Sum( c * log2(c) ) / n as a score, from the integer sum
+ * over the buckets of a split of `total` answers (rounded to nearest).
+ */
+long long calculate_entropy_score_from_sum(long long sum_c_log2_c, int total);
+
+/*
+ * FUNCTION: calculate_entropy_score_from_histogram
+ *
+ * WHAT:
+ * The entropy score of a 243-bucket pattern histogram whose counts sum to
+ * `total`.
+ *
+ * WHY:
+ * Shared by the direct entropy pass and by modules that keep their own
+ * histograms, so both produce identical scores.
+ */
+long long calculate_entropy_score_from_histogram(const int* counts, int total);
+
+/*
+ * CONSTANT: SMALL_SET_MAX_ANSWERS
+ *
+ * WHAT:
+ * Answer sets up to this size take the small-set kernel: the pattern codes
+ * go into a 32-byte array, are sorted, and each run of equal codes is one
+ * bucket. Larger sets use the 243-bucket histogram.
+ *
+ * WHY:
+ * Late turns leave a handful of answers, but the histogram still costs a
+ * 1 KB clear and a 243-bucket scan for each of ~6,500 Normal Mode
+ * candidates, which outweighs the few feedback computations themselves.
+ */
+#define SMALL_SET_MAX_ANSWERS 32
+
+/*
+ * STRUCT: small_set_stats_t
+ *
+ * FIELDS:
+ * - entropy_score: Entropy score of the split, identical to
+ * `calculate_entropy_score_from_histogram`.
+ * - bucket_count: Non-empty buckets.
+ * - max_bucket: Largest bucket.
+ * - singleton_count: Buckets holding exactly one answer.
+ * - sum_squares: Sum( c^2 ) over the buckets.
+ */
+typedef struct _small_set_stats
+{
+    long long entropy_score;
+    int bucket_count;
+    int max_bucket;
+    int singleton_count;
+    long sum_squares;
+} small_set_stats_t;
+
+/*
+ * FUNCTION: calculate_small_set_stats
+ *
+ * WHAT:
+ * The small-set kernel: bucket statistics of `guess` against at most
+ * SMALL_SET_MAX_ANSWERS answers, without a histogram. The entropy passes
+ * switch to it on their own; the look-ahead scorer calls it directly.
+ */
+void calculate_small_set_stats(const char* guess, dictionary_entry_t** ppValidAnswers, int numValidAnswers, small_set_stats_t* pStats);
+
+/*
+ * STRUCT: partition_stats_t
+ *
+ * WHAT:
+ * Everything one guess does to the current answer set, derived from a single
+ * 243-bucket histogram.
+ *
+ * FIELDS:
+ * - pEntry: The guess.
+ * - entropy_score: Entropy score of the split.
+ * - expected_remaining: Expected answers left after this guess, Sum( c^2 ) / n.
+ * - max_bucket: Worst-case answers left (largest bucket).
+ * - bucket_count: Number of distinct patterns (non-empty buckets).
+ * - win_probability: Chance the guess IS the answer (1/n if it is still valid).
+ * - histogram: The full bucket counts, indexed by pattern code.
+ */
+typedef struct _partition_stats
+{
+    const dictionary_entry_t* pEntry;
+    long long entropy_score;
+    double expected_remaining;
+    int max_bucket;
+    int bucket_count;
+    double win_probability;
+    int histogram[MAX_PATTERNS];
+} partition_stats_t;
+
+/*
+ * FUNCTION: calculate_partition_stats
+ *
+ * WHAT:
+ * The fused partition kernel: one pass over the valid answers fills the
+ * histogram, and one pass over the 243 buckets derives every statistic in
+ * `partition_stats_t` at once.
+ *
+ * WHY:
+ * The entropy loop only needs Sum( p * log(p) ), so it throws the histogram
+ * away. UIs and API clients want the richer picture (worst case, expected
+ * size, win chance) but only for a handful of top guesses, so this is
+ * computed on demand instead of inside the O(N^2) pass.
+ */
+void calculate_partition_stats(const dictionary_entry_t* pGuess, dictionary_entry_t** ppValidAnswers, int numValidAnswers, partition_stats_t* pStats);
+
+/*
+ * FUNCTION: bind_entropy_profile_buffer
+ *
+ * WHAT:
+ * Gives the calling thread a buffer of `entropy_profile_buffer_bytes(n)`
+ * bytes for the direct kernel's answer profiles, for passes over at most
+ * `n` answers. Pass NULL to unbind before freeing it.
+ *
+ * WHY:
+ * The direct kernel rebuilds the profiles on every pass. Game threads bind
+ * one with their working set so a decision does not touch the heap; an
+ * unbound thread (or a larger answer set) gets a temporary buffer instead.
+ */
+size_t entropy_profile_buffer_bytes(int answer_capacity);
+void bind_entropy_profile_buffer(void* p_buffer, int answer_capacity);
+
 /*
  * FUNCTION: calculate_entropy_on_dictionary
  *
@@ -40,7 +255,7 @@ void get_feedback_pattern(const char* guess, const char* answer, char* result_pa
  * (Standard Hard Mode scenario).
  *
  * WHY:
- * This updates the `entropy` field of each `dictionary_entry_t`. Higher entropy
+ * This updates the `entropy_score` field of each `dictionary_entry_t`. Higher entropy
  * means the word is statistically more likely to split the remaining possibilities
  * into smaller groups.
  */
@@ -62,4 +277,35 @@ void calculate_entropy_on_dictionary(dictionary_entry_t* pDictionary, int dictio
 void calculate_entropy_for_candidates(dictionary_entry_t* pCandidates, int candidateCount,
     dictionary_entry_t** ppValidAnswers, int validAnswerCount);
 
+/*
+ * CONSTANT: ENTROPY_DEADLINE_CHUNK
+ *
+ * WHAT:
+ * Candidates scored between two clock checks of
+ * `calculate_entropy_for_candidates_until`.
+ */
+#define ENTROPY_DEADLINE_CHUNK 256
+
+/*
+ * FUNCTION: calculate_entropy_for_candidates_until
+ *
+ * WHAT:
+ * `calculate_entropy_for_candidates` against a deadline (`omp_get_wtime()`
+ * seconds, 0 = none). Candidates that may still be the answer are always
+ * scored first; the eliminated ones follow in chunks of
+ * ENTROPY_DEADLINE_CHUNK, with the clock checked between chunks. Those
+ * still unscored at the deadline get a score of 0.
+ *
+ * WHY:
+ * At large vocabularies this pass is most of a decision, so a decision
+ * budget cannot be met unless it is bounded too. Scoring the possible
+ * answers first keeps a guess that can win available however little time
+ * is left.
+ *
+ * RETURNS:
+ * - false if the deadline cut the pass short.
+ */
+bool calculate_entropy_for_candidates_until(dictionary_entry_t* pCandidates, int candidateCount,
+    dictionary_entry_t** ppValidAnswers, int validAnswerCount, double deadline);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,141 @@
+/*
+ * FILE: game_snapshot.cpp
+ *
+ * WHAT:
+ * Implements the undo/redo snapshot stack for Interactive Mode.
+ *
+ * HOW:
+ * A snapshot is a flat copy of the working dictionary plus the two sorted
+ * pointer views. Because the views are restored into the same dictionary
+ * buffer they were taken from, the saved pointers stay valid and no view has
+ * to be re-sorted or any entropy recomputed.
+ *
+ * WHY:
+ * At ~6,500 words a snapshot is a few hundred KB, and a game has at most six
+ * of them: far cheaper than the O(N^2) entropy pass a restart would repeat.
+ */
+
+#include "game_snapshot.h"
+#include "memory_budget.h"
+#include "alloc_tracker.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * HELPER: snapshot_memory_id / snapshot_slot_bytes
+ */
+static int snapshot_memory_id()
+{
+    return register_memory_consumer("Undo snapshots", MEMORY_PRIORITY_REQUIRED, NULL, NULL, NULL);
+}
+static size_t snapshot_slot_bytes(const snapshot_stack_t* p_stack)
+{
+    return (sizeof(dictionary_entry_t) + 2 * sizeof(dictionary_entry_t*)) * (size_t)p_stack->entry_count;
+}
+
+/*
+ * FUNCTION: init_snapshot_stack
+ */
+void init_snapshot_stack(snapshot_stack_t* p_stack, int entry_count)
+{
+    memset(p_stack, 0, sizeof(snapshot_stack_t));
+    p_stack->entry_count = entry_count;
+}
+
+/*
+ * FUNCTION: push_snapshot
+ *
+ * WHAT:
+ * 1. Allocate the slot's buffers on first use (they are reused afterwards).
+ * 2. Copy entries, views and constraint state.
+ * 3. Advance the cursor and forget the undone branch.
+ */
+bool push_snapshot(snapshot_stack_t* p_stack,
+    const dictionary_entry_t* p_entries,
+    const dictionary_pointer_array_t p_view_entropy,
+    const dictionary_pointer_array_t p_view_rank,
+    int possible_count,
+    const int* min_required_counts,
+    const feedback_history_t* p_history,
+    const dictionary_entry_t* p_smart_pick)
+{
+    if (p_stack->depth >= MAX_SNAPSHOTS) return false;
+    turn_snapshot_t* p_snap = &p_stack->items[p_stack->depth];
+
+    // 1. Lazy allocation, sized for the whole dictionary
+    if (p_snap->p_entries == NULL)
+    {
+        p_snap->p_entries = (dictionary_entry_t*)tracked_malloc(sizeof(dictionary_entry_t) * p_stack->entry_count);
+        p_snap->p_view_entropy = (dictionary_entry_t**)tracked_malloc(sizeof(dictionary_entry_t*) * p_stack->entry_count);
+        p_snap->p_view_rank = (dictionary_entry_t**)tracked_malloc(sizeof(dictionary_entry_t*) * p_stack->entry_count);
+        if (!p_snap->p_entries || !p_snap->p_view_entropy || !p_snap->p_view_rank)
+        {
+            tracked_free(p_snap->p_entries); tracked_free(p_snap->p_view_entropy); tracked_free(p_snap->p_view_rank);
+            p_snap->p_entries = NULL; p_snap->p_view_entropy = NULL; p_snap->p_view_rank = NULL;
+            return false;
+        }
+        memory_budget_charge(snapshot_memory_id(), snapshot_slot_bytes(p_stack));
+    }
+
+    // 2. Copy state
+    memcpy(p_snap->p_entries, p_entries, sizeof(dictionary_entry_t) * p_stack->entry_count);
+    memcpy(p_snap->p_view_entropy, p_view_entropy, sizeof(dictionary_entry_t*) * possible_count);
+    memcpy(p_snap->p_view_rank, p_view_rank, sizeof(dictionary_entry_t*) * possible_count);
+    p_snap->view_count = possible_count;
+    p_snap->possible_count = possible_count;
+    memcpy(p_snap->min_required_counts, min_required_counts, sizeof(p_snap->min_required_counts));
+    p_snap->history = *p_history;
+    p_snap->p_smart_pick = p_smart_pick;
+
+    // 3. New branch: nothing left to redo
+    p_stack->depth++;
+    p_stack->redo_depth = p_stack->depth;
+    return true;
+}
+
+/*
+ * FUNCTION: restore_snapshot
+ */
+bool restore_snapshot(snapshot_stack_t* p_stack, int index,
+    dictionary_entry_t* p_entries,
+    dictionary_pointer_array_t* pp_view_entropy,
+    dictionary_pointer_array_t* pp_view_rank,
+    int* p_possible_count,
+    int* min_required_counts,
+    feedback_history_t* p_history)
+{
+    if (index < 0 || index >= p_stack->redo_depth) return false;
+    const turn_snapshot_t* p_snap = &p_stack->items[index];
+
+    dictionary_entry_t** p_new_entropy = (dictionary_entry_t**)tracked_malloc(sizeof(dictionary_entry_t*) * p_snap->view_count);
+    dictionary_entry_t** p_new_rank = (dictionary_entry_t**)tracked_malloc(sizeof(dictionary_entry_t*) * p_snap->view_count);
+    if (!p_new_entropy || !p_new_rank) { tracked_free(p_new_entropy); tracked_free(p_new_rank); return false; }
+
+    memcpy(p_entries, p_snap->p_entries, sizeof(dictionary_entry_t) * p_stack->entry_count);
+    memcpy(p_new_entropy, p_snap->p_view_entropy, sizeof(dictionary_entry_t*) * p_snap->view_count);
+    memcpy(p_new_rank, p_snap->p_view_rank, sizeof(dictionary_entry_t*) * p_snap->view_count);
+
+    tracked_free(*pp_view_entropy); *pp_view_entropy = p_new_entropy;
+    tracked_free(*pp_view_rank); *pp_view_rank = p_new_rank;
+
+    *p_possible_count = p_snap->possible_count;
+    memcpy(min_required_counts, p_snap->min_required_counts, sizeof(p_snap->min_required_counts));
+    *p_history = p_snap->history;
+    p_stack->depth = index + 1;
+    return true;
+}
+
+/*
+ * FUNCTION: free_snapshot_stack
+ */
+void free_snapshot_stack(snapshot_stack_t* p_stack)
+{
+    for (int i = 0; i < MAX_SNAPSHOTS; i++)
+    {
+        if (p_stack->items[i].p_entries != NULL) memory_budget_release(snapshot_memory_id(), snapshot_slot_bytes(p_stack));
+        tracked_free(p_stack->items[i].p_entries);
+        tracked_free(p_stack->items[i].p_view_entropy);
+        tracked_free(p_stack->items[i].p_view_rank);
+    }
+    memset(p_stack, 0, sizeof(snapshot_stack_t));
+}
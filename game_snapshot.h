@@ -0,0 +1,133 @@
+/*
+ * FILE: game_snapshot.h
+ *
+ * WHAT:
+ * Defines the interface for Interactive Mode's undo/redo history. At the
+ * start of every turn the complete solver state is saved into a snapshot:
+ * - The working dictionary (elimination flags, entropy, mismatch counters).
+ * - The sorted Entropy and Rank views.
+ * - The letter minimums and the feedback history.
+ * - The bot's recommendation for that turn.
+ *
+ * WHY:
+ * One wrong guess or pattern used to mean restarting the program: reloading
+ * `AllWords.txt` and repeating the O(N^2) opener entropy pass. Restoring a
+ * snapshot is a few `memcpy` calls, so the user can step back, try a
+ * different guess or pattern ("what-if" branch), and step forward again
+ * without recomputing anything.
+ */
+
+#pragma once
+#ifndef GAME_SNAPSHOT_H
+#define GAME_SNAPSHOT_H
+#include "wordle_types.h"
+#include "noise_filter.h"
+
+/*
+ * CONSTANT: MAX_SNAPSHOTS
+ *
+ * WHAT:
+ * One snapshot per turn start (a game has at most 6 turns).
+ */
+#define MAX_SNAPSHOTS FEEDBACK_HISTORY_TURNS
+
+/*
+ * STRUCT: turn_snapshot_t
+ *
+ * WHAT:
+ * The solver state at the start of one turn.
+ *
+ * FIELDS:
+ * - p_entries: Copy of the whole working dictionary (`entry_count` entries).
+ * - p_view_entropy / p_view_rank: Copies of the sorted views (`view_count`
+ * pointers). They point into the LIVE working dictionary, which is why a
+ * snapshot must be restored into the same buffer it was taken from.
+ * - possible_count: The active word count (shrinks in Hard Mode).
+ * - min_required_counts / history: Constraint state.
+ * - p_smart_pick: The bot's recommendation (also into the live buffer).
+ */
+typedef struct _turn_snapshot
+{
+    dictionary_entry_t* p_entries;
+    dictionary_entry_t** p_view_entropy;
+    dictionary_entry_t** p_view_rank;
+    int view_count;
+    int possible_count;
+    int min_required_counts[26];
+    feedback_history_t history;
+    const dictionary_entry_t* p_smart_pick;
+} turn_snapshot_t;
+
+/*
+ * STRUCT: snapshot_stack_t
+ *
+ * WHAT:
+ * A browser-style history: snapshots [0, depth) are the turns played so far,
+ * snapshots [depth, redo_depth) are turns that were undone and can be redone.
+ * Taking a new snapshot discards the redo part (a new branch).
+ *
+ * WHY:
+ * Buffers are allocated once per slot and reused, so stepping back and forth
+ * never allocates.
+ */
+typedef struct _snapshot_stack
+{
+    turn_snapshot_t items[MAX_SNAPSHOTS];
+    int depth;
+    int redo_depth;
+    int entry_count;
+} snapshot_stack_t;
+
+/*
+ * FUNCTION: init_snapshot_stack
+ *
+ * WHAT:
+ * Prepares an empty stack for a working dictionary of `entry_count` entries.
+ */
+void init_snapshot_stack(snapshot_stack_t* p_stack, int entry_count);
+
+/*
+ * FUNCTION: push_snapshot
+ *
+ * WHAT:
+ * Saves the current state as the start of the next turn and drops any
+ * redo-able snapshots.
+ *
+ * RETURNS:
+ * - false if the stack is full or memory allocation fails (the game still
+ * works, only this turn cannot be undone to).
+ */
+bool push_snapshot(snapshot_stack_t* p_stack,
+    const dictionary_entry_t* p_entries,
+    const dictionary_pointer_array_t p_view_entropy,
+    const dictionary_pointer_array_t p_view_rank,
+    int possible_count,
+    const int* min_required_counts,
+    const feedback_history_t* p_history,
+    const dictionary_entry_t* p_smart_pick);
+
+/*
+ * FUNCTION: restore_snapshot
+ *
+ * WHAT:
+ * Copies snapshot `index` back into the live state and makes it the
+ * current turn's start (`depth` = index + 1; later snapshots stay
+ * redo-able). The view arrays are reallocated to the snapshot's size.
+ *
+ * RETURNS:
+ * - false if `index` is not a saved snapshot or memory allocation fails.
+ */
+bool restore_snapshot(snapshot_stack_t* p_stack, int index,
+    dictionary_entry_t* p_entries,
+    dictionary_pointer_array_t* pp_view_entropy,
+    dictionary_pointer_array_t* pp_view_rank,
+    int* p_possible_count,
+    int* min_required_counts,
+    feedback_history_t* p_history);
+
+/*
+ * FUNCTION: free_snapshot_stack
+ */
+void free_snapshot_stack(snapshot_stack_t* p_stack);
+
+#endif
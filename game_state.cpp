@@ -0,0 +1,79 @@
+/*
+ * FILE: game_state.cpp
+ *
+ * WHAT:
+ * Implements the Zobrist candidate-set hash.
+ */
+
+#include "game_state.h"
+
+/*
+ * FUNCTION: word_zobrist_key
+ *
+ * WHAT:
+ * 1. Pack the letters (5 bits each, 25 bits total). Distinct words give
+ * distinct inputs.
+ * 2. SplitMix64 finalizer: spreads those 25 bits over all 64.
+ */
+unsigned long long word_zobrist_key(const char* word)
+{
+    // 1. Pack
+    unsigned long long x = 0;
+    for (int i = 0; i < WORDLE_WORD_LENGTH; i++)
+    {
+        x = (x << 5) | (unsigned long long)((word[i] - 'A') & 31);
+    }
+
+    // 2. Mix
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+/*
+ * FUNCTION: compute_candidate_set_hash
+ */
+unsigned long long compute_candidate_set_hash(const dictionary_entry_t* p_dictionary, int count)
+{
+    unsigned long long hash = 0;
+    for (int i = 0; i < count; i++)
+    {
+        if (!p_dictionary[i].is_eliminated) hash ^= word_zobrist_key(p_dictionary[i].word);
+    }
+    return hash;
+}
+
+/*
+ * FUNCTION: init_game_state
+ */
+void init_game_state(game_state_t* p_state, const dictionary_entry_t* p_dictionary, int count)
+{
+    p_state->candidate_hash = 0;
+    p_state->candidate_count = 0;
+    for (int i = 0; i < count; i++)
+    {
+        if (p_dictionary[i].is_eliminated) continue;
+        p_state->candidate_hash ^= word_zobrist_key(p_dictionary[i].word);
+        p_state->candidate_count++;
+    }
+}
+
+/*
+ * FUNCTION: game_state_eliminate
+ */
+void game_state_eliminate(game_state_t* p_state, const dictionary_entry_t* pEntry)
+{
+    p_state->candidate_hash ^= word_zobrist_key(pEntry->word);
+    p_state->candidate_count--;
+}
+
+/*
+ * FUNCTION: verify_game_state
+ */
+bool verify_game_state(const game_state_t* p_state, const dictionary_entry_t* p_dictionary, int count)
+{
+    game_state_t full;
+    init_game_state(&full, p_dictionary, count);
+    return full.candidate_hash == p_state->candidate_hash && full.candidate_count == p_state->candidate_count;
+}
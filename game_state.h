@@ -0,0 +1,89 @@
+/*
+ * FILE: game_state.h
+ *
+ * WHAT:
+ * Defines `game_state_t`, the identity of a position in a game: which
+ * candidate answers are still alive. The candidate set is summarized as a
+ * 64-bit Zobrist hash: every word has a fixed random key, and the set hash
+ * is the XOR of the keys of all non-eliminated words.
+ *
+ * WHY:
+ * Any memo over positions (turn decisions, shared caches, tablebases) needs
+ * a key for the candidate set. Rehashing a 6,500-entry set per lookup costs
+ * as much as the filter pass itself. With XOR keys, eliminating a word is one
+ * XOR, so the filter keeps the hash current for free while it runs.
+ */
+
+#pragma once
+#ifndef GAME_STATE_H
+#define GAME_STATE_H
+#include "wordle_types.h"
+
+/*
+ * STRUCT: game_state_t
+ *
+ * FIELDS:
+ * - candidate_hash: XOR of `word_zobrist_key` over the non-eliminated words.
+ * - candidate_count: Number of non-eliminated words.
+ *
+ * WHY:
+ * Two positions with the same candidate set get the same hash no matter which
+ * guesses led there, so transpositions share memo entries.
+ */
+typedef struct _game_state
+{
+    unsigned long long candidate_hash;
+    int candidate_count;
+} game_state_t;
+
+/*
+ * FUNCTION: word_zobrist_key
+ *
+ * WHAT:
+ * The word's 64-bit key: the 5 letters packed into an integer and mixed with
+ * SplitMix64.
+ *
+ * WHY:
+ * Derived from the word itself rather than from a random table indexed by
+ * dictionary position, so keys agree across dictionary copies, filtered
+ * dictionaries and separate runs (needed for anything persisted or shared).
+ */
+unsigned long long word_zobrist_key(const char* word);
+
+/*
+ * FUNCTION: compute_candidate_set_hash
+ *
+ * WHAT:
+ * The canonical full hash: XOR of the keys of every non-eliminated entry.
+ *
+ * WHY:
+ * The reference the incremental hash is verified against, and the way to
+ * (re)initialize a state after a bulk change such as a tolerant re-filter.
+ */
+unsigned long long compute_candidate_set_hash(const dictionary_entry_t* p_dictionary, int count);
+
+/*
+ * FUNCTION: init_game_state
+ *
+ * WHAT:
+ * Sets the hash and count from the dictionary's current elimination flags.
+ */
+void init_game_state(game_state_t* p_state, const dictionary_entry_t* p_dictionary, int count);
+
+/*
+ * FUNCTION: game_state_eliminate
+ *
+ * WHAT:
+ * Removes one word from the state (call when its `is_eliminated` goes true).
+ */
+void game_state_eliminate(game_state_t* p_state, const dictionary_entry_t* pEntry);
+
+/*
+ * FUNCTION: verify_game_state
+ *
+ * WHAT:
+ * true if the incremental state matches a full recount of the dictionary.
+ */
+bool verify_game_state(const game_state_t* p_state, const dictionary_entry_t* p_dictionary, int count);
+
+#endif
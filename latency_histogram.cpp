@@ -0,0 +1,171 @@
+/*
+ * FILE: latency_histogram.cpp
+ *
+ * WHAT:
+ * Implements the Decision Latency histograms: bucket mapping, recording,
+ * merging, percentiles and the report table.
+ */
+
+#include "latency_histogram.h"
+#include "platform_compat.h"
+#include <stdio.h>
+#include <math.h>
+
+/*
+ * HELPER: get_bucket_index
+ *
+ * WHAT:
+ * Maps microseconds to a bucket. Below LATENCY_SUB_BUCKETS the value is its
+ * own bucket; above, the top LATENCY_SUB_BUCKET_BITS + 1 bits select one of
+ * the 32 buckets of its power of two.
+ */
+static int get_bucket_index(long long value_us)
+{
+    if (value_us < LATENCY_SUB_BUCKETS) return (int)value_us;
+    if (value_us >= (1LL << (LATENCY_MAX_EXPONENT + 1))) return LATENCY_BUCKETS - 1;
+
+    int msb = 0;
+    while ((value_us >> (msb + 1)) != 0) msb++;
+    int shift = msb - LATENCY_SUB_BUCKET_BITS;
+    int sub = (int)(value_us >> shift) - LATENCY_SUB_BUCKETS;
+    return LATENCY_SUB_BUCKETS + shift * LATENCY_SUB_BUCKETS + sub;
+}
+
+/*
+ * HELPER: get_bucket_upper_us
+ *
+ * WHAT:
+ * The largest value that maps to bucket `index`.
+ */
+static long long get_bucket_upper_us(int index)
+{
+    if (index < LATENCY_SUB_BUCKETS) return index;
+    int shift = (index - LATENCY_SUB_BUCKETS) / LATENCY_SUB_BUCKETS;
+    long long sub = LATENCY_SUB_BUCKETS + (index - LATENCY_SUB_BUCKETS) % LATENCY_SUB_BUCKETS;
+    return ((sub + 1) << shift) - 1;
+}
+
+/*
+ * HELPER: get_size_class
+ */
+static int get_size_class(int valid_count)
+{
+    if (valid_count <= 2) return 0;
+    if (valid_count <= 20) return 1;
+    if (valid_count <= 200) return 2;
+    if (valid_count <= 2000) return 3;
+    return 4;
+}
+
+static void add_to_histogram(latency_histogram_t* p_histogram, long long value_us, bool is_over_slo)
+{
+    p_histogram->counts[get_bucket_index(value_us)]++;
+    p_histogram->total++;
+    if (is_over_slo) p_histogram->over_slo++;
+    if (value_us > p_histogram->max_us) p_histogram->max_us = value_us;
+}
+
+static void merge_histogram(latency_histogram_t* p_histogram, const latency_histogram_t* p_other)
+{
+    for (int i = 0; i < LATENCY_BUCKETS; i++) p_histogram->counts[i] += p_other->counts[i];
+    p_histogram->total += p_other->total;
+    p_histogram->over_slo += p_other->over_slo;
+    if (p_other->max_us > p_histogram->max_us) p_histogram->max_us = p_other->max_us;
+}
+
+/*
+ * FUNCTION: record_decision_latency
+ */
+void record_decision_latency(decision_latency_t* p_latency, int turn, int valid_count, double elapsed_ms)
+{
+    long long value_us = (elapsed_ms > 0.0) ? llround(elapsed_ms * 1000.0) : 0;
+    bool is_over_slo = (g_latency_slo_ms > 0.0 && elapsed_ms > g_latency_slo_ms);
+
+    add_to_histogram(&p_latency->all, value_us, is_over_slo);
+    if (turn >= 1 && turn < LATENCY_TURN_SLOTS) add_to_histogram(&p_latency->by_turn[turn], value_us, is_over_slo);
+    add_to_histogram(&p_latency->by_size[get_size_class(valid_count)], value_us, is_over_slo);
+}
+
+/*
+ * FUNCTION: merge_decision_latency
+ */
+void merge_decision_latency(decision_latency_t* p_latency, const decision_latency_t* p_other)
+{
+    merge_histogram(&p_latency->all, &p_other->all);
+    for (int t = 0; t < LATENCY_TURN_SLOTS; t++) merge_histogram(&p_latency->by_turn[t], &p_other->by_turn[t]);
+    for (int s = 0; s < LATENCY_SIZE_CLASSES; s++) merge_histogram(&p_latency->by_size[s], &p_other->by_size[s]);
+}
+
+/*
+ * FUNCTION: get_latency_percentile_ms
+ */
+double get_latency_percentile_ms(const latency_histogram_t* p_histogram, double percentile)
+{
+    if (p_histogram->total == 0) return 0.0;
+
+    // Rank of the decision at this percentile (1-based, at least the first)
+    long long rank = (long long)ceil(percentile / 100.0 * (double)p_histogram->total);
+    if (rank < 1) rank = 1;
+
+    long long seen = 0;
+    for (int i = 0; i < LATENCY_BUCKETS; i++)
+    {
+        seen += p_histogram->counts[i];
+        if (seen >= rank)
+        {
+            long long upper_us = get_bucket_upper_us(i);
+            if (upper_us > p_histogram->max_us) upper_us = p_histogram->max_us;
+            return (double)upper_us / 1000.0;
+        }
+    }
+    return (double)p_histogram->max_us / 1000.0;
+}
+
+/*
+ * HELPER: print_latency_row
+ */
+static void print_latency_row(const char* label, const latency_histogram_t* p_histogram)
+{
+    if (p_histogram->total == 0) return;
+    printf("| %-16s | %8lld | %9.2f | %9.2f | %9.2f | %9.2f |",
+        label,
+        p_histogram->total,
+        get_latency_percentile_ms(p_histogram, 50.0),
+        get_latency_percentile_ms(p_histogram, 90.0),
+        get_latency_percentile_ms(p_histogram, 99.0),
+        (double)p_histogram->max_us / 1000.0);
+    if (g_latency_slo_ms > 0.0) printf(" %8lld |", p_histogram->over_slo);
+    printf("\n");
+}
+
+/*
+ * FUNCTION: print_decision_latency_report
+ */
+void print_decision_latency_report(const decision_latency_t* p_latency, const char* title)
+{
+    static const char* SIZE_CLASS_LABELS[LATENCY_SIZE_CLASSES] = { "1-2 answers", "3-20 answers", "21-200 answers", "201-2000 answers", "2001+ answers" };
+
+    printf("\n--- Decision Latency: %s ---\n", title);
+    if (p_latency->all.total == 0) { printf("    No decisions recorded.\n"); return; }
+
+    printf("| %-16s | %-8s | %-9s | %-9s | %-9s | %-9s |", "DECISIONS", "COUNT", "P50 (ms)", "P90 (ms)", "P99 (ms)", "MAX (ms)");
+    if (g_latency_slo_ms > 0.0) printf(" %-8s |", "OVER SLO");
+    printf("\n");
+    print_latency_row("All", &p_latency->all);
+
+    char label[32];
+    for (int t = 1; t < LATENCY_TURN_SLOTS; t++)
+    {
+        sprintf_s(label, sizeof(label), "Guess %d", t);
+        print_latency_row(label, &p_latency->by_turn[t]);
+    }
+    for (int s = 0; s < LATENCY_SIZE_CLASSES; s++) print_latency_row(SIZE_CLASS_LABELS[s], &p_latency->by_size[s]);
+
+    if (g_latency_slo_ms <= 0.0) return;
+
+    double p99_ms = get_latency_percentile_ms(&p_latency->all, 99.0);
+    bool is_met = (p99_ms <= g_latency_slo_ms);
+    printf("SLO: p99 %.2f ms %s %.2f ms: %s (%lld of %lld decisions slower, %.2f%%)\n",
+        p99_ms, is_met ? "<=" : ">", g_latency_slo_ms, is_met ? "MET" : "MISSED",
+        p_latency->all.over_slo, p_latency->all.total, 100.0 * p_latency->all.over_slo / p_latency->all.total);
+}
@@ -0,0 +1,129 @@
+/*
+ * FILE: latency_histogram.h
+ *
+ * WHAT:
+ * Defines the Decision Latency histograms: how long each recommendation
+ * took, recorded per decision and reported as p50/p90/p99/max, overall, per
+ * turn and per candidate-set size.
+ *
+ * A recommendation is timed from the moment the feedback is known until
+ * the next guess is chosen: filtering, the entropy pass, the sorted views
+ * and the smart decision (or the memo/cache hit that replaced them). In
+ * interactive play the timer also covers printing the recommendation
+ * tables, and stops before the prompt waits for the user.
+ *
+ * WHY:
+ * Averages hide the turns that users notice. The slow decisions are the
+ * early turns with thousands of candidates, and a single p99 number per
+ * size class is what a latency budget (`--decision-budget-ms`) or an SLO
+ * (`--latency-slo-ms`) has to be set against.
+ *
+ * HOW:
+ * HDR-style log-linear buckets over microseconds: values below 32 us get a
+ * bucket each, every power of two above is split into 32 equal buckets.
+ * Any reported percentile is within about 3% of the true value, at a fixed
+ * 7 KB per histogram and one increment per decision.
+ */
+
+#pragma once
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+/*
+ * CONSTANTS: Histogram Layout
+ *
+ * WHAT:
+ * - LATENCY_SUB_BUCKET_BITS: 2^5 = 32 buckets per power of two.
+ * - LATENCY_MAX_EXPONENT: Values up to 2^31 us (about 36 minutes); larger
+ * ones land in the last bucket (the exact maximum is kept separately).
+ */
+#define LATENCY_SUB_BUCKET_BITS 5
+#define LATENCY_SUB_BUCKETS (1 << LATENCY_SUB_BUCKET_BITS)
+#define LATENCY_MAX_EXPONENT 31
+#define LATENCY_BUCKETS (LATENCY_SUB_BUCKETS * (LATENCY_MAX_EXPONENT - LATENCY_SUB_BUCKET_BITS + 2))
+
+/*
+ * CONSTANTS: Breakdown
+ *
+ * WHAT:
+ * - LATENCY_TURN_SLOTS: Guess numbers 1-6 (slot 0 unused).
+ * - LATENCY_SIZE_CLASSES: Valid answers at decision time, in decades:
+ * 1-2, 3-20, 21-200, 201-2000 and more.
+ */
+#define LATENCY_TURN_SLOTS 7
+#define LATENCY_SIZE_CLASSES 5
+
+/*
+ * STRUCT: latency_histogram_t
+ *
+ * FIELDS:
+ * - counts: Decisions per bucket.
+ * - total: Decisions recorded.
+ * - over_slo: Decisions slower than `g_latency_slo_ms` (exact, not bucketed).
+ * - max_us: Slowest decision.
+ */
+typedef struct _latency_histogram
+{
+    long long counts[LATENCY_BUCKETS];
+    long long total;
+    long long over_slo;
+    long long max_us;
+} latency_histogram_t;
+
+/*
+ * STRUCT: decision_latency_t
+ *
+ * WHAT:
+ * One run's decisions. All-zero is an empty set, so calloc is enough to
+ * create one; use one per thread and merge them at the end.
+ */
+typedef struct _decision_latency
+{
+    latency_histogram_t all;
+    latency_histogram_t by_turn[LATENCY_TURN_SLOTS];
+    latency_histogram_t by_size[LATENCY_SIZE_CLASSES];
+} decision_latency_t;
+
+/*
+ * GLOBAL: g_latency_slo_ms
+ *
+ * WHAT:
+ * The recommendation latency objective (`--latency-slo-ms=N`), or 0 (none).
+ * The reports count the decisions above it and check p99 against it.
+ */
+extern double g_latency_slo_ms;
+
+/*
+ * FUNCTION: record_decision_latency
+ *
+ * WHAT:
+ * Adds one decision: the guess number it chose, the valid answers it chose
+ * from, and how long it took. Not thread-safe (see decision_latency_t).
+ */
+void record_decision_latency(decision_latency_t* p_latency, int turn, int valid_count, double elapsed_ms);
+
+/*
+ * FUNCTION: merge_decision_latency
+ */
+void merge_decision_latency(decision_latency_t* p_latency, const decision_latency_t* p_other);
+
+/*
+ * FUNCTION: get_latency_percentile_ms
+ *
+ * WHAT:
+ * The latency that `percentile` percent (0-100) of the decisions did not
+ * exceed: the upper edge of the bucket holding that rank, capped at the
+ * maximum. 0 for an empty histogram.
+ */
+double get_latency_percentile_ms(const latency_histogram_t* p_histogram, double percentile);
+
+/*
+ * FUNCTION: print_decision_latency_report
+ *
+ * WHAT:
+ * Prints the p50/p90/p99/max table under `title`, with the SLO verdict
+ * (overall p99 against `g_latency_slo_ms`) when one is set.
+ */
+void print_decision_latency_report(const decision_latency_t* p_latency, const char* title);
+
+#endif
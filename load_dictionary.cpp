@@ -25,6 +25,7 @@
 #include <string.h>
 #include <ctype.h>
 #include "entropy_calculator.h"
+#include "alloc_tracker.h"
 
  /*
   * FUNCTION: trim
@@ -85,17 +86,136 @@ bool contains_duplicate_letter(const char* word)
     return false;
 }
 
+/*
+ * FUNCTION: parse_dictionary_line
+ *
+ * WHAT:
+ * Parses one fixed-width `AllWords.txt` line (e.g., "CAKES095PS") into a
+ * `dictionary_entry_t`:
+ * - Word (Offsets 0-4), normalized to uppercase.
+ * - Rank (Offsets 5-7).
+ * - Noun / Verb tags (Offsets 8 and 9).
+ * - Derived metadata (duplicate letters), game state reset.
+ *
+ * RETURNS:
+ * - false if the line is too short to hold all fields.
+ *
+ * WHY:
+ * Shared by the file loader and the incremental mutation API, so a word added
+ * at runtime gets exactly the same fields as one read from disk.
+ */
+bool parse_dictionary_line(const char* line, dictionary_entry_t* pEntry)
+{
+    if (strlen(line) < 10) return false;
+
+    // Parse Word (Offsets 0-4)
+    for (int i = 0; i < WORDLE_WORD_LENGTH; i++)
+    {
+        pEntry->word[i] = toupper((unsigned char)(*(line + i)));
+    }
+    pEntry->word[WORDLE_WORD_LENGTH] = '\0';
+
+    // Parse Rank (Offsets 5-7)
+    char rankStr[4];
+    memcpy(rankStr, line + 5, 3);
+    rankStr[3] = '\0';
+    pEntry->frequency_rank = atoi(rankStr);
+
+    // Parse Tags (Offsets 8 and 9)
+    pEntry->noun_type = line[8];
+    pEntry->verb_type = line[9];
+
+    // Pre-calculate Metadata
+    pEntry->contains_duplicate_letters = contains_duplicate_letter(pEntry->word);
+    pEntry->entropy_score = 0;     // Will be calculated shortly
+    pEntry->is_eliminated = false; // Default state: Valid
+    pEntry->feedback_mismatches = 0;
+    pEntry->dictionary_index = -1;
+    return true;
+}
+
+/*
+ * FUNCTION: read_dictionary_file
+ *
+ * WHAT:
+ * 1. Allocates the dictionary array (it doubles as needed, so any size loads).
+ * 2. Opens the master "AllWords.txt" file (or `--dictionary=path`).
+ * 3. Parses every valid line (no history filter, no entropy).
+ *
+ * WHY:
+ * The raw parse is the part of loading that does not depend on the used
+ * word list, so the startup pipeline can run it while the list is still
+ * being downloaded.
+ */
+bool read_dictionary_file(dictionary_entry_t** pp_dictionary, int* p_dictionary_count)
+{
+    FILE* fpIn;
+    errno_t errval;
+    char buffer[100];
+    *p_dictionary_count = 0;
+    int capacity = MAX_DICTIONARY_WORDS;
+
+    // Allocate the Master Dictionary Array
+    *pp_dictionary = (dictionary_entry_t*)tracked_malloc(sizeof(dictionary_entry_t) * capacity);
+    if (*pp_dictionary == NULL)
+    {
+        fprintf(stderr, "Out of memory allocating dictionary!\n");
+        return false;
+    }
+
+    // Open the Master Data File (Hardcoded path for this environment, unless overridden)
+    const char* path = (g_dictionary_path != NULL) ? g_dictionary_path : DEFAULT_DICTIONARY_PATH;
+    errval = fopen_s(&fpIn, path, "r");
+
+    if (fpIn == NULL || errval != 0)
+    {
+        fprintf(stderr, "Could not open consolidated dictionary file (%s)! Check the path.\n", path);
+        tracked_free(*pp_dictionary);
+        *pp_dictionary = NULL;
+        return false;
+    }
+
+    // Parse the File Line by Line
+    while (fgets(buffer, sizeof(buffer), fpIn) != NULL)
+    {
+        trim(buffer);
+
+        // Grow by doubling (synthetic dictionaries can hold 100k+ words)
+        if (*p_dictionary_count == capacity)
+        {
+            dictionary_entry_t* p_grown = (dictionary_entry_t*)tracked_realloc(*pp_dictionary, sizeof(dictionary_entry_t) * capacity * 2);
+            if (p_grown == NULL)
+            {
+                fprintf(stderr, "Out of memory growing dictionary past %d words!\n", capacity);
+                break;
+            }
+            *pp_dictionary = p_grown;
+            capacity *= 2;
+        }
+
+        // Parse the fixed-width fields into the next free slot in our array
+        // (lines shorter than Word + Rank + Tags are skipped)
+        dictionary_entry_t* pEntry = (*pp_dictionary) + (*p_dictionary_count);
+        if (parse_dictionary_line(buffer, pEntry)) (*p_dictionary_count)++;
+    }
+
+    fclose(fpIn);
+    return true;
+}
+
 /*
  * FUNCTION: load_dictionary
  *
  * WHAT:
  * The main data loader.
  * 1. Loads the list of "Used Words" (past Wordle answers) IF requested.
- * 2. Opens the master "AllWords.txt" file.
- * 3. Iterates through every line:
- * - Skips words found in the "Used Words" list (if filtering is on).
- * - Parses the Word, Rank, and Linguistic Tags.
- * - Pre-calculates metadata (duplicates, initial entropy).
+ * 2. Reads and parses the master "AllWords.txt" file.
+ * 3. Removes words found in the "Used Words" list (if filtering is on).
+ * 4. Pre-calculates the initial entropy.
+ *
+ * NOTE:
+ * This is the sequential loader. `main` uses the startup pipeline
+ * (startup_pipeline.h), which overlaps the same steps.
  *
  * PARAMETERS:
  * - pp_dictionary: Output parameter. Will point to the newly allocated array.
@@ -125,96 +245,48 @@ bool load_dictionary(dictionary_entry_t** pp_dictionary, int* p_dictionary_count
         }
     }
 
-    char* pTmp = g_p_used_words;
-    FILE* fpIn;
-    errno_t errval;
-    char buffer[100];
-    *p_dictionary_count = 0;
-    int total_loaded_words = 0;
-
-    // Pointers for linear scan filtering
-    char* pNextSortedUsedWord = g_p_used_words;
-    int numLeftInUsedWords = g_used_word_count;
-
-    // Allocate the Master Dictionary Array
-    *pp_dictionary = (dictionary_entry_t*)malloc(sizeof(dictionary_entry_t) * MAX_DICTIONARY_WORDS);
-    if (pp_dictionary == NULL)
-    {
-        fprintf(stderr, "Out of memory allocating dictionary!\n");
-        return false;
-    }
+    // 2. Read and parse the file
+    if (!read_dictionary_file(pp_dictionary, p_dictionary_count)) return false;
+    int total_loaded_words = *p_dictionary_count;
 
-    // Open the Master Data File (Hardcoded path for this environment)
-    errval = fopen_s(&fpIn, "C:\\VS2022.Projects\\StuffForWordle\\WordleWordsCSVs\\AllWords.txt", "r");
-
-    if (fpIn == NULL || errval != 0)
-    {
-        fprintf(stderr, "Could not open consolidated dictionary file (AllWords.txt)! Check the hardcoded path.\n");
-        free(*pp_dictionary);
-        return false;
-    }
-
-    // 2. Parse the File Line by Line
-    while (fgets(buffer, sizeof(buffer), fpIn) != NULL && *p_dictionary_count < MAX_DICTIONARY_WORDS)
+    // 3. Filter: Both lists are alphabetical, so a single merge scan finds
+    // every used word. Kept words are compacted in place.
+    if (should_filter_history)
     {
-        trim(buffer);
-
-        // Ensure line has minimal expected length (Word + Rank + Tags)
-        if (strlen(buffer) >= 10)
+        char* pNextSortedUsedWord = g_p_used_words;
+        int numLeftInUsedWords = g_used_word_count;
+        int kept = 0;
+        for (int i = 0; i < total_loaded_words; i++)
         {
-            total_loaded_words++;
-
-            // Filter: Check if this word is in the Used Words list.
-            // We only perform this check if the flag is set AND we have words left to check.
-            if (should_filter_history && numLeftInUsedWords > 0 && strncmp(buffer, pNextSortedUsedWord, WORDLE_WORD_LENGTH) == 0)
+            dictionary_entry_t* pEntry = (*pp_dictionary) + i;
+            while (numLeftInUsedWords > 0 && strncmp(pNextSortedUsedWord, pEntry->word, WORDLE_WORD_LENGTH) < 0)
             {
+                // Used word not in the dictionary: skip it
                 pNextSortedUsedWord += WORDLE_WORD_LENGTH;
                 numLeftInUsedWords--;
-                continue; // Skip this word, it has already been used.
             }
-
-            // Get pointer to the next free slot in our array
-            dictionary_entry_t* pEntry = (*pp_dictionary) + (*p_dictionary_count);
-
-            // Parse Word (Offsets 0-4)
-            for (int i = 0; i < WORDLE_WORD_LENGTH; i++)
+            if (numLeftInUsedWords > 0 && strncmp(pNextSortedUsedWord, pEntry->word, WORDLE_WORD_LENGTH) == 0)
             {
-                pEntry->word[i] = toupper((unsigned char)(*(buffer + i)));
+                pNextSortedUsedWord += WORDLE_WORD_LENGTH;
+                numLeftInUsedWords--;
+                continue; // Skip this word, it has already been used.
             }
-            pEntry->word[WORDLE_WORD_LENGTH] = '\0';
-
-            // Parse Rank (Offsets 5-7)
-            char rankStr[4];
-            memcpy(rankStr, buffer + 5, 3);
-            rankStr[3] = '\0';
-            pEntry->frequency_rank = atoi(rankStr);
-
-            // Parse Tags (Offsets 8 and 9)
-            pEntry->noun_type = buffer[8];
-            pEntry->verb_type = buffer[9];
-
-            // Pre-calculate Metadata
-            pEntry->contains_duplicate_letters = contains_duplicate_letter(pEntry->word);
-            pEntry->entropy = 0.0;         // Will be calculated shortly
-            pEntry->is_eliminated = false; // Default state: Valid
-
-            (*p_dictionary_count)++;
+            (*pp_dictionary)[kept++] = *pEntry;
         }
+        *p_dictionary_count = kept;
     }
 
-    fclose(fpIn);
-
     printf("Loaded %d words from the new consolidated dictionary.\n", *p_dictionary_count);
     if (should_filter_history)
     {
-        printf("Filtered out %d used words from %d loaded.  Did not find %d used words.\n", g_used_word_count, total_loaded_words, numLeftInUsedWords);
+        printf("Filtered out %d used words from %d loaded.  Did not find %d used words.\n", total_loaded_words - *p_dictionary_count, total_loaded_words, g_used_word_count - (total_loaded_words - *p_dictionary_count));
     }
     else
     {
         printf("History Filter DISABLED. All %d words are active.\n", total_loaded_words);
     }
 
-    // 3. Initial Entropy Calculation
+    // 4. Initial Entropy Calculation
     // This is expensive! We do it once at startup so we don't have to do it
     // for the very first turn of every game.
     printf("Calculating entropy for each word in the dictionary...");
@@ -18,6 +18,29 @@
 #include "wordle_types.h"
 #include "load_used_words.h"
 
+/*
+ * CONSTANT: DEFAULT_DICTIONARY_PATH
+ *
+ * WHAT:
+ * Where the dictionary is read from without `--dictionary=path`: the
+ * original developer path on Windows, the working directory elsewhere
+ * (the CMake build copies `AllWords.txt` next to the executable).
+ */
+#ifdef _WIN32
+#define DEFAULT_DICTIONARY_PATH "C:\\VS2022.Projects\\StuffForWordle\\WordleWordsCSVs\\AllWords.txt"
+#else
+#define DEFAULT_DICTIONARY_PATH "AllWords.txt"
+#endif
+
+/*
+ * GLOBAL: g_dictionary_path
+ *
+ * WHAT:
+ * The dictionary file to read instead of the built-in `AllWords.txt` path
+ * (`--dictionary=path`), or NULL.
+ */
+extern const char* g_dictionary_path;
+
  /*
   * FUNCTION: load_dictionary
   *
@@ -45,4 +68,37 @@
   */
 bool load_dictionary(dictionary_entry_t** pp_dictionary, int* p_dictionary_count, bool should_filter_history);
 
+/*
+ * FUNCTION: read_dictionary_file
+ *
+ * WHAT:
+ * Allocates the dictionary array and parses every line of `AllWords.txt`
+ * into it, in file (alphabetical) order. No history filter, no entropy.
+ * The array grows as needed, so the file may hold any number of words.
+ *
+ * RETURNS:
+ * - true if successful, false if file I/O or memory allocation fails.
+ *
+ * WHY:
+ * Parsing does not depend on the "Used Words" download, so the startup
+ * pipeline runs it concurrently with the fetch.
+ */
+bool read_dictionary_file(dictionary_entry_t** pp_dictionary, int* p_dictionary_count);
+
+/*
+ * FUNCTION: parse_dictionary_line
+ *
+ * WHAT:
+ * Parses a single fixed-width dictionary line (e.g., "CAKES095PS") into
+ * `pEntry`, including derived metadata such as duplicate letters.
+ *
+ * RETURNS:
+ * - true if the line was long enough to parse.
+ *
+ * WHY:
+ * Lets the runtime mutation API create entries identical to those loaded
+ * from `AllWords.txt`.
+ */
+bool parse_dictionary_line(const char* line, dictionary_entry_t* pEntry);
+
 #endif
\ No newline at end of file
@@ -15,12 +15,37 @@
  */
 
 #include "load_used_words.h"
+#include "alloc_tracker.h"
 #include <errno.h>
+#ifndef WORDLE_NO_CURL
 #include <curl/curl.h>
+#endif
 #include <string.h>
 #include <ctype.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <atomic>
+
+/*
+ * CONSTANT: USED_WORDS_TIMEOUT_SECONDS
+ *
+ * WHAT:
+ * The longest the download may take, connection included.
+ *
+ * WHY:
+ * The startup pipeline joins the Fetch worker before `main` carries on, so
+ * a stalled server must not hold the program up indefinitely.
+ */
+#define USED_WORDS_TIMEOUT_SECONDS 30L
+
+/*
+ * STATIC: s_is_download_cancelled
+ *
+ * WHAT:
+ * Set by `set_used_words_download_cancelled` (from any thread). The
+ * transfer callbacks see it and abort.
+ */
+static std::atomic<bool> s_is_download_cancelled(false);
 
  /*
   * CONFIGURATION: Replay List
@@ -50,7 +75,7 @@ static const int g_replay_count = 0;
 // METHOD B: Use this when the list has words (Calculates size automatically)
 // static const int g_replay_count = sizeof(g_replay_words) / sizeof(g_replay_words[0]);
 
-
+#ifndef WORDLE_NO_CURL
 /*
  * FUNCTION: write_callback
  *
@@ -68,12 +93,13 @@ static size_t write_callback(void* contents, size_t size, size_t nmemb, void* us
     // Calculate the number of bytes in this specific chunk
     size_t realsize = size * nmemb;
     char** memory = (char**)userp;
+    if (s_is_download_cancelled.load()) return 0; // Abort: nobody needs the list any more
 
     if (*memory == NULL)
     {
         // FIRST CHUNK: Allocate initial buffer.
         // We add +1 for the null terminator we will append.
-        *memory = (char*)malloc(realsize + 1);
+        *memory = (char*)tracked_malloc(realsize + 1);
         if (*memory == NULL) return 0; // Signal error to cURL (abort download)
         memcpy(*memory, contents, realsize);
         (*memory)[realsize] = '\0';
@@ -82,7 +108,7 @@ static size_t write_callback(void* contents, size_t size, size_t nmemb, void* us
     {
         // SUBSEQUENT CHUNKS: Expand the buffer.
         size_t current_size = strlen(*memory);
-        char* ptr = (char*)realloc(*memory, current_size + realsize + 1);
+        char* ptr = (char*)tracked_realloc(*memory, current_size + realsize + 1);
         if (ptr == NULL) return 0; // Signal error (Out of Memory)
 
         *memory = ptr;
@@ -93,6 +119,19 @@ static size_t write_callback(void* contents, size_t size, size_t nmemb, void* us
     return realsize;
 }
 
+/*
+ * HELPER: progress_callback
+ *
+ * WHAT:
+ * cURL's transfer progress hook. Returning non-zero aborts the transfer,
+ * which also covers a cancel while no data is arriving (connect, stalls).
+ */
+static int progress_callback(void* clientp, curl_off_t dltotal, curl_off_t dlnow, curl_off_t ultotal, curl_off_t ulnow)
+{
+    (void)clientp; (void)dltotal; (void)dlnow; (void)ultotal; (void)ulnow;
+    return s_is_download_cancelled.load() ? 1 : 0;
+}
+
 /*
  * FUNCTION: get_used_words_webpage
  *
@@ -130,13 +169,18 @@ static char* get_used_words_webpage(void)
         // Vital: Pretend to be a real browser to avoid anti-bot blocks
         curl_easy_setopt(curl, CURLOPT_USERAGENT, "Chrome");
 
+        // Bounded and cancellable, so the caller can always join this thread
+        curl_easy_setopt(curl, CURLOPT_TIMEOUT, USED_WORDS_TIMEOUT_SECONDS);
+        curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+        curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, progress_callback);
+
         // Execute the request (Blocking call)
         res = curl_easy_perform(curl);
 
         if (res != CURLE_OK)
         {
-            fprintf(stderr, "cURL failed: %s\n", curl_easy_strerror(res));
-            if (hugeBuffer) free(hugeBuffer);
+            if (!s_is_download_cancelled.load()) fprintf(stderr, "cURL failed: %s\n", curl_easy_strerror(res));
+            if (hugeBuffer) tracked_free(hugeBuffer);
             hugeBuffer = NULL;
         }
         curl_easy_cleanup(curl);
@@ -145,7 +189,7 @@ static char* get_used_words_webpage(void)
 
     if (hugeBuffer == NULL)
     {
-        fprintf(stderr, "Failed to download webpage content.\n");
+        if (!s_is_download_cancelled.load()) fprintf(stderr, "Failed to download webpage content.\n");
     }
     else
     {
@@ -153,6 +197,21 @@ static char* get_used_words_webpage(void)
     }
     return hugeBuffer;
 }
+#else
+/*
+ * FUNCTION: get_used_words_webpage (no libcurl)
+ *
+ * WHAT:
+ * Stand-in for builds without libcurl (WORDLE_NO_CURL, see CMakeLists.txt).
+ * It always fails, so the used-word list comes back empty: no past answers
+ * are removed and the Historical Replay has nothing to replay.
+ */
+static char* get_used_words_webpage(void)
+{
+    fprintf(stderr, "Failed to download webpage content (built without libcurl).\n");
+    return NULL;
+}
+#endif
 
 /*
  * FUNCTION: compare
@@ -181,6 +240,7 @@ static int compare(const void* arg1, const void* arg2)
  * 4. Extracts the 5-letter word.
  * 5. Checks the "Replay List" (Whitelist).
  * 6. Adds the word to the global exclusion buffer.
+ * 7. Keeps an unsorted copy (page order) for the Historical Replay.
  *
  * WHY:
  * Screen scraping is brittle, so this function isolates the parsing logic.
@@ -206,7 +266,7 @@ bool  load_used_words_from_web(char** pp_used_words, int* p_used_word_count)
     int  max_used_word_count = MAX_DICTIONARY_WORDS;
 
     printf("Loading Used Words from web ...\n");
-    p_used_words = (char*)malloc(max_used_word_count * WORDLE_WORD_LENGTH);
+    p_used_words = (char*)tracked_malloc(max_used_word_count * WORDLE_WORD_LENGTH);
 
     if (p_used_words == NULL)
     {
@@ -219,6 +279,11 @@ bool  load_used_words_from_web(char** pp_used_words, int* p_used_word_count)
 
     // 1. Perform the Download
     pUsedWords_webpage = get_used_words_webpage();
+    if (pUsedWords_webpage == NULL && s_is_download_cancelled.load())
+    {
+        tracked_free(p_used_words);
+        return false;
+    }
 
     if (pUsedWords_webpage != NULL)
     {
@@ -313,10 +378,21 @@ bool  load_used_words_from_web(char** pp_used_words, int* p_used_word_count)
                 pTmp = NULL; // Error/End
             }
         }
-        free(pUsedWords_webpage);
+        tracked_free(pUsedWords_webpage);
     }
 
-    // 8. Sort the result for fast lookups
+    // 8. Keep a copy in source order for the Historical Replay.
+    // The page is not dated, so this order is only assumed to be the day order
+    // (the replay says so, and `--history=file` supplies a real one).
+    // The alphabetical sort below destroys it.
+    if (p_used_words != NULL && used_word_count > 0)
+    {
+        if (g_p_used_words_history != NULL) tracked_free(g_p_used_words_history);
+        g_p_used_words_history = (char*)tracked_malloc((size_t)used_word_count * WORDLE_WORD_LENGTH);
+        if (g_p_used_words_history != NULL) memcpy(g_p_used_words_history, p_used_words, (size_t)used_word_count * WORDLE_WORD_LENGTH);
+    }
+
+    // 9. Sort the result for fast lookups
     if (p_used_words != NULL)
     {
         qsort(p_used_words, used_word_count, WORDLE_WORD_LENGTH, compare);
@@ -344,4 +420,170 @@ bool  load_used_words_from_web(char** pp_used_words, int* p_used_word_count)
 bool  load_used_words(char** pp_used_words, int* p_used_word_count)
 {
     return load_used_words_from_web(pp_used_words, p_used_word_count);
-}
\ No newline at end of file
+}
+
+/*
+ * FUNCTION: set_used_words_download_cancelled
+ */
+void set_used_words_download_cancelled(bool is_cancelled)
+{
+    s_is_download_cancelled.store(is_cancelled);
+}
+
+/*
+ * STRUCT: history_line_t
+ *
+ * WHAT:
+ * One answer of a history file: its date (YYYYMMDD, 0 if undated), its line
+ * number (keeps file order among equal dates) and the word.
+ */
+typedef struct _history_line
+{
+    int date;
+    int line;
+    char word[WORDLE_WORD_LENGTH];
+} history_line_t;
+
+/*
+ * HELPER: compare_history_lines
+ */
+static int compare_history_lines(const void* arg1, const void* arg2)
+{
+    const history_line_t* a = (const history_line_t*)arg1;
+    const history_line_t* b = (const history_line_t*)arg2;
+    if (a->date != b->date) return (a->date < b->date) ? -1 : 1;
+    return (a->line < b->line) ? -1 : (a->line > b->line);
+}
+
+/*
+ * HELPER: parse_history_line
+ *
+ * WHAT:
+ * `WORD` or `YYYY-MM-DD WORD` (leading/trailing whitespace allowed).
+ *
+ * RETURNS:
+ * - false if the line is neither.
+ */
+static bool parse_history_line(const char* line, history_line_t* p_entry)
+{
+    const char* nonWordChars = " \t\n\r\v";
+    const char* p = line + strspn(line, nonWordChars);
+    p_entry->date = 0;
+
+    if (isdigit((unsigned char)*p))
+    {
+        char* p_end = NULL;
+        long year = strtol(p, &p_end, 10);
+        if (*p_end != '-') return false;
+        long month = strtol(p_end + 1, &p_end, 10);
+        if (*p_end != '-') return false;
+        long day = strtol(p_end + 1, &p_end, 10);
+        if (year < 2000 || year > 9999 || month < 1 || month > 12 || day < 1 || day > 31) return false;
+        p_entry->date = (int)(year * 10000 + month * 100 + day);
+        p = p_end + strspn(p_end, nonWordChars);
+    }
+
+    for (int i = 0; i < WORDLE_WORD_LENGTH; i++)
+    {
+        if (!isalpha((unsigned char)p[i])) return false;
+        p_entry->word[i] = (char)toupper((unsigned char)p[i]);
+    }
+    p += WORDLE_WORD_LENGTH;
+    return p[strspn(p, nonWordChars)] == '\0';
+}
+
+/*
+ * FUNCTION: load_answer_history_file
+ *
+ * WHAT:
+ * 1. Parses every line (blank lines and `#` comments are skipped).
+ * 2. Rejects a file that mixes dated and undated answers.
+ * 3. Sorts dated answers by date (file order breaks ties).
+ * 4. Packs the words like the used-word buffer (5 bytes each).
+ */
+bool load_answer_history_file(const char* path, char** pp_history, int* p_history_count, bool* p_is_dated)
+{
+    FILE* fpIn = NULL;
+    char buffer[128];
+    *pp_history = NULL;
+    *p_history_count = 0;
+    *p_is_dated = false;
+
+    if (fopen_s(&fpIn, path, "r") != 0 || fpIn == NULL)
+    {
+        fprintf(stderr, "Could not open answer history file (%s)!\n", path);
+        return false;
+    }
+
+    // 1. Parse
+    int capacity = 1024;
+    int count = 0, dated = 0, line_number = 0;
+    bool is_ok = true;
+    history_line_t* p_lines = (history_line_t*)tracked_malloc(sizeof(history_line_t) * capacity);
+    if (p_lines == NULL) { fclose(fpIn); fprintf(stderr, "Out of memory reading the answer history!\n"); return false; }
+
+    while (is_ok && fgets(buffer, sizeof(buffer), fpIn) != NULL)
+    {
+        line_number++;
+        const char* p = buffer + strspn(buffer, " \t\n\r\v");
+        if (*p == '\0' || *p == '#') continue;
+
+        if (count == capacity)
+        {
+            history_line_t* p_grown = (history_line_t*)tracked_realloc(p_lines, sizeof(history_line_t) * capacity * 2);
+            if (p_grown == NULL) { fprintf(stderr, "Out of memory reading the answer history!\n"); is_ok = false; break; }
+            p_lines = p_grown;
+            capacity *= 2;
+        }
+        if (!parse_history_line(buffer, &p_lines[count]))
+        {
+            fprintf(stderr, "%s:%d: expected 'WORD' or 'YYYY-MM-DD WORD'.\n", path, line_number);
+            is_ok = false;
+            break;
+        }
+        p_lines[count].line = line_number;
+        if (p_lines[count].date != 0) dated++;
+        count++;
+    }
+    fclose(fpIn);
+
+    // 2. All dated or none
+    if (is_ok && dated != 0 && dated != count)
+    {
+        fprintf(stderr, "%s: %d of %d answers have a date. Date all of them or none.\n", path, dated, count);
+        is_ok = false;
+    }
+    if (is_ok && count == 0)
+    {
+        fprintf(stderr, "%s: no answers found.\n", path);
+        is_ok = false;
+    }
+
+    // 3. Chronological order
+    if (is_ok && dated > 0) qsort(p_lines, count, sizeof(history_line_t), compare_history_lines);
+
+    // 4. Pack
+    char* p_history = is_ok ? (char*)tracked_malloc((size_t)count * WORDLE_WORD_LENGTH) : NULL;
+    if (is_ok && p_history == NULL) { fprintf(stderr, "Out of memory reading the answer history!\n"); is_ok = false; }
+    if (is_ok)
+    {
+        for (int i = 0; i < count; i++) memcpy(p_history + (size_t)i * WORDLE_WORD_LENGTH, p_lines[i].word, WORDLE_WORD_LENGTH);
+        *pp_history = p_history;
+        *p_history_count = count;
+        *p_is_dated = (dated > 0);
+    }
+    tracked_free(p_lines);
+    return is_ok;
+}
+
+/*
+ * FUNCTION: is_word_list_alphabetical
+ */
+bool is_word_list_alphabetical(const char* p_words, int count)
+{
+    for (int i = 1; i < count; i++)
+    {
+        if (memcmp(p_words + (size_t)(i - 1) * WORDLE_WORD_LENGTH, p_words + (size_t)i * WORDLE_WORD_LENGTH, WORDLE_WORD_LENGTH) > 0) return false;
+    }
+    return count > 1;
+}
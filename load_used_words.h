@@ -37,6 +37,18 @@
   */
 bool load_used_words(char** pp_used_words, int* p_used_word_count);
 
+/*
+ * FUNCTION: set_used_words_download_cancelled
+ *
+ * WHAT:
+ * While set, a `load_used_words` running on another thread (or started
+ * later) gives up: the download aborts at its next chunk or progress tick
+ * and the loader returns false without printing an error. Clear it again
+ * once that thread has been joined. (The download is also bounded by a
+ * timeout of its own.)
+ */
+void set_used_words_download_cancelled(bool is_cancelled);
+
 /*
  * GLOBALS: Used Word State
  *
@@ -48,13 +60,52 @@ bool load_used_words(char** pp_used_words, int* p_used_word_count);
  * `dictionary_entry_t` structs here because we only need the raw text
  * for simple `strncmp` filtering during the main dictionary load.
  * - g_used_word_count: The number of entries in the buffer.
+ * - g_p_used_words_history: The same words, in the order the source lists them
+ * (before sorting). The Historical Replay falls back to it without a history
+ * file; the page carries no dates, so that order is an assumption.
  */
 #ifdef MAIN
 char* g_p_used_words = NULL;
 int g_used_word_count = 0;
+char* g_p_used_words_history = NULL;
 #else
 extern char* g_p_used_words;
 extern int g_used_word_count;
+extern char* g_p_used_words_history;
 #endif
 
-#endif
\ No newline at end of file
+
+/*
+ * FUNCTION: load_answer_history_file
+ *
+ * WHAT:
+ * Reads a local answer history for the Historical Replay: one answer per
+ * line, either `WORD` (the file order is the day order) or
+ * `YYYY-MM-DD WORD` (sorted by date, so any order works). Blank lines and
+ * lines starting with `#` are skipped.
+ *
+ * PARAMETERS:
+ * - pp_history / p_history_count: Output. The words, oldest first, packed
+ * 5 bytes each (free with `tracked_free`).
+ * - p_is_dated: Output. true if the order came from dates.
+ *
+ * RETURNS:
+ * - false if the file cannot be read, a line is malformed, only some lines
+ * are dated, or there are no answers (the reason is printed).
+ *
+ * WHY:
+ * The scraped answer list has no dates, and nothing guarantees that it is
+ * chronological. A replay is only meaningful in the real day order.
+ */
+bool load_answer_history_file(const char* path, char** pp_history, int* p_history_count, bool* p_is_dated);
+
+/*
+ * FUNCTION: is_word_list_alphabetical
+ *
+ * WHAT:
+ * true if a packed list of 2+ words is in alphabetical order, i.e. it
+ * cannot be a day order.
+ */
+bool is_word_list_alphabetical(const char* p_words, int count);
+
+#endif
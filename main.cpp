@@ -50,14 +50,32 @@
 #include "entropy_calculator.h" 
 #include "monte_carlo.h" 
 #include "hybrid_strategies.h"
+#include "noise_filter.h"
+#include "game_snapshot.h"
+#include "startup_pipeline.h"
+#include "pattern_cache.h"
+#include "memory_budget.h"
+#include "shared_state_cache.h"
+#include "single_flight.h"
+#include "auto_tuner.h"
+#include "dictionary_generator.h"
+#include "verification.h"
+#include "pgo_training.h"
+#include "latency_histogram.h"
+#include "alloc_tracker.h"
+#include "thread_placement.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <math.h>
+#include <omp.h>
 #include "wordle_types.h"
 
  // CONSTANTS: Display formatting limits
 const int MAX_ENTRIES_TO_PRINT = 50;
+const int MAX_LIKELY_ANSWERS_TO_PRINT = 10;
+const int TOP_N_STATS_TO_PRINT = 10;
 const int MAX_GUESSES = 6;
 const int ENTRY_BLOCK_WIDTH = 44;
 const int TOTAL_TABLE_WIDTH = 89;
@@ -66,7 +84,31 @@ const char* SEPARATOR_TEMPLATE = "----------------------------------------------
 // GLOBALS: State flags for the runtime environment
 bool g_isHardMode = false;
 bool g_isInteractivePlay = true;
+bool g_isReplayMode = false;
+bool g_isFibbleMode = false;
 int g_tryIdx = 0;
+pattern_cache_t* g_p_pattern_cache = NULL;
+shared_state_cache_t* g_p_shared_cache = NULL;
+single_flight_t* g_p_single_flight = NULL;
+const char* g_shared_cache_path = NULL;
+const char* g_history_path = NULL;
+tuning_config_t g_tuning_config = { ENTROPY_KERNEL_ROW_LOOKUP, 0, 0, 0.0, "defaults" };
+bool g_isTuneRequested = false;
+const char* g_dictionary_path = NULL;
+const char* g_generate_dictionary_spec = NULL;
+bool g_isScaleBenchmark = false;
+int g_scale_sizes[16] = { 1000, 2000, 5000, 10000, 20000, 50000, 100000 };
+int g_scale_size_count = 7;
+int g_scale_letter_model = SYNTHETIC_LETTERS_ENGLISH;
+bool g_isPerfCountersRequested = false;
+bool g_isVerifyMode = false;
+unsigned long long g_verify_seed = 1;
+bool g_isPgoTraining = false;
+int g_pgo_train_words = PGO_TRAIN_DEFAULT_WORDS;
+double g_decision_budget_ms = 0.0;
+double g_latency_slo_ms = 0.0;
+int g_placement_policy = PLACEMENT_DEFAULT;
+bool g_isPlacementBenchmark = false;
 
 /*
  * FUNCTION: print_final_candidates_aligned_box
@@ -94,10 +136,10 @@ static void print_final_candidates_aligned_box(const recommendations_array_t can
     const dictionary_entry_t* r_filt = candidates[3].pEntry;
 
     // Format the strings with Word, Entropy Score, and Frequency Rank
-    sprintf_s(ent_raw_str, 80, "     Raw: %5.5s E:%.4f R:%03d", e_raw->word, e_raw->entropy, e_raw->frequency_rank);
-    sprintf_s(ent_filt_str, 80, "Filtered: %5.5s E:%.4f R:%03d", e_filt->word, e_filt->entropy, e_filt->frequency_rank);
-    sprintf_s(rank_raw_str, 80, "     Raw: %5.5s E:%.4f R:%03d", r_raw->word, r_raw->entropy, r_raw->frequency_rank);
-    sprintf_s(rank_filt_str, 80, "Filtered: %5.5s E:%.4f R:%03d", r_filt->word, r_filt->entropy, r_filt->frequency_rank);
+    sprintf_s(ent_raw_str, 80, "     Raw: %5.5s E:%.4f R:%03d", e_raw->word, ENTROPY_SCORE_TO_BITS(e_raw->entropy_score), e_raw->frequency_rank);
+    sprintf_s(ent_filt_str, 80, "Filtered: %5.5s E:%.4f R:%03d", e_filt->word, ENTROPY_SCORE_TO_BITS(e_filt->entropy_score), e_filt->frequency_rank);
+    sprintf_s(rank_raw_str, 80, "     Raw: %5.5s E:%.4f R:%03d", r_raw->word, ENTROPY_SCORE_TO_BITS(r_raw->entropy_score), r_raw->frequency_rank);
+    sprintf_s(rank_filt_str, 80, "Filtered: %5.5s E:%.4f R:%03d", r_filt->word, ENTROPY_SCORE_TO_BITS(r_filt->entropy_score), r_filt->frequency_rank);
 
     // Print the Header Box
     printf("%.*s\n", TOTAL_TABLE_WIDTH, SEPARATOR_TEMPLATE);
@@ -117,7 +159,7 @@ static void print_final_candidates_aligned_box(const recommendations_array_t can
     {
         char smart_str[100];
         sprintf_s(smart_str, 100, ">>> CHAMPION PICK: %s (R=%03d, H=%.4f) <<<",
-            pSmartPick->word, pSmartPick->frequency_rank, pSmartPick->entropy);
+            pSmartPick->word, pSmartPick->frequency_rank, ENTROPY_SCORE_TO_BITS(pSmartPick->entropy_score));
 
         // Center the champion string dynamically based on table width
         int len = (int)strlen(smart_str);
@@ -169,13 +211,13 @@ void print_comparison_table_fixed_width(const dictionary_pointer_array_t p_entro
     for (int i = 0; i < N; ++i)
     {
         // Left Column: Entropy Sorted
-        if (i < count) { const dictionary_entry_t* e1 = p_entropy_sorted[i]; printf(DATA_FORMAT, i + 1, e1->word, e1->entropy, e1->frequency_rank, e1->noun_type, e1->verb_type, e1->contains_duplicate_letters ? "Y" : "N"); }
+        if (i < count) { const dictionary_entry_t* e1 = p_entropy_sorted[i]; printf(DATA_FORMAT, i + 1, e1->word, ENTROPY_SCORE_TO_BITS(e1->entropy_score), e1->frequency_rank, e1->noun_type, e1->verb_type, e1->contains_duplicate_letters ? "Y" : "N"); }
         else { printf(BLANK_FORMAT, i + 1, "", "", 0, ' ', ' ', ' '); }
 
         printf(" "); // Gutter between tables
 
         // Right Column: Rank Sorted
-        if (i < count) { const dictionary_entry_t* e2 = p_rank_sorted[i]; printf(DATA_FORMAT, i + 1, e2->word, e2->entropy, e2->frequency_rank, e2->noun_type, e2->verb_type, e2->contains_duplicate_letters ? "Y" : "N"); }
+        if (i < count) { const dictionary_entry_t* e2 = p_rank_sorted[i]; printf(DATA_FORMAT, i + 1, e2->word, ENTROPY_SCORE_TO_BITS(e2->entropy_score), e2->frequency_rank, e2->noun_type, e2->verb_type, e2->contains_duplicate_letters ? "Y" : "N"); }
         else { printf(BLANK_FORMAT, i + 1, "", "", 0, ' ', ' ', ' '); }
         printf("\n");
     }
@@ -216,14 +258,14 @@ static bool prompt_and_validate_input(char* guess_buffer, char* result_input)
     // LOOP 1: Get the Guess Word
     while (1)
     {
-        printf("Enter your 5-letter word guess (or 'q' to quit): ");
+        printf("Enter your 5-letter word guess (or 'q' to quit, 'u' to undo, 'r' to redo): ");
         if (fgets(buffer, size_limit, stdin) == NULL) return false;
 
         // Remove trailing newline from fgets
         if (strlen(buffer) > 0 && buffer[strlen(buffer) - 1] == '\n') buffer[strlen(buffer) - 1] = '\0';
 
-        // Check for Quit condition
-        if (strcmp(buffer, "q") == 0) { memcpy(guess_buffer, buffer, strlen(buffer) + 1); return false; }
+        // Check for Quit / Undo / Redo commands (handled by the caller)
+        if (strcmp(buffer, "q") == 0 || strcmp(buffer, "u") == 0 || strcmp(buffer, "r") == 0) { memcpy(guess_buffer, buffer, strlen(buffer) + 1); return false; }
 
         // Validate Length
         if (strlen(buffer) == WORDLE_WORD_LENGTH)
@@ -291,6 +333,111 @@ void analyze_and_recommend(const dictionary_pointer_array_t p_possibleAnswers_so
     }
 }
 
+/*
+ * FUNCTION: print_top_n_statistics
+ *
+ * WHAT:
+ * Prints the top N guesses of the Entropy View with their partition
+ * statistics: expected answers left, worst-case bucket, number of distinct
+ * patterns and the chance of winning on this guess.
+ *
+ * WHY:
+ * Entropy alone hides the risk profile of a guess. Two words with similar
+ * entropy can leave very different worst cases, and a valid word with
+ * slightly lower entropy may be worth its chance of an immediate win.
+ */
+static void print_top_n_statistics(const dictionary_pointer_array_t p_entropy_sorted, int count, dictionary_entry_t** ppValidAnswers, int valid_count)
+{
+    partition_stats_t stats[TOP_N_STATS_TO_PRINT];
+    int n = recommend_top_n(p_entropy_sorted, count, ppValidAnswers, valid_count, TOP_N_STATS_TO_PRINT, stats);
+    if (n == 0) return;
+
+    printf("\n%*.*s## Top %d Guesses: Partition Statistics (%d answers left) ##\n", 16, 16, "", n, valid_count);
+    printf("%.*s\n", TOTAL_TABLE_WIDTH, SEPARATOR_TEMPLATE);
+    printf("| %2s | %5s | %8s | %10s | %10s | %8s | %8s |\n", "#", "WORD", "ENTROPY", "EXP. LEFT", "WORST CASE", "PATTERNS", "P(WIN)");
+    printf("%.*s\n", TOTAL_TABLE_WIDTH, SEPARATOR_TEMPLATE);
+    for (int i = 0; i < n; ++i)
+    {
+        printf("| %2d | %5.5s | %8.4f | %10.2f | %10d | %8d | %7.2f%% |\n", i + 1, stats[i].pEntry->word, ENTROPY_SCORE_TO_BITS(stats[i].entropy_score),
+            stats[i].expected_remaining, stats[i].max_bucket, stats[i].bucket_count, stats[i].win_probability * 100.0);
+    }
+    printf("%.*s\n", TOTAL_TABLE_WIDTH, SEPARATOR_TEMPLATE);
+}
+
+/*
+ * FUNCTION: print_likely_answers
+ *
+ * WHAT:
+ * Lists the surviving words with the fewest feedback mismatches, together
+ * with their posterior probability under the active noise model.
+ *
+ * WHY:
+ * After a tolerant re-filter, the user needs to see which clue the solver
+ * now believes was mistyped: the top words show how many positions of the
+ * entered feedback each one contradicts.
+ */
+static void print_likely_answers(dictionary_entry_t* p_data, int count, int turn_count, const noise_model_t* p_model)
+{
+    dictionary_pointer_array_t p_by_mismatches = NULL;
+    if (!duplicate_dictionary_pointers(p_data, count, &p_by_mismatches, compare_dictionary_entries_by_mismatches_asc)) return;
+
+    // Normalize likelihoods over all survivors (uniform prior)
+    double best_log_likelihood = noise_log_likelihood(p_by_mismatches[0], turn_count, p_model);
+    double total_weight = 0.0;
+    int survivors = 0;
+    for (int i = 0; i < count && !p_by_mismatches[i]->is_eliminated; ++i)
+    {
+        total_weight += exp(noise_log_likelihood(p_by_mismatches[i], turn_count, p_model) - best_log_likelihood);
+        survivors++;
+    }
+
+    printf("Most likely answers (%d kept):\n", survivors);
+    for (int i = 0; i < survivors && i < MAX_LIKELY_ANSWERS_TO_PRINT; ++i)
+    {
+        const dictionary_entry_t* pEntry = p_by_mismatches[i];
+        double probability = exp(noise_log_likelihood(pEntry, turn_count, p_model) - best_log_likelihood) / total_weight;
+        printf("  %2d. %5.5s  Mismatches: %d  R:%03d  P: %5.1f%%\n", i + 1, pEntry->word, pEntry->feedback_mismatches, pEntry->frequency_rank, probability * 100.0);
+    }
+    tracked_free(p_by_mismatches);
+}
+
+/*
+ * FUNCTION: recover_from_inconsistent_feedback
+ *
+ * WHAT:
+ * Called when the strict filter leaves no words at all. Re-filters the whole
+ * dictionary from the recorded history, allowing 1 and then 2 mismatched
+ * pattern positions in total, and stops at the first tolerance that keeps
+ * at least one word.
+ *
+ * RETURNS:
+ * - The number of words kept (0 if even 2 mismatches cannot explain the input).
+ *
+ * WHY:
+ * The only way the strict filter empties the pool is a wrong entry (or a word
+ * missing from the dictionary). Assuming the smallest possible number of
+ * typos keeps the game going instead of ending in "No words remaining".
+ */
+static int recover_from_inconsistent_feedback(dictionary_entry_t* p_data, int count, const feedback_history_t* p_history)
+{
+    const int MAX_TYPO_TOLERANCE = 2;
+    noise_model_t typo_model = { 0, 0, 0.02 };
+
+    printf("WARNING: No word matches every result entered. Assuming a mistyped result...\n");
+    for (int tolerance = 1; tolerance <= MAX_TYPO_TOLERANCE; tolerance++)
+    {
+        typo_model.max_total_mismatches = tolerance;
+        int remaining = refilter_with_noise(p_data, count, p_history, &typo_model);
+        if (remaining > 0)
+        {
+            printf("Allowing %d mismatched tile%s keeps %d word%s.\n", tolerance, tolerance == 1 ? "" : "s", remaining, remaining == 1 ? "" : "s");
+            print_likely_answers(p_data, count, p_history->turn_count, &typo_model);
+            return remaining;
+        }
+    }
+    return 0;
+}
+
 /*
  * FUNCTION: run_interactive_mode
  *
@@ -301,7 +448,13 @@ void analyze_and_recommend(const dictionary_pointer_array_t p_possibleAnswers_so
  * 3. Calculates Entropy for valid words.
  * 4. Recommends a guess.
  * 5. Accepts user feedback (result pattern).
- * 6. Filters the dictionary based on that feedback.
+ * 6. Filters the dictionary based on that feedback. If nothing survives, the
+ * history is re-filtered with a small typo tolerance (see noise_filter.h).
+ * In Fibble mode every row is filtered as "exactly one lie".
+ *
+ * The state at the start of every turn is snapshotted (see game_snapshot.h),
+ * so 'u' steps back one turn and 'r' steps forward again without any
+ * entropy recomputation. Entering a new guess after an undo starts a branch.
  *
  * WHY:
  * This is the "Game Controller." It manages the lifecycle of the dictionary data
@@ -320,9 +473,13 @@ void run_interactive_mode(dictionary_entry_t* p_possibleAnswers_data,
 
     // Temporary array to track pointers to *valid* answers only.
     // We use malloc because the stack might overflow if the dictionary is huge.
-    dictionary_entry_t** ppValidAnswers = (dictionary_entry_t**)malloc(sizeof(dictionary_entry_t*) * possibleAnswers_count);
+    dictionary_entry_t** ppValidAnswers = (dictionary_entry_t**)tracked_malloc(sizeof(dictionary_entry_t*) * possibleAnswers_count);
     int total_dictionary_size = possibleAnswers_count;
     int min_required_counts[26] = { 0 }; // Tracks the minimum count of each letter (e.g., "at least 2 'E's")
+    feedback_history_t history;          // Every guess and result entered, for noise-tolerant re-filtering
+    memset(&history, 0, sizeof(history));
+    snapshot_stack_t snapshots;          // Turn-start states for undo/redo
+    init_snapshot_stack(&snapshots, total_dictionary_size);
 
     // === CONFIGURATION ===
     // 0 = Entropy Linguist (Strict) - THE CHAMPION STRATEGY
@@ -332,6 +489,15 @@ void run_interactive_mode(dictionary_entry_t* p_possibleAnswers_data,
     HybridConfig championConfig = ALL_STRATEGIES[selected_strategy_index];
     printf("Interactive Mode Strategy: %s\n", championConfig.name);
 
+    // Recommendation latency: from the feedback being entered (or the start,
+    // for Turn 1) to the recommendation being on screen.
+    decision_latency_t* p_latency = (decision_latency_t*)tracked_calloc(1, sizeof(decision_latency_t));
+    // The decision budget runs from the same point, so the entropy pass that
+    // prepares the views is bounded by it too (Normal Mode).
+    double recommendation_start = omp_get_wtime();
+    bool is_entropy_complete = true;
+    set_allocation_phase(ALLOC_PHASE_PLAY);
+
     g_tryIdx = 0;
     // GAME LOOP: Up to 6 guesses
     for (g_tryIdx = 1; g_tryIdx <= MAX_GUESSES; g_tryIdx++)
@@ -345,22 +511,48 @@ void run_interactive_mode(dictionary_entry_t* p_possibleAnswers_data,
         }
 
         // 2. Ask the Bot for the Best Move
+        // If this turn's state was already snapshotted (undo/redo, or a failed
+        // input), its recommendation is reused instead of being recomputed.
         const dictionary_entry_t* pSmartPick = NULL;
-        if (!g_isHardMode)
+        decision_report_t decision;
+        bool is_known_turn = (snapshots.depth >= g_tryIdx);
+        if (is_known_turn)
+        {
+            pSmartPick = snapshots.items[g_tryIdx - 1].p_smart_pick;
+        }
+        else if (!g_isHardMode)
         {
             // Normal Mode: The bot can pick ANY word (even invalid ones) if it gives good info.
             // We pass 'total_dictionary_size' as the candidate pool.
-            pSmartPick = get_smart_hybrid_guess(*pp_possibleAnswersSortedByEntropy, *pp_possibleAnswersSortedByRank, total_dictionary_size, &championConfig, min_required_counts, validCount, g_tryIdx);
+            pSmartPick = get_anytime_hybrid_guess(*pp_possibleAnswersSortedByEntropy, *pp_possibleAnswersSortedByRank, total_dictionary_size, &championConfig, min_required_counts, validCount, g_tryIdx, recommendation_start, g_decision_budget_ms, &decision);
         }
         else
         {
             // Hard Mode: The bot MUST pick a word that fits the current clues.
             // We pass 'validCount' as the candidate pool.
-            pSmartPick = get_smart_hybrid_guess(*pp_possibleAnswersSortedByEntropy, *pp_possibleAnswersSortedByRank, validCount, &championConfig, min_required_counts, validCount, g_tryIdx);
+            pSmartPick = get_anytime_hybrid_guess(*pp_possibleAnswersSortedByEntropy, *pp_possibleAnswersSortedByRank, validCount, &championConfig, min_required_counts, validCount, g_tryIdx, recommendation_start, g_decision_budget_ms, &decision);
+        }
+
+        // Anytime mode: how much of the decision fitted in the budget (end to end)
+        if (!is_known_turn && !is_entropy_complete) decision.is_deadline_hit = true;
+        if (!is_known_turn && g_decision_budget_ms > 0.0)
+        {
+            printf("Decision: %.2f ms of %.2f ms budget", decision.elapsed_ms, g_decision_budget_ms);
+            if (decision.lookahead_total > 0) printf(", Look Ahead on %d of %d candidates", decision.lookahead_evaluated, decision.lookahead_total);
+            printf("%s\n", decision.is_deadline_hit ? " (deadline hit)" : "");
+        }
+
+        // Save the turn-start state (a new guess after an undo starts a new branch)
+        if (!is_known_turn)
+        {
+            push_snapshot(&snapshots, p_possibleAnswers_data, *pp_possibleAnswersSortedByEntropy, *pp_possibleAnswersSortedByRank,
+                possibleAnswers_count, min_required_counts, &history, pSmartPick);
         }
 
         // 3. Show Recommendations to User
         analyze_and_recommend(*pp_possibleAnswersSortedByEntropy, *pp_possibleAnswersSortedByRank, g_isHardMode ? validCount : total_dictionary_size, candidates, pSmartPick);
+        print_top_n_statistics(*pp_possibleAnswersSortedByEntropy, g_isHardMode ? validCount : total_dictionary_size, ppValidAnswers, validCount);
+        if (!is_known_turn && p_latency != NULL) record_decision_latency(p_latency, g_tryIdx, validCount, (omp_get_wtime() - recommendation_start) * 1000.0);
 
         printf("\n--- Turn %d of %d ---\n", g_tryIdx, MAX_GUESSES);
 
@@ -368,21 +560,67 @@ void run_interactive_mode(dictionary_entry_t* p_possibleAnswers_data,
         if (!prompt_and_validate_input(user_guess, result_pattern))
         {
             if (strcmp(user_guess, "q") == 0) { printf("USER TYPED 'q'! Exiting game loop.\n"); break; }
+
+            // Undo: restore the start of the previous turn (snapshot g_tryIdx - 2)
+            // Redo: restore the start of the next turn (snapshot g_tryIdx)
+            int target_turn = g_tryIdx;
+            if (strcmp(user_guess, "u") == 0) target_turn = g_tryIdx - 1;
+            if (strcmp(user_guess, "r") == 0) target_turn = g_tryIdx + 1;
+
+            if (target_turn != g_tryIdx)
+            {
+                if (restore_snapshot(&snapshots, target_turn - 1, p_possibleAnswers_data, pp_possibleAnswersSortedByEntropy, pp_possibleAnswersSortedByRank,
+                    &possibleAnswers_count, min_required_counts, &history))
+                {
+                    printf("%s to the start of turn %d.\n", (target_turn < g_tryIdx) ? "Undone back" : "Redone forward", target_turn);
+                    g_tryIdx = target_turn;
+                }
+                else
+                {
+                    printf("Nothing to %s.\n", (target_turn < g_tryIdx) ? "undo" : "redo");
+                }
+            }
             g_tryIdx--; continue;
         }
+        recommendation_start = omp_get_wtime();
 
         // 5. Check Win Condition
         if (strcmp(result_pattern, "GGGGG") == 0) { printf("\n*** CONGRATULATIONS! YOU SOLVED IT IN %d GUESSES! ***\n", g_tryIdx); break; }
 
         printf("Guess: %s, Result: %s. Processing...\n", user_guess, result_pattern);
 
-        // 6. Update Constraints
-        // "min_required_counts" tracks if we know there are at least 2 'E's, etc.
-        update_min_required_counts(user_guess, result_pattern, min_required_counts);
+        int result_code = encode_feedback_pattern(result_pattern);
+        record_feedback(&history, user_guess, result_code);
 
-        // 7. Filter the Dictionary
-        // Mark words as "eliminated" if they don't match the result pattern.
-        filter_dictionary_by_constraints(p_possibleAnswers_data, possibleAnswers_count, user_guess, result_pattern);
+        if (g_isFibbleMode)
+        {
+            // 6/7. Fibble: No letter minimums (any tile may be a lie); keep only
+            // words that disagree with this row in exactly one position.
+            apply_noisy_feedback(p_possibleAnswers_data, possibleAnswers_count, user_guess, result_code, &FIBBLE_NOISE_MODEL);
+        }
+        else
+        {
+            // 6. Update Constraints
+            // "min_required_counts" tracks if we know there are at least 2 'E's, etc.
+            update_min_required_counts(user_guess, result_pattern, min_required_counts);
+
+            // 7. Filter the Dictionary
+            // Mark words as "eliminated" if they don't match the result pattern.
+            filter_dictionary_by_constraints(p_possibleAnswers_data, possibleAnswers_count, user_guess, result_pattern, NULL);
+
+            // 7b. Typo Recovery
+            // An empty pool means some entered result was wrong. Re-filter the full
+            // dictionary (Hard Mode compaction keeps eliminated words at the end of
+            // the array) with a small mismatch tolerance.
+            int remaining = 0;
+            for (int i = 0; i < total_dictionary_size; ++i) { if (!p_possibleAnswers_data[i].is_eliminated) remaining++; }
+            if (remaining == 0 && recover_from_inconsistent_feedback(p_possibleAnswers_data, total_dictionary_size, &history) > 0)
+            {
+                // The letter minimums were derived from the suspect clue as well.
+                memset(min_required_counts, 0, sizeof(min_required_counts));
+                possibleAnswers_count = total_dictionary_size;
+            }
+        }
 
         // 8. Re-calculate Entropy and Sort
         if (!g_isHardMode)
@@ -398,13 +636,14 @@ void run_interactive_mode(dictionary_entry_t* p_possibleAnswers_data,
             if (validCount == 0) { printf("CRITICAL: No words remaining!\n"); break; }
 
             printf("Recalculating entropy...\n");
-            calculate_entropy_for_candidates(p_possibleAnswers_data, total_dictionary_size, ppValidAnswers, validCount);
+            double entropy_deadline = (g_decision_budget_ms > 0.0) ? recommendation_start + g_decision_budget_ms / 1000.0 : 0.0;
+            is_entropy_complete = calculate_entropy_for_candidates_until(p_possibleAnswers_data, total_dictionary_size, ppValidAnswers, validCount, entropy_deadline);
 
             // Re-create sorted views
-            free(*pp_possibleAnswersSortedByEntropy); *pp_possibleAnswersSortedByEntropy = NULL;
+            tracked_free(*pp_possibleAnswersSortedByEntropy); *pp_possibleAnswersSortedByEntropy = NULL;
             duplicate_dictionary_pointers(p_possibleAnswers_data, total_dictionary_size, pp_possibleAnswersSortedByEntropy, compare_dictionary_entries_by_entropy_no_filter_desc);
 
-            free(*pp_possibleAnswersSortedByRank); *pp_possibleAnswersSortedByRank = NULL;
+            tracked_free(*pp_possibleAnswersSortedByRank); *pp_possibleAnswersSortedByRank = NULL;
             duplicate_dictionary_pointers(p_possibleAnswers_data, total_dictionary_size, pp_possibleAnswersSortedByRank, compare_dictionary_entries_by_rank_desc);
         }
         else
@@ -424,14 +663,124 @@ void run_interactive_mode(dictionary_entry_t* p_possibleAnswers_data,
             printf("Recalculating entropy...\n");
             calculate_entropy_on_dictionary(p_possibleAnswers_data, possibleAnswers_count);
 
-            free(*pp_possibleAnswersSortedByEntropy); *pp_possibleAnswersSortedByEntropy = NULL;
-            free(*pp_possibleAnswersSortedByRank); *pp_possibleAnswersSortedByRank = NULL;
+            tracked_free(*pp_possibleAnswersSortedByEntropy); *pp_possibleAnswersSortedByEntropy = NULL;
+            tracked_free(*pp_possibleAnswersSortedByRank); *pp_possibleAnswersSortedByRank = NULL;
 
             duplicate_dictionary_pointers(p_possibleAnswers_data, possibleAnswers_count, pp_possibleAnswersSortedByEntropy, compare_dictionary_entries_by_entropy_desc);
             duplicate_dictionary_pointers(p_possibleAnswers_data, possibleAnswers_count, pp_possibleAnswersSortedByRank, compare_dictionary_entries_by_rank_desc);
         }
     }
-    free(ppValidAnswers);
+    if (p_latency != NULL) print_decision_latency_report(p_latency, "Interactive Recommendations");
+    tracked_free(p_latency);
+    free_snapshot_stack(&snapshots);
+    tracked_free(ppValidAnswers);
+}
+
+/*
+ * HELPER: parse_scale_sizes
+ *
+ * WHAT:
+ * Parses "N,N,...[,letters]" for `--scale-benchmark=` (letters is a
+ * letter model name, see dictionary_generator.h).
+ */
+static bool parse_scale_sizes(const char* text)
+{
+    int count = 0;
+    const char* p = text;
+    while (*p != '\0')
+    {
+        char* p_end = NULL;
+        long size = strtol(p, &p_end, 10);
+        if (p_end != p)
+        {
+            if (size <= 0 || count == (int)(sizeof(g_scale_sizes) / sizeof(g_scale_sizes[0]))) return false;
+            g_scale_sizes[count++] = (int)size;
+        }
+        else
+        {
+            char name[16];
+            size_t length = strcspn(p, ",");
+            if (length >= sizeof(name)) return false;
+            memcpy(name, p, length);
+            name[length] = '\0';
+            g_scale_letter_model = parse_letter_model(name);
+            if (g_scale_letter_model < 0) return false;
+            p_end = (char*)p + length;
+        }
+        if (*p_end == ',') p_end++;
+        else if (*p_end != '\0') return false;
+        p = p_end;
+    }
+    if (count > 0) g_scale_size_count = count;
+    return true;
+}
+
+/*
+ * FUNCTION: parse_command_line
+ *
+ * WHAT:
+ * Reads optional command-line switches:
+ * --replay : Run the Historical Replay instead of Interactive/Tournament mode.
+ * --history=path : The replay's answer history, oldest first (see load_used_words.h).
+ * --fibble : Every row of feedback contains exactly one lie (Fibble variant).
+ * --memory-budget=MB : Cap for caches and tables (see memory_budget.h).
+ * --shared-cache=path : Decided positions shared between processes (see shared_state_cache.h).
+ * --tune : Recalibrate the entropy engine for this machine (see auto_tuner.h).
+ * --dictionary=path : Read this dictionary file instead of AllWords.txt.
+ * --generate-dictionary=N[,seed[,letters]] : Write a synthetic dictionary and exit.
+ * --scale-benchmark[=N,N,...[,letters]] : Time every engine on synthetic dictionaries and exit.
+ * --perf-counters : The scale benchmark also reads hardware counters (see perf_counters.h).
+ * --verify[=seed] : Check every optimized path against its reference and exit (see verification.h).
+ * --pgo-train[=N] : Run the fixed profile-training workload on N words and exit (see pgo_training.h).
+ * --decision-budget-ms=N : Anytime decisions: each guess is chosen within N ms (see solver_logic.h).
+ * --latency-slo-ms=N : Recommendation latency objective checked by the latency reports (see latency_histogram.h).
+ * --placement=default|compact|spread|cores : Where the worker threads run (see thread_placement.h).
+ * --placement-benchmark : Time the startup pass and tournament games under every placement and exit.
+ *
+ * WHY:
+ * The interactive prompts cover everyday use. Research modes that need no
+ * per-run answers are selected on the command line so they can be scripted.
+ *
+ * RETURNS:
+ * - false if an unknown switch was given (usage is printed).
+ */
+static bool parse_command_line(int argc, char* argv[])
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--replay") == 0) { g_isReplayMode = true; }
+        else if (strncmp(argv[i], "--history=", 10) == 0 && argv[i][10] != '\0') { g_history_path = argv[i] + 10; }
+        else if (strcmp(argv[i], "--fibble") == 0) { g_isFibbleMode = true; }
+        else if (strncmp(argv[i], "--memory-budget=", 16) == 0 && atoi(argv[i] + 16) > 0)
+        {
+            set_memory_budget((size_t)atoi(argv[i] + 16) * 1024 * 1024);
+        }
+        else if (strncmp(argv[i], "--shared-cache=", 15) == 0 && argv[i][15] != '\0') { g_shared_cache_path = argv[i] + 15; }
+        else if (strcmp(argv[i], "--tune") == 0) { g_isTuneRequested = true; }
+        else if (strncmp(argv[i], "--dictionary=", 13) == 0 && argv[i][13] != '\0') { g_dictionary_path = argv[i] + 13; }
+        else if (strncmp(argv[i], "--generate-dictionary=", 22) == 0) { g_generate_dictionary_spec = argv[i] + 22; }
+        else if (strcmp(argv[i], "--scale-benchmark") == 0) { g_isScaleBenchmark = true; }
+        else if (strncmp(argv[i], "--scale-benchmark=", 18) == 0 && parse_scale_sizes(argv[i] + 18)) { g_isScaleBenchmark = true; }
+        else if (strcmp(argv[i], "--perf-counters") == 0) { g_isPerfCountersRequested = true; }
+        else if (strcmp(argv[i], "--verify") == 0) { g_isVerifyMode = true; }
+        else if (strncmp(argv[i], "--verify=", 9) == 0 && isdigit((unsigned char)argv[i][9])) { g_isVerifyMode = true; g_verify_seed = strtoull(argv[i] + 9, NULL, 10); }
+        else if (strcmp(argv[i], "--pgo-train") == 0) { g_isPgoTraining = true; }
+        else if (strncmp(argv[i], "--pgo-train=", 12) == 0 && atoi(argv[i] + 12) > 0) { g_isPgoTraining = true; g_pgo_train_words = atoi(argv[i] + 12); }
+        else if (strncmp(argv[i], "--decision-budget-ms=", 21) == 0 && strtod(argv[i] + 21, NULL) > 0.0) { g_decision_budget_ms = strtod(argv[i] + 21, NULL); }
+        else if (strncmp(argv[i], "--latency-slo-ms=", 17) == 0 && strtod(argv[i] + 17, NULL) > 0.0) { g_latency_slo_ms = strtod(argv[i] + 17, NULL); }
+        else if (strncmp(argv[i], "--placement=", 12) == 0 && parse_placement_policy(argv[i] + 12, &g_placement_policy)) {}
+        else if (strcmp(argv[i], "--placement-benchmark") == 0) { g_isPlacementBenchmark = true; }
+        else
+        {
+            printf("Unknown option '%s'.\n", argv[i]);
+            printf("Usage: %s [--replay] [--history=path] [--fibble] [--memory-budget=MB] [--shared-cache=path] [--tune]\n", argv[0]);
+            printf("       [--dictionary=path] [--generate-dictionary=N[,seed[,letters]]] [--scale-benchmark[=N,N,...[,letters]]] [--verify[=seed]]\n");
+            printf("       [--pgo-train[=N]] [--decision-budget-ms=N] [--latency-slo-ms=N] [--perf-counters]\n");
+            printf("       [--placement=default|compact|spread|cores] [--placement-benchmark]\n");
+            return false;
+        }
+    }
+    return true;
 }
 
 /*
@@ -456,18 +805,27 @@ static bool get_game_setup_input()
     char buffer[2048];
     bool filter_history = true; // Default
 
-    printf("\nDo you want to filter out past Wordle answers? (Y/N) (Default: Y): ");
-    if (fgets(buffer, sizeof(buffer), stdin) == NULL) { buffer[0] = 'Y'; }
-    if (strlen(buffer) > 0 && buffer[strlen(buffer) - 1] == '\n') buffer[strlen(buffer) - 1] = '\0';
-
-    if (strlen(buffer) > 0 && toupper((unsigned char)buffer[0]) == 'N')
+    // The replay applies the history filter itself, one day at a time.
+    if (g_isReplayMode)
     {
         filter_history = false;
-        printf("History Filter DISABLED. Dictionary will include all past answers.\n");
+        printf("\nHistorical Replay: past answers are removed day by day.\n");
     }
     else
     {
-        printf("History Filter ENABLED. Past answers will be removed.\n");
+        printf("\nDo you want to filter out past Wordle answers? (Y/N) (Default: Y): ");
+        if (fgets(buffer, sizeof(buffer), stdin) == NULL) { buffer[0] = 'Y'; }
+        if (strlen(buffer) > 0 && buffer[strlen(buffer) - 1] == '\n') buffer[strlen(buffer) - 1] = '\0';
+
+        if (strlen(buffer) > 0 && toupper((unsigned char)buffer[0]) == 'N')
+        {
+            filter_history = false;
+            printf("History Filter DISABLED. Dictionary will include all past answers.\n");
+        }
+        else
+        {
+            printf("History Filter ENABLED. Past answers will be removed.\n");
+        }
     }
 
     printf("\nAre you playing Wordle in HARD MODE (Y/N)? (Default: N): ");
@@ -483,6 +841,8 @@ static bool get_game_setup_input()
         g_isHardMode = false; printf("Solver initialized for NORMAL MODE.\n");
     }
 
+    if (g_isReplayMode) { g_isInteractivePlay = false; return filter_history; }
+
     printf("\nAre you wanting to interactively play Wordle (Y/N)? (Default: Y): ");
     if (fgets(buffer, sizeof(buffer), stdin) == NULL) { buffer[0] = 'Y'; }
     if (strlen(buffer) > 0 && buffer[strlen(buffer) - 1] == '\n') buffer[strlen(buffer) - 1] = '\0';
@@ -504,10 +864,12 @@ static bool get_game_setup_input()
  *
  * WHAT:
  * The application entry point.
- * 1. Gets User Configuration (Filter history? Hard Mode? Sim Mode?).
- * 2. Loads the dictionary from disk based on that config.
+ * 1. Starts the startup pipeline (download, parse, entropy) in the background
+ * and gets User Configuration (Filter history? Hard Mode? Sim Mode?) meanwhile.
+ * 2. Finishes loading the dictionary based on that config.
  * 3. Creates initial sorted views (Entropy and Rank).
- * 4. Launches either the Interactive Game Loop or the Monte Carlo Simulation.
+ * 4. Launches the Interactive Game Loop, the Monte Carlo Simulation, or the
+ * Historical Replay (--replay).
  * 5. Cleans up allocated memory on exit.
  *
  * WHY:
@@ -516,22 +878,145 @@ static bool get_game_setup_input()
  */
 int main(int argc, char* argv[])
 {
-    // 1. Get Dictionary Configuration First
-    // We need to know if we are filtering history BEFORE we load the data.
+    if (!parse_command_line(argc, argv)) return -1;
+
+    // Offline tools: no dictionary load, no prompts
+    if (g_generate_dictionary_spec != NULL)
+    {
+        synthetic_dictionary_spec_t spec;
+        if (!parse_synthetic_spec(g_generate_dictionary_spec, &spec))
+        {
+            printf("Expected --generate-dictionary=N[,seed[,english|uniform|skewed]].\n");
+            return -1;
+        }
+        dictionary_entry_t* p_synthetic = NULL;
+        int synthetic_count = 0;
+        if (!generate_synthetic_dictionary(&spec, &p_synthetic, &synthetic_count)) return -1;
+
+        char path[96];
+        sprintf_s(path, sizeof(path), "Synthetic_%d_%llu_%s.txt", synthetic_count, spec.seed, letter_model_name(spec.letter_model));
+        bool is_written = write_dictionary_file(path, p_synthetic, synthetic_count);
+        if (is_written) printf("Wrote %d words to %s (load it with --dictionary=%s).\n", synthetic_count, path, path);
+        tracked_free(p_synthetic);
+        return is_written ? 0 : -1;
+    }
+
+    // Pin the workers before any OpenMP team, or the tuner's default thread count, exists
+    if (g_placement_policy != PLACEMENT_DEFAULT)
+    {
+        apply_thread_placement(g_placement_policy);
+        print_thread_placement(g_placement_policy);
+    }
+    if (g_isVerifyMode)
+    {
+        // The dictionary file as-is (no used-word filter), or a synthetic one if it cannot be read
+        dictionary_entry_t* p_verify_dictionary = NULL;
+        int verify_count = 0;
+        if (!read_dictionary_file(&p_verify_dictionary, &verify_count))
+        {
+            synthetic_dictionary_spec_t spec = { 3000, g_verify_seed, SYNTHETIC_LETTERS_ENGLISH };
+            printf("Verifying on a synthetic dictionary instead.\n");
+            if (!generate_synthetic_dictionary(&spec, &p_verify_dictionary, &verify_count)) return -1;
+        }
+        g_isInteractivePlay = false;
+        bool is_verified = run_differential_verification(p_verify_dictionary, verify_count, g_verify_seed);
+        tracked_free(p_verify_dictionary);
+        return is_verified ? 0 : 1;
+    }
+    if (g_isPgoTraining)
+    {
+        // Same inputs on every run: the dictionary file (or a fixed synthetic one),
+        // default engine settings (no tuning file), no history download.
+        dictionary_entry_t* p_train_dictionary = NULL;
+        int train_count = 0;
+        if (!read_dictionary_file(&p_train_dictionary, &train_count))
+        {
+            synthetic_dictionary_spec_t spec = { 6000, 1, SYNTHETIC_LETTERS_ENGLISH };
+            printf("Training on a synthetic dictionary instead.\n");
+            if (!generate_synthetic_dictionary(&spec, &p_train_dictionary, &train_count)) return -1;
+        }
+        g_isInteractivePlay = false;
+        run_pgo_training(p_train_dictionary, train_count, g_pgo_train_words);
+        set_allocation_phase(ALLOC_PHASE_SHUTDOWN);
+        print_memory_report();
+        tracked_free(p_train_dictionary);
+        print_allocation_report();
+        return 0;
+    }
+    if (g_isPlacementBenchmark)
+    {
+        dictionary_entry_t* p_bench_dictionary = NULL;
+        int bench_count = 0;
+        if (!read_dictionary_file(&p_bench_dictionary, &bench_count))
+        {
+            synthetic_dictionary_spec_t spec = { 6000, 1, SYNTHETIC_LETTERS_ENGLISH };
+            printf("Benchmarking on a synthetic dictionary instead.\n");
+            if (!generate_synthetic_dictionary(&spec, &p_bench_dictionary, &bench_count)) return -1;
+        }
+        g_isInteractivePlay = false;
+        run_placement_benchmark(p_bench_dictionary, bench_count);
+        set_allocation_phase(ALLOC_PHASE_SHUTDOWN);
+        print_memory_report();
+        tracked_free(p_bench_dictionary);
+        print_allocation_report();
+        return 0;
+    }
+    if (g_isScaleBenchmark)
+    {
+        g_isInteractivePlay = false;
+        run_scale_benchmark(g_scale_sizes, g_scale_size_count, g_scale_letter_model, g_isPerfCountersRequested);
+        set_allocation_phase(ALLOC_PHASE_SHUTDOWN);
+        print_memory_report();
+        print_allocation_report();
+        return 0;
+    }
+
+    // 1. Get Dictionary Configuration
+    // The heavy loading starts first and runs while the user answers; whether
+    // to filter history is only applied once the answers are in.
+    start_startup_pipeline();
     bool filter_history = get_game_setup_input();
 
     // 2. Load the Master Dictionary
-    if (load_dictionary(&g_p_dictionary, &g_dictionary_word_count, filter_history))
+    if (finish_startup_pipeline(filter_history, g_isReplayMode && g_history_path == NULL, &g_p_dictionary, &g_dictionary_word_count))
     {
         dictionary_entry_t* p_possibleAnswers_data = NULL;
         int possibleAnswers_count = g_dictionary_word_count;
         dictionary_pointer_array_t p_possibleAnswersSortedByEntropy = NULL;
         dictionary_pointer_array_t p_possibleAnswersSortedByRank = NULL;
 
+        // The batch modes score the same guesses thousands of times: cache their pattern rows.
+        // (Before the working copy below, so the copy carries the cache stamps.)
+        pattern_cache_t pattern_cache;
+        memset(&pattern_cache, 0, sizeof(pattern_cache));
+        if (!g_isInteractivePlay)
+        {
+            if (init_pattern_cache(&pattern_cache, g_p_dictionary, g_dictionary_word_count, (size_t)PATTERN_CACHE_DEFAULT_BUDGET_MB * 1024 * 1024)) g_p_pattern_cache = &pattern_cache;
+            else printf("Warning: Failed to allocate the pattern cache. Patterns will be computed directly.\n");
+        }
+
+        // Kernel, tile size and threads for this machine: from the tuning file, or measured now.
+        // Interactive play never waits for a calibration unless asked to.
+        select_tuning_config(g_p_dictionary, g_dictionary_word_count, !g_isInteractivePlay, g_isTuneRequested);
+
+        // Decided positions shared with other processes on this host (optional)
+        shared_state_cache_t shared_cache;
+        memset(&shared_cache, 0, sizeof(shared_cache));
+        if (!g_isInteractivePlay && g_shared_cache_path != NULL)
+        {
+            unsigned long long version = compute_shared_cache_version(g_p_dictionary, g_dictionary_word_count, g_isHardMode, g_decision_budget_ms);
+            if (open_shared_state_cache(&shared_cache, g_shared_cache_path, version)) g_p_shared_cache = &shared_cache;
+        }
+
+        // Parallel games that reach the same position at once share one decision
+        single_flight_t single_flight;
+        memset(&single_flight, 0, sizeof(single_flight));
+        if (!g_isInteractivePlay && !g_isFibbleMode && init_single_flight(&single_flight)) g_p_single_flight = &single_flight;
+
         // 3. Create Working Copy
         // We duplicate the dictionary data because the game logic modifies the 'is_eliminated' flags.
-        p_possibleAnswers_data = (dictionary_entry_t*)malloc(sizeof(dictionary_entry_t) * possibleAnswers_count);
-        if (p_possibleAnswers_data == NULL) { printf("Failed to allocate memory.\n"); free(g_p_dictionary); return -1; }
+        p_possibleAnswers_data = (dictionary_entry_t*)tracked_malloc(sizeof(dictionary_entry_t) * possibleAnswers_count);
+        if (p_possibleAnswers_data == NULL) { printf("Failed to allocate memory.\n"); tracked_free(g_p_dictionary); return -1; }
         memcpy(p_possibleAnswers_data, g_p_dictionary, sizeof(dictionary_entry_t) * possibleAnswers_count);
 
         // 4. Create Initial Views
@@ -539,7 +1024,38 @@ int main(int argc, char* argv[])
         duplicate_dictionary_pointers(p_possibleAnswers_data, possibleAnswers_count, &p_possibleAnswersSortedByRank, compare_dictionary_entries_by_rank_desc);
 
         // 5. Launch Mode
-        if (g_isInteractivePlay)
+        if (g_isReplayMode)
+        {
+            // The replay needs the answer history even though the dictionary was loaded unfiltered.
+            // A history file gives the real day order; the scraped page only an assumed one.
+            if (g_history_path != NULL)
+            {
+                char* p_history = NULL;
+                int history_count = 0;
+                bool is_dated = false;
+                if (load_answer_history_file(g_history_path, &p_history, &history_count, &is_dated))
+                {
+                    printf("Answer history: %d answers from %s, in %s order.\n", history_count, g_history_path, is_dated ? "date" : "file");
+                    run_historical_replay(g_p_dictionary, g_dictionary_word_count, p_history, history_count);
+                }
+                tracked_free(p_history);
+            }
+            else if (g_p_used_words_history == NULL && !load_used_words(&g_p_used_words, &g_used_word_count))
+            {
+                printf("Failed to load used words. Historical Replay needs the answer history.\n");
+            }
+            else if (g_p_used_words_history != NULL)
+            {
+                printf("Answer history: %d answers in the order the source page lists them. The page is not dated, so this is\n", g_used_word_count);
+                printf("only ASSUMED to be the day order. Pass --history=file (one 'YYYY-MM-DD WORD' per line) for a dated replay.\n");
+                if (is_word_list_alphabetical(g_p_used_words_history, g_used_word_count))
+                {
+                    printf("Warning: The page lists the answers alphabetically. 'Day N' is not the Nth puzzle, and the pool shrinks in the wrong order.\n");
+                }
+                run_historical_replay(g_p_dictionary, g_dictionary_word_count, g_p_used_words_history, g_used_word_count);
+            }
+        }
+        else if (g_isInteractivePlay)
         {
             printf("\nStarting Interactive Wordle Solver...\n");
             run_interactive_mode(p_possibleAnswers_data, possibleAnswers_count, &p_possibleAnswersSortedByEntropy, &p_possibleAnswersSortedByRank);
@@ -552,10 +1068,34 @@ int main(int argc, char* argv[])
         }
 
         // 6. Cleanup
-        if (p_possibleAnswersSortedByEntropy != NULL)  free(p_possibleAnswersSortedByEntropy);
-        if (p_possibleAnswersSortedByRank != NULL)  free(p_possibleAnswersSortedByRank);
-        if (p_possibleAnswers_data != NULL) free(p_possibleAnswers_data);
-        if (g_p_dictionary != NULL) free(g_p_dictionary);
+        set_allocation_phase(ALLOC_PHASE_SHUTDOWN);
+        print_memory_report();
+        if (g_p_shared_cache != NULL)
+        {
+            printf("Shared cache: %lld hits, %lld misses, %lld positions added by this process.\n", shared_cache.hits, shared_cache.misses, shared_cache.inserts);
+            g_p_shared_cache = NULL;
+            close_shared_state_cache(&shared_cache);
+        }
+        if (g_p_single_flight != NULL)
+        {
+            printf("Request coalescing: %lld decisions computed, %lld coalesced onto an identical in-flight decision, %lld uncoalesced (table full, or the leader ran out of budget).\n",
+                single_flight.computed, single_flight.coalesced, single_flight.bypassed);
+            g_p_single_flight = NULL;
+            free_single_flight(&single_flight);
+        }
+        if (g_p_pattern_cache != NULL)
+        {
+            print_pattern_cache_stats(g_p_pattern_cache);
+            g_p_pattern_cache = NULL;
+            free_pattern_cache(&pattern_cache);
+        }
+        if (p_possibleAnswersSortedByEntropy != NULL)  tracked_free(p_possibleAnswersSortedByEntropy);
+        if (p_possibleAnswersSortedByRank != NULL)  tracked_free(p_possibleAnswersSortedByRank);
+        if (p_possibleAnswers_data != NULL) tracked_free(p_possibleAnswers_data);
+        if (g_p_dictionary != NULL) tracked_free(g_p_dictionary);
+
+        // After the cleanup, so "still live" is what the run never freed
+        print_allocation_report();
     }
     else
     {
@@ -0,0 +1,241 @@
+/*
+ * FILE: memory_budget.cpp
+ *
+ * WHAT:
+ * Implements the Memory Budget Manager.
+ *
+ * HOW:
+ * A small fixed table of consumers behind one lock. Reclaiming walks the
+ * consumers from the lowest priority up and calls their shrink callbacks
+ * until enough is free.
+ *
+ * WHY:
+ * Reservations happen a handful of times per run (at table and cache
+ * creation, once per thread), never in a hot loop, so a single lock and a
+ * linear scan are all this needs.
+ */
+
+#include "memory_budget.h"
+#include "platform_compat.h"
+#include <stdio.h>
+#include <string.h>
+#include <omp.h>
+
+/*
+ * STRUCT: memory_consumer_t
+ */
+typedef struct _memory_consumer
+{
+    char name[32];
+    int priority;
+    memory_shrink_fn shrink_fn;
+    memory_stats_fn stats_fn;
+    void* p_context;
+    size_t bytes_used;
+    size_t bytes_peak;
+    size_t bytes_reclaimed;
+} memory_consumer_t;
+
+/*
+ * STATICS: Manager State
+ */
+static memory_consumer_t s_consumers[MAX_MEMORY_CONSUMERS];
+static int s_consumer_count = 0;
+static size_t s_budget_bytes = 0;
+static size_t s_total_bytes = 0;
+static size_t s_total_peak = 0;
+static omp_lock_t s_lock;
+static bool s_is_lock_ready = false;
+
+/*
+ * HELPER: lock_manager
+ *
+ * WHY:
+ * The first registration may come from a startup worker thread, so the
+ * lock is created on first use inside a named critical section.
+ */
+static void lock_manager()
+{
+#pragma omp critical(memory_budget_init)
+    {
+        if (!s_is_lock_ready) { omp_init_lock(&s_lock); s_is_lock_ready = true; }
+    }
+    omp_set_lock(&s_lock);
+}
+
+/*
+ * HELPER: add_bytes
+ */
+static void add_bytes(memory_consumer_t* p_consumer, size_t bytes)
+{
+    p_consumer->bytes_used += bytes;
+    if (p_consumer->bytes_used > p_consumer->bytes_peak) p_consumer->bytes_peak = p_consumer->bytes_used;
+    s_total_bytes += bytes;
+    if (s_total_bytes > s_total_peak) s_total_peak = s_total_bytes;
+}
+
+/*
+ * HELPER: bytes_available
+ */
+static size_t bytes_available()
+{
+    if (s_budget_bytes == 0) return (size_t)-1;
+    return (s_total_bytes < s_budget_bytes) ? s_budget_bytes - s_total_bytes : 0;
+}
+
+/*
+ * HELPER: reclaim_below
+ *
+ * WHAT:
+ * Shrinks consumers with priority below `priority`, lowest first, until
+ * `bytes_needed` are available. Returns true if they are.
+ */
+static bool reclaim_below(int priority, size_t bytes_needed)
+{
+    for (int level = 0; level < priority && bytes_available() < bytes_needed; level++)
+    {
+        for (int i = 0; i < s_consumer_count && bytes_available() < bytes_needed; i++)
+        {
+            memory_consumer_t* p_victim = &s_consumers[i];
+            if (p_victim->priority != level || p_victim->shrink_fn == NULL || p_victim->bytes_used == 0) continue;
+
+            size_t freed = p_victim->shrink_fn(p_victim->p_context, bytes_needed - bytes_available());
+            if (freed > p_victim->bytes_used) freed = p_victim->bytes_used;
+            p_victim->bytes_used -= freed;
+            p_victim->bytes_reclaimed += freed;
+            s_total_bytes -= freed;
+        }
+    }
+    return bytes_available() >= bytes_needed;
+}
+
+/*
+ * FUNCTION: set_memory_budget
+ */
+void set_memory_budget(size_t budget_bytes)
+{
+    lock_manager();
+    s_budget_bytes = budget_bytes;
+    omp_unset_lock(&s_lock);
+}
+
+/*
+ * FUNCTION: register_memory_consumer
+ */
+int register_memory_consumer(const char* name, int priority, memory_shrink_fn shrink_fn, memory_stats_fn stats_fn, void* p_context)
+{
+    lock_manager();
+    int id = -1;
+    for (int i = 0; i < s_consumer_count; i++)
+    {
+        if (strcmp(s_consumers[i].name, name) == 0) { id = i; break; }
+    }
+    if (id < 0 && s_consumer_count < MAX_MEMORY_CONSUMERS)
+    {
+        id = s_consumer_count++;
+        memset(&s_consumers[id], 0, sizeof(memory_consumer_t));
+        strcpy_s(s_consumers[id].name, sizeof(s_consumers[id].name), name);
+    }
+    if (id >= 0)
+    {
+        s_consumers[id].priority = priority;
+        s_consumers[id].shrink_fn = shrink_fn;
+        s_consumers[id].stats_fn = stats_fn;
+        s_consumers[id].p_context = p_context;
+    }
+    omp_unset_lock(&s_lock);
+    return id;
+}
+
+/*
+ * FUNCTION: unregister_memory_consumer
+ */
+void unregister_memory_consumer(int consumer_id)
+{
+    if (consumer_id < 0) return;
+    lock_manager();
+    s_consumers[consumer_id].shrink_fn = NULL;
+    s_consumers[consumer_id].stats_fn = NULL;
+    s_consumers[consumer_id].p_context = NULL;
+    omp_unset_lock(&s_lock);
+}
+
+/*
+ * FUNCTION: memory_budget_reserve
+ */
+size_t memory_budget_reserve(int consumer_id, size_t wanted_bytes)
+{
+    if (consumer_id < 0) return wanted_bytes;
+    lock_manager();
+    memory_consumer_t* p_consumer = &s_consumers[consumer_id];
+    reclaim_below(p_consumer->priority, wanted_bytes);
+
+    size_t granted = bytes_available();
+    if (granted > wanted_bytes) granted = wanted_bytes;
+    add_bytes(p_consumer, granted);
+    omp_unset_lock(&s_lock);
+    return granted;
+}
+
+/*
+ * FUNCTION: memory_budget_charge
+ */
+void memory_budget_charge(int consumer_id, size_t bytes)
+{
+    if (consumer_id < 0 || bytes == 0) return;
+    lock_manager();
+    memory_consumer_t* p_consumer = &s_consumers[consumer_id];
+    reclaim_below(p_consumer->priority, bytes);
+    add_bytes(p_consumer, bytes);
+    omp_unset_lock(&s_lock);
+}
+
+/*
+ * FUNCTION: memory_budget_release
+ */
+void memory_budget_release(int consumer_id, size_t bytes)
+{
+    if (consumer_id < 0 || bytes == 0) return;
+    lock_manager();
+    memory_consumer_t* p_consumer = &s_consumers[consumer_id];
+    if (bytes > p_consumer->bytes_used) bytes = p_consumer->bytes_used;
+    p_consumer->bytes_used -= bytes;
+    s_total_bytes -= bytes;
+    omp_unset_lock(&s_lock);
+}
+
+/*
+ * FUNCTION: print_memory_report
+ */
+void print_memory_report()
+{
+    const double MB = 1024.0 * 1024.0;
+    lock_manager();
+
+    printf("\n--- Memory Report ---\n");
+    printf("%-22s | %10s | %10s | %10s | %8s\n", "CONSUMER", "NOW (MB)", "PEAK (MB)", "RECLAIMED", "HIT %");
+    for (int i = 0; i < s_consumer_count; i++)
+    {
+        const memory_consumer_t* p_consumer = &s_consumers[i];
+        char hit_str[16] = "-";
+        if (p_consumer->stats_fn != NULL)
+        {
+            long long hits = 0, lookups = 0;
+            p_consumer->stats_fn(p_consumer->p_context, &hits, &lookups);
+            if (lookups > 0) sprintf_s(hit_str, 16, "%.1f", 100.0 * hits / lookups);
+        }
+        printf("%-22s | %10.1f | %10.1f | %10.1f | %8s\n", p_consumer->name,
+            p_consumer->bytes_used / MB, p_consumer->bytes_peak / MB, p_consumer->bytes_reclaimed / MB, hit_str);
+    }
+
+    if (s_budget_bytes == 0)
+    {
+        printf("Total: %.1f MB now, %.1f MB peak (no budget set).\n", s_total_bytes / MB, s_total_peak / MB);
+    }
+    else
+    {
+        printf("Total: %.1f MB now, %.1f MB peak of %.1f MB budget%s.\n", s_total_bytes / MB, s_total_peak / MB, s_budget_bytes / MB,
+            (s_total_peak > s_budget_bytes) ? " (OVER BUDGET: required structures alone exceed it)" : "");
+    }
+    omp_unset_lock(&s_lock);
+}
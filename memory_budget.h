@@ -0,0 +1,131 @@
+/*
+ * FILE: memory_budget.h
+ *
+ * WHAT:
+ * Defines the interface for the Memory Budget Manager, the process-wide
+ * accountant for large allocations. Every cache or precomputed table
+ * registers as a named "consumer" with a priority and reports what it holds:
+ * - Caches RESERVE memory and may be granted less than they asked for. They
+ * provide a shrink callback, so higher-priority consumers can reclaim it.
+ * - Required structures (tables, working sets) CHARGE memory. A charge is
+ * never refused, but first reclaims lower-priority caches to make room.
+ * At the end of a session `print_memory_report` lists every consumer.
+ *
+ * WHY:
+ * Pattern rows, partition tables, snapshots and per-thread working sets each
+ * looked reasonable alone, but together they could exhaust a small machine
+ * with no warning. One budget (`--memory-budget=MB`) and one report make
+ * the total visible and let the optional caches give way to what the run
+ * actually needs.
+ */
+
+#pragma once
+#ifndef MEMORY_BUDGET_H
+#define MEMORY_BUDGET_H
+#include <stddef.h>
+
+/*
+ * CONSTANTS: Consumer Priorities
+ *
+ * WHAT:
+ * Under pressure, memory is reclaimed from the LOWEST priority first, and
+ * only on behalf of a consumer with a strictly higher priority.
+ * - CACHE: Pure speed-ups (dropping an entry only costs a recomputation).
+ * - REQUIRED: The run cannot continue without it. Never reclaimed.
+ */
+#define MEMORY_PRIORITY_CACHE 1
+#define MEMORY_PRIORITY_REQUIRED 3
+
+/*
+ * CONSTANT: MAX_MEMORY_CONSUMERS
+ */
+#define MAX_MEMORY_CONSUMERS 16
+
+/*
+ * TYPE: memory_shrink_fn
+ *
+ * WHAT:
+ * Asks a consumer to free about `bytes_wanted` bytes. Returns the bytes
+ * actually freed (the manager lowers the consumer's reservation by that).
+ * Called with the manager's lock held: must not call back into the manager.
+ */
+typedef size_t (*memory_shrink_fn)(void* p_context, size_t bytes_wanted);
+
+/*
+ * TYPE: memory_stats_fn
+ *
+ * WHAT:
+ * Reports a consumer's hit statistics for the report (optional).
+ */
+typedef void (*memory_stats_fn)(void* p_context, long long* p_hits, long long* p_lookups);
+
+/*
+ * FUNCTION: set_memory_budget
+ *
+ * WHAT:
+ * Sets the process-wide budget in bytes. 0 = unlimited (accounting only).
+ */
+void set_memory_budget(size_t budget_bytes);
+
+/*
+ * FUNCTION: register_memory_consumer
+ *
+ * WHAT:
+ * Registers (or looks up, by `name`) a consumer and returns its id.
+ * Re-registering an existing name replaces its callbacks.
+ *
+ * RETURNS:
+ * - The consumer id, or -1 if the table is full (the caller is then simply
+ * not accounted for).
+ */
+int register_memory_consumer(const char* name, int priority, memory_shrink_fn shrink_fn, memory_stats_fn stats_fn, void* p_context);
+
+/*
+ * FUNCTION: unregister_memory_consumer
+ *
+ * WHAT:
+ * Detaches the callbacks (the consumer is being destroyed). Its peak usage
+ * stays in the report.
+ */
+void unregister_memory_consumer(int consumer_id);
+
+/*
+ * FUNCTION: memory_budget_reserve
+ *
+ * WHAT:
+ * Grants up to `wanted_bytes` to a cache, after reclaiming lower-priority
+ * consumers if needed.
+ *
+ * RETURNS:
+ * - The bytes granted (possibly fewer than wanted, possibly 0).
+ */
+size_t memory_budget_reserve(int consumer_id, size_t wanted_bytes);
+
+/*
+ * FUNCTION: memory_budget_charge
+ *
+ * WHAT:
+ * Records `bytes` for a required structure, reclaiming lower-priority
+ * consumers first if the budget is short. Never refuses: a run that needs
+ * more than the budget shows up as over budget in the report.
+ */
+void memory_budget_charge(int consumer_id, size_t bytes);
+
+/*
+ * FUNCTION: memory_budget_release
+ *
+ * WHAT:
+ * Returns `bytes` previously reserved or charged.
+ */
+void memory_budget_release(int consumer_id, size_t bytes);
+
+/*
+ * FUNCTION: print_memory_report
+ *
+ * WHAT:
+ * Per consumer: current and peak bytes, bytes reclaimed under pressure, and
+ * hit rate (if reported). Followed by the process total against the budget.
+ */
+void print_memory_report();
+
+#endif
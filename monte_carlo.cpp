@@ -26,6 +26,20 @@
 #include "duplicate_dictionary.h"
 #include "comparators.h"
 #include "hybrid_strategies.h" 
+#include "dictionary_mutation.h"
+#include "load_used_words.h"
+#include "noise_filter.h"
+#include "memory_budget.h"
+#include "shared_state_cache.h"
+#include "auto_tuner.h"
+#include "pattern_cache.h"
+#include "dictionary_generator.h"
+#include "single_flight.h"
+#include "latency_histogram.h"
+#include "perf_counters.h"
+#include "trace_probes.h"
+#include "alloc_tracker.h"
+#include "thread_placement.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -34,6 +48,47 @@
 
 #define MAX_GUESSES 6
 extern bool g_isHardMode;
+extern bool g_isFibbleMode;
+
+/*
+ * STRUCT: decision_totals_t
+ *
+ * WHAT:
+ * Anytime-decision reports (`get_anytime_hybrid_guess`) summed over the
+ * Smart Strategy decisions of a run.
+ */
+typedef struct _decision_totals
+{
+    long long decisions;
+    long long deadline_hits;
+    long long lookahead_evaluated;
+    long long lookahead_total;
+    double total_ms;
+    double max_ms;
+} decision_totals_t;
+
+/*
+ * HELPER: add_decision_report / merge_decision_totals
+ */
+static void add_decision_report(decision_totals_t* p_totals, const decision_report_t* p_report)
+{
+    p_totals->decisions++;
+    if (p_report->is_deadline_hit) p_totals->deadline_hits++;
+    p_totals->lookahead_evaluated += p_report->lookahead_evaluated;
+    p_totals->lookahead_total += p_report->lookahead_total;
+    p_totals->total_ms += p_report->elapsed_ms;
+    if (p_report->elapsed_ms > p_totals->max_ms) p_totals->max_ms = p_report->elapsed_ms;
+}
+
+static void merge_decision_totals(decision_totals_t* p_totals, const decision_totals_t* p_other)
+{
+    p_totals->decisions += p_other->decisions;
+    p_totals->deadline_hits += p_other->deadline_hits;
+    p_totals->lookahead_evaluated += p_other->lookahead_evaluated;
+    p_totals->lookahead_total += p_other->lookahead_total;
+    p_totals->total_ms += p_other->total_ms;
+    if (p_other->max_ms > p_totals->max_ms) p_totals->max_ms = p_other->max_ms;
+}
 
 /*
  * STRUCT: SimStats
@@ -46,6 +101,7 @@ extern bool g_isHardMode;
  * - guess_distribution: Histogram (How many games won in 1, 2, 3..6 guesses).
  * - average_guesses: The primary "Efficiency" metric.
  * - time_taken: Wall-clock time for the sim (performance benchmarking).
+ * - decisions: Latency and Look Ahead coverage of the Smart Strategy decisions.
  */
 typedef struct _sim_stats
 {
@@ -57,6 +113,7 @@ typedef struct _sim_stats
     double average_guesses;
     double win_percent;
     double time_taken;
+    decision_totals_t decisions;
 } SimStats;
 
 /*
@@ -86,6 +143,417 @@ void print_distribution(SimStats* s)
     printf("\n");
 }
 
+/*
+ * FUNCTION: print_decision_budget_table
+ *
+ * WHAT:
+ * Under `--decision-budget-ms`: per strategy, the Smart Strategy decisions,
+ * how many hit the deadline, the share of the Look Ahead shortlist scored,
+ * and the mean and worst decision latency (entropy pass included). Read it next to AVG GUESSES to
+ * see what the budget costs in play.
+ */
+static void print_decision_budget_table(const SimStats* p_results, int result_count)
+{
+    printf("\n--- Anytime Decisions (budget %.2f ms) ---\n", g_decision_budget_ms);
+    printf("| %-30s | %-9s | %-13s | %-11s | %-8s | %-8s |\n", "STRATEGY", "DECISIONS", "DEADLINE HITS", "LOOK AHEAD", "AVG ms", "MAX ms");
+    printf("|--------------------------------|-----------|---------------|-------------|----------|----------|\n");
+    for (int i = 0; i < result_count; i++)
+    {
+        const decision_totals_t* d = &p_results[i].decisions;
+        char coverage[16] = "-"; // No Look Ahead in this strategy
+        if (d->lookahead_total > 0) sprintf_s(coverage, sizeof(coverage), "%.1f%%", 100.0 * d->lookahead_evaluated / d->lookahead_total);
+        printf("| %-30s | %9lld | %13lld | %11s | %8.3f | %8.3f |\n", p_results[i].strategy_name, d->decisions, d->deadline_hits,
+            coverage, (d->decisions > 0) ? d->total_ms / d->decisions : 0.0, d->max_ms);
+    }
+}
+
+/*
+ * STRUCT: turn2_cache_t
+ *
+ * WHAT:
+ * Memoizes the Turn 2 decision for each of the 243 possible opener patterns.
+ *
+ * WHY:
+ * With a fixed opener, every game that receives the same first pattern is in
+ * exactly the same state (same valid answers, same letter minimums), so the
+ * Turn 2 guess is identical. The Historical Replay plays hundreds of games
+ * against a pool that only loses one word per day, so most of these decisions
+ * can be reused from one day to the next. Only the buckets containing the
+ * removed answer (one, or in Fibble every bucket one lie away from its
+ * true pattern) and any bucket whose cached guess WAS the removed word
+ * need to be recomputed (for plain selection; see
+ * `is_turn2_memo_kept_on_removal`).
+ *
+ * `generation` is the pool generation (`mutable_dictionary_t`) the entries
+ * are current for. The replay advances it after invalidating for a
+ * retirement; any other mismatch means an unaccounted mutation and clears
+ * the memo.
+ */
+typedef struct _turn2_cache
+{
+    bool is_valid[MAX_PATTERNS];
+    char guess[MAX_PATTERNS][WORDLE_WORD_LENGTH + 1];
+    unsigned int generation;
+} turn2_cache_t;
+
+/*
+ * FUNCTION: determine_opening_word
+ *
+ * WHAT:
+ * Picks the first guess for a strategy, given a dictionary whose `entropy_score`
+ * fields already hold the opener entropy.
+ * 1. Manual override (e.g., "SALET").
+ * 2. Simple strategies: top word of the configured category.
+ * 3. Smart strategies: `get_smart_hybrid_guess` for Turn 1.
+ *
+ * WHY:
+ * Shared by the tournament (which computes opener entropy from scratch) and
+ * the Historical Replay (which keeps it up to date incrementally).
+ */
+static void determine_opening_word(const HybridConfig* p_config, dictionary_entry_t* p_opener_data, int count, char* opening_word)
+{
+    dictionary_pointer_array_t p_view_ent = NULL;
+    dictionary_pointer_array_t p_view_rank = NULL;
+    int init_req_counts[26] = { 0 };
+
+    duplicate_dictionary_pointers(p_opener_data, count, &p_view_ent, compare_dictionary_entries_by_entropy_desc);
+    duplicate_dictionary_pointers(p_opener_data, count, &p_view_rank, compare_dictionary_entries_by_rank_desc);
+
+    // Check for Manual Override (e.g., "SALET")
+    if (p_config->opener_override_word != NULL)
+    {
+        strcpy_s(opening_word, 6, p_config->opener_override_word);
+    }
+    // Check for Simple Strategies (Index 0-3)
+    else if (p_config->base_strategy_index != -1)
+    {
+        recommendations_array_t opening_recs;
+        get_best_guess_candidates(p_view_ent, p_view_rank, count, opening_recs);
+        strcpy_s(opening_word, 6, opening_recs[p_config->base_strategy_index].pEntry->word);
+    }
+    // Default: Use the Smart Hybrid Calculator
+    else
+    {
+        const dictionary_entry_t* pOpener = get_smart_hybrid_guess(p_view_ent, p_view_rank, count, p_config, init_req_counts, count, 1);
+        strcpy_s(opening_word, 6, pOpener->word);
+    }
+
+    tracked_free(p_view_ent); tracked_free(p_view_rank);
+}
+
+/*
+ * FUNCTION: play_simulated_game
+ *
+ * WHAT:
+ * Plays one full game (up to 6 guesses) of `p_config` against `target_word`.
+ *
+ * PARAMETERS:
+ * - p_master_dictionary / master_count: The pool the game starts from.
+ * - opening_word: The precomputed Turn 1 guess.
+ * - p_thread_data / pp_thread_valid: Caller-owned scratch buffers sized for
+ * `master_count` (reused across games to avoid malloc churn).
+ * - p_turn2_cache: Optional Turn 2 memo (NULL to disable).
+ * - p_guesses_taken: Output. The number of guesses used.
+ * - p_guess_log: Optional output, one guess per turn played (NULL to skip).
+ * - p_decisions: Optional accumulator for the Smart Strategy decision reports (NULL to skip).
+ * - p_latency: Optional recommendation latency histograms (NULL to skip).
+ *
+ * RETURNS:
+ * - true if the bot found the target within 6 guesses.
+ *
+ * WHY:
+ * Both the tournament and the Historical Replay need the exact same game
+ * logic. Keeping it in one place guarantees their results are comparable.
+ */
+static bool play_simulated_game(const HybridConfig* p_config,
+    const dictionary_entry_t* p_master_dictionary, int master_count,
+    const dictionary_entry_t* target_word, const char* opening_word,
+    dictionary_entry_t* p_thread_data, dictionary_entry_t** pp_thread_valid,
+    turn2_cache_t* p_turn2_cache, int* p_guesses_taken, char (*p_guess_log)[WORDLE_WORD_LENGTH + 1],
+    decision_totals_t* p_decisions, decision_latency_t* p_latency)
+{
+    const HybridConfig config = *p_config;
+    dictionary_pointer_array_t p_thread_view_ent = NULL;
+    dictionary_pointer_array_t p_thread_view_rank = NULL;
+
+    // Reset: Copy fresh dictionary state for the new game
+    memcpy(p_thread_data, p_master_dictionary, sizeof(dictionary_entry_t) * master_count);
+    int current_count = master_count;
+
+    // Candidate-set identity, kept current by the filter (one XOR per eliminated word)
+    game_state_t state;
+    init_game_state(&state, p_thread_data, master_count);
+
+    // Positions are only shareable when the feedback is truthful (a Fibble
+    // position also depends on each word's mismatch count).
+    bool use_shared_cache = (g_p_shared_cache != NULL && !g_isFibbleMode);
+    bool use_single_flight = (g_p_single_flight != NULL && !g_isFibbleMode);
+    unsigned long long pool_hash = state.candidate_hash;
+
+    char current_guess[6];
+    strcpy_s(current_guess, 6, opening_word);
+
+    int min_required_counts[26] = { 0 };
+    bool won = false;
+    int guesses_taken = 0;
+    TRACE_GAME_START(target_word->word, config.name);
+
+    // Recommendation latency: a decision runs from the feedback to the start
+    // of the next turn (the memo, cache and coalescing exits all `continue`).
+    double decision_start = 0.0;
+
+    // GAME LOOP (Turns 1-6)
+    for (int turn = 1; turn <= MAX_GUESSES; turn++)
+    {
+        if (decision_start > 0.0)
+        {
+            record_decision_latency(p_latency, turn, state.candidate_count, (omp_get_wtime() - decision_start) * 1000.0);
+            decision_start = 0.0;
+        }
+        guesses_taken = turn;
+        if (p_guess_log != NULL) strcpy_s(p_guess_log[turn - 1], WORDLE_WORD_LENGTH + 1, current_guess);
+
+        // Check for Win
+        if (strncmp(current_guess, target_word->word, 5) == 0) { won = true; break; }
+
+        // The guess after the sixth is never played, so its decision is not a recommendation.
+        if (p_latency != NULL && turn < MAX_GUESSES) decision_start = omp_get_wtime();
+
+        // Generate Feedback (Simulate the Game Engine)
+        // In Fibble mode, one tile of every row is a lie.
+        int observed_code = get_feedback_index(current_guess, target_word->word);
+        if (g_isFibbleMode) observed_code = inject_feedback_lie(observed_code, target_word->word, turn);
+
+        // Update Logic State
+        if (g_isFibbleMode)
+        {
+            // Letter minimums cannot be trusted when any tile may be a lie.
+            apply_noisy_feedback(p_thread_data, current_count, current_guess, observed_code, &FIBBLE_NOISE_MODEL);
+            init_game_state(&state, p_thread_data, current_count);
+        }
+        else
+        {
+            char result_pattern[6];
+            decode_feedback_index(observed_code, result_pattern);
+            update_min_required_counts(current_guess, result_pattern, min_required_counts);
+            filter_dictionary_by_constraints(p_thread_data, current_count, current_guess, result_pattern, &state);
+        }
+#ifdef _DEBUG
+        if (!verify_game_state(&state, p_thread_data, current_count)) printf("Warning: Candidate-set hash drifted from the full rehash (turn %d).\n", turn);
+#endif
+
+        // Determine Next Guess (Logic differs slightly for Hard/Normal mode optimization)
+        bool use_normal_mode_scan = (!g_isHardMode && (config.base_strategy_index == -1 || config.base_strategy_index <= 1));
+
+        if (use_normal_mode_scan)
+        {
+            // --- TURN 2 MEMO ---
+            // After the opener, the state depends only on the first (observed) pattern.
+            int opener_pattern = -1;
+            if (turn == 1 && p_turn2_cache != NULL)
+            {
+                opener_pattern = observed_code;
+                TRACE_CACHE_LOOKUP(TRACE_CACHE_TURN2_MEMO, p_turn2_cache->is_valid[opener_pattern] ? 1 : 0);
+                if (p_turn2_cache->is_valid[opener_pattern])
+                {
+                    strcpy_s(current_guess, 6, p_turn2_cache->guess[opener_pattern]);
+                    TRACE_TURN_DECISION(turn, state.candidate_count, current_guess, TRACE_DECISION_TURN2_MEMO);
+                    continue;
+                }
+            }
+
+            // NORMAL MODE: We scan all words, even invalid ones (for burner value).
+            int validCount = 0;
+            for (int i = 0; i < master_count; ++i) { if (!p_thread_data[i].is_eliminated) pp_thread_valid[validCount++] = &p_thread_data[i]; }
+            if (validCount == 0) break; // Should not happen
+
+            // --- SHARED STATE CACHE ---
+            // Another game (in this or another process) may have decided this position already.
+            unsigned long long state_key = 0;
+            if (use_shared_cache)
+            {
+                state_key = make_shared_state_key(pool_hash, state.candidate_hash, turn, min_required_counts, config.name);
+                bool is_shared_hit = shared_state_cache_lookup(g_p_shared_cache, state_key, current_guess);
+                TRACE_CACHE_LOOKUP(TRACE_CACHE_SHARED_STATE, is_shared_hit ? 1 : 0);
+                if (is_shared_hit)
+                {
+                    TRACE_TURN_DECISION(turn, state.candidate_count, current_guess, TRACE_DECISION_SHARED_STATE);
+                    if (opener_pattern >= 0)
+                    {
+                        strcpy_s(p_turn2_cache->guess[opener_pattern], 6, current_guess);
+                        p_turn2_cache->is_valid[opener_pattern] = true;
+                    }
+                    continue;
+                }
+            }
+
+            // --- REQUEST COALESCING ---
+            // Another thread may be deciding this very position right now: wait for its guess.
+            int flight_role = SINGLE_FLIGHT_BYPASS;
+            if (use_single_flight)
+            {
+                if (state_key == 0) state_key = make_shared_state_key(pool_hash, state.candidate_hash, turn, min_required_counts, config.name);
+                flight_role = single_flight_join(g_p_single_flight, state_key, current_guess);
+                if (flight_role == SINGLE_FLIGHT_COALESCED)
+                {
+                    TRACE_TURN_DECISION(turn, state.candidate_count, current_guess, TRACE_DECISION_COALESCED);
+                    if (opener_pattern >= 0)
+                    {
+                        strcpy_s(p_turn2_cache->guess[opener_pattern], 6, current_guess);
+                        p_turn2_cache->is_valid[opener_pattern] = true;
+                    }
+                    continue;
+                }
+            }
+
+            // Calculate Entropy for ALL candidates based on VALID answer probabilities.
+            // A smart decision's budget starts here and bounds this pass too.
+            double decision_start = omp_get_wtime();
+            double entropy_deadline = (config.base_strategy_index == -1 && g_decision_budget_ms > 0.0) ? decision_start + g_decision_budget_ms / 1000.0 : 0.0;
+            bool is_entropy_complete = calculate_entropy_for_candidates_until(p_thread_data, master_count, pp_thread_valid, validCount, entropy_deadline);
+
+            // Sort Views
+            TRACE_SORT_START(TRACE_SORT_ENTROPY_VIEW, master_count);
+            duplicate_dictionary_pointers(p_thread_data, master_count, &p_thread_view_ent, compare_dictionary_entries_by_entropy_no_filter_desc);
+            TRACE_SORT_END(TRACE_SORT_ENTROPY_VIEW, master_count);
+            TRACE_SORT_START(TRACE_SORT_RANK_VIEW, master_count);
+            duplicate_dictionary_pointers(p_thread_data, master_count, &p_thread_view_rank, compare_dictionary_entries_by_rank_desc);
+            TRACE_SORT_END(TRACE_SORT_RANK_VIEW, master_count);
+
+            // --- TURN 2 FORCED GUESS CHECK ---
+            // Implements "Double Barrel" strategies (e.g., SALET -> COURD)
+            bool is_complete = true;
+            if (turn == 1 && config.second_opener_override_word != NULL)
+            {
+                strcpy_s(current_guess, 6, config.second_opener_override_word);
+            }
+            else if (config.base_strategy_index != -1)
+            {
+                // Simple Strategy (Pick index 0)
+                if (config.base_strategy_index == 0)
+                {
+                    // If last turn, must pick a valid word!
+                    if (turn == MAX_GUESSES) { for (int i = 0; i < master_count; ++i) { if (!p_thread_view_ent[i]->is_eliminated) { strcpy_s(current_guess, 6, p_thread_view_ent[i]->word); break; } } }
+                    else { strcpy_s(current_guess, 6, p_thread_view_ent[0]->word); }
+                }
+                else
+                {
+                    for (int i = 0; i < master_count; ++i) { if (!p_thread_view_ent[i]->is_eliminated) { strcpy_s(current_guess, 6, p_thread_view_ent[i]->word); break; } }
+                }
+            }
+            else
+            {
+                // Smart Strategy
+                decision_report_t decision;
+                const dictionary_entry_t* pNext = get_anytime_hybrid_guess(p_thread_view_ent, p_thread_view_rank, master_count, &config, min_required_counts, validCount, turn + 1, decision_start, g_decision_budget_ms, &decision);
+                if (!is_entropy_complete) decision.is_deadline_hit = true;
+                if (p_decisions != NULL) add_decision_report(p_decisions, &decision);
+                is_complete = !decision.is_deadline_hit;
+
+                // Safety: If last turn and bot picked an eliminated burner, force a valid pick
+                if (turn == MAX_GUESSES && pNext->is_eliminated)
+                {
+                    for (int i = 0; i < master_count; ++i) { if (!p_thread_view_rank[i]->is_eliminated) { pNext = p_thread_view_rank[i]; break; } }
+                }
+                strcpy_s(current_guess, 6, pNext->word);
+            }
+            tracked_free(p_thread_view_ent); tracked_free(p_thread_view_rank);
+            TRACE_TURN_DECISION(turn, validCount, current_guess, TRACE_DECISION_COMPUTED);
+
+            // A decision the budget cut short is only this game's best-so-far: the
+            // memo, the coalescer and the shared cache only ever hold complete ones.
+            if (flight_role == SINGLE_FLIGHT_LEADER) single_flight_finish(g_p_single_flight, state_key, is_complete ? current_guess : NULL);
+            if (use_shared_cache && is_complete) shared_state_cache_insert(g_p_shared_cache, state_key, current_guess);
+
+            if (opener_pattern >= 0 && is_complete)
+            {
+                strcpy_s(p_turn2_cache->guess[opener_pattern], 6, current_guess);
+                p_turn2_cache->is_valid[opener_pattern] = true;
+            }
+        }
+        else
+        {
+            // HARD MODE: We physically sort/shrink the array to strictly valid words.
+            TRACE_SORT_START(TRACE_SORT_COMPACTION, current_count);
+            qsort(p_thread_data, current_count, sizeof(dictionary_entry_t), compare_master_entries_eliminated_then_alpha);
+            TRACE_SORT_END(TRACE_SORT_COMPACTION, current_count);
+
+            int new_count = current_count;
+            for (int i = 0; i < current_count; ++i) { if (p_thread_data[i].is_eliminated) { new_count = i; break; } }
+            current_count = new_count;
+            if (current_count == 0) break;
+
+            unsigned long long state_key = 0;
+            if (use_shared_cache)
+            {
+                state_key = make_shared_state_key(pool_hash, state.candidate_hash, turn, min_required_counts, config.name);
+                bool is_shared_hit = shared_state_cache_lookup(g_p_shared_cache, state_key, current_guess);
+                TRACE_CACHE_LOOKUP(TRACE_CACHE_SHARED_STATE, is_shared_hit ? 1 : 0);
+                if (is_shared_hit)
+                {
+                    TRACE_TURN_DECISION(turn, current_count, current_guess, TRACE_DECISION_SHARED_STATE);
+                    continue;
+                }
+            }
+
+            int flight_role = SINGLE_FLIGHT_BYPASS;
+            if (use_single_flight)
+            {
+                if (state_key == 0) state_key = make_shared_state_key(pool_hash, state.candidate_hash, turn, min_required_counts, config.name);
+                flight_role = single_flight_join(g_p_single_flight, state_key, current_guess);
+                if (flight_role == SINGLE_FLIGHT_COALESCED)
+                {
+                    TRACE_TURN_DECISION(turn, current_count, current_guess, TRACE_DECISION_COALESCED);
+                    continue;
+                }
+            }
+
+            TRACE_SORT_START(TRACE_SORT_ENTROPY_VIEW, current_count);
+            duplicate_dictionary_pointers(p_thread_data, current_count, &p_thread_view_ent, compare_dictionary_entries_by_entropy_desc);
+            TRACE_SORT_END(TRACE_SORT_ENTROPY_VIEW, current_count);
+            TRACE_SORT_START(TRACE_SORT_RANK_VIEW, current_count);
+            duplicate_dictionary_pointers(p_thread_data, current_count, &p_thread_view_rank, compare_dictionary_entries_by_rank_desc);
+            TRACE_SORT_END(TRACE_SORT_RANK_VIEW, current_count);
+
+            bool is_complete = true;
+            if (config.base_strategy_index != -1)
+            {
+                recommendations_array_t turn_recs;
+                get_best_guess_candidates(p_thread_view_ent, p_thread_view_rank, current_count, turn_recs);
+                strcpy_s(current_guess, 6, turn_recs[config.base_strategy_index].pEntry->word);
+            }
+            else
+            {
+                decision_report_t decision;
+                const dictionary_entry_t* pNext = get_anytime_hybrid_guess(
+                    p_thread_view_ent,
+                    p_thread_view_rank,
+                    current_count,
+                    &config,
+                    min_required_counts,
+                    current_count,
+                    turn + 1,
+                    0.0,
+                    g_decision_budget_ms,
+                    &decision
+                );
+                if (p_decisions != NULL) add_decision_report(p_decisions, &decision);
+                is_complete = !decision.is_deadline_hit;
+                strcpy_s(current_guess, 6, pNext->word);
+            }
+
+            tracked_free(p_thread_view_ent); tracked_free(p_thread_view_rank);
+            TRACE_TURN_DECISION(turn, current_count, current_guess, TRACE_DECISION_COMPUTED);
+            if (flight_role == SINGLE_FLIGHT_LEADER) single_flight_finish(g_p_single_flight, state_key, is_complete ? current_guess : NULL);
+            if (use_shared_cache && is_complete) shared_state_cache_insert(g_p_shared_cache, state_key, current_guess);
+        }
+    }
+
+    TRACE_GAME_END(target_word->word, guesses_taken, won ? 1 : 0);
+    *p_guesses_taken = guesses_taken;
+    return won;
+}
+
 /*
  * FUNCTION: run_hybrid_strategy
  *
@@ -98,10 +566,7 @@ void print_distribution(SimStats* s)
  * 1. Determine Opener: Calculates the best starting word (or uses override).
  * 2. OpenMP Parallel Region: Spawns threads.
  * 3. Thread Setup: Allocates local memory.
- * 4. Game Loop: For each target word...
- * a. Reset dictionary.
- * b. Guess & Filter (Turns 1-6).
- * c. Record outcome.
+ * 4. Game Loop: For each target word, `play_simulated_game`.
  * 5. Cleanup & Return Stats.
  *
  * WHY:
@@ -114,6 +579,7 @@ static SimStats run_hybrid_strategy(const HybridConfig config, const dictionary_
     strcpy_s(stats.strategy_name, 50, config.name);
     stats.wins = 0; stats.losses = 0; stats.total_guesses = 0;
     for (int i = 0; i <= MAX_GUESSES; i++) stats.guess_distribution[i] = 0;
+    memset(&stats.decisions, 0, sizeof(stats.decisions));
 
     printf(">>> Simulating Bot: %s ...\n", config.name);
 
@@ -122,45 +588,23 @@ static SimStats run_hybrid_strategy(const HybridConfig config, const dictionary_
     // the exact same heavy math 5,000 times in the loop.
     printf("    Determining optimal opening guess...\n");
 
-    dictionary_entry_t* p_opener_data = (dictionary_entry_t*)malloc(sizeof(dictionary_entry_t) * master_count);
+    dictionary_entry_t* p_opener_data = (dictionary_entry_t*)tracked_malloc(sizeof(dictionary_entry_t) * master_count);
     if (!p_opener_data) return stats;
     memcpy(p_opener_data, p_master_dictionary, sizeof(dictionary_entry_t) * master_count);
 
-    dictionary_pointer_array_t p_view_ent = NULL;
-    dictionary_pointer_array_t p_view_rank = NULL;
-
     calculate_entropy_on_dictionary(p_opener_data, master_count);
-    duplicate_dictionary_pointers(p_opener_data, master_count, &p_view_ent, compare_dictionary_entries_by_entropy_desc);
-    duplicate_dictionary_pointers(p_opener_data, master_count, &p_view_rank, compare_dictionary_entries_by_rank_desc);
 
     char opening_word[6];
-    int init_req_counts[26] = { 0 };
-
-    // Check for Manual Override (e.g., "SALET")
-    if (config.opener_override_word != NULL)
-    {
-        strcpy_s(opening_word, 6, config.opener_override_word);
-    }
-    // Check for Simple Strategies (Index 0-3)
-    else if (config.base_strategy_index != -1)
-    {
-        recommendations_array_t opening_recs;
-        get_best_guess_candidates(p_view_ent, p_view_rank, master_count, opening_recs);
-        strcpy_s(opening_word, 6, opening_recs[config.base_strategy_index].pEntry->word);
-    }
-    // Default: Use the Smart Hybrid Calculator
-    else
-    {
-        const dictionary_entry_t* pOpener = get_smart_hybrid_guess(p_view_ent, p_view_rank, master_count, &config, init_req_counts, master_count, 1);
-        strcpy_s(opening_word, 6, pOpener->word);
-    }
+    determine_opening_word(&config, p_opener_data, master_count, opening_word);
     printf("    Opener: %s\n", opening_word);
 
     // Clean up the temporary opener memory
-    free(p_view_ent); free(p_view_rank); free(p_opener_data);
+    tracked_free(p_opener_data);
 
     // --- PHASE 2: PARALLEL SIMULATION LOOP ---
     time_t start_time = time(NULL);
+    decision_latency_t* p_latency = (decision_latency_t*)tracked_calloc(1, sizeof(decision_latency_t));
+    set_allocation_phase(ALLOC_PHASE_PLAY);
 
 #pragma omp parallel
     {
@@ -168,13 +612,19 @@ static SimStats run_hybrid_strategy(const HybridConfig config, const dictionary_
         // Each thread needs its OWN copy of the dictionary.
         // If we shared the master dictionary, Thread A filtering "APPLE" would
         // mess up Thread B trying to find "ZEBRA".
-        dictionary_entry_t* p_thread_data = (dictionary_entry_t*)malloc(sizeof(dictionary_entry_t) * master_count);
-        dictionary_entry_t** pp_thread_valid = (dictionary_entry_t**)malloc(sizeof(dictionary_entry_t*) * master_count);
-        dictionary_pointer_array_t p_thread_view_ent = NULL;
-        dictionary_pointer_array_t p_thread_view_rank = NULL;
+        dictionary_entry_t* p_thread_data = (dictionary_entry_t*)tracked_malloc(sizeof(dictionary_entry_t) * master_count);
+        dictionary_entry_t** pp_thread_valid = (dictionary_entry_t**)tracked_malloc(sizeof(dictionary_entry_t*) * master_count);
+        void* p_thread_profiles = tracked_malloc(entropy_profile_buffer_bytes(master_count));
+        bind_entropy_profile_buffer(p_thread_profiles, master_count);
+        size_t thread_bytes = (sizeof(dictionary_entry_t) + sizeof(dictionary_entry_t*)) * (size_t)master_count + entropy_profile_buffer_bytes(master_count);
+        int memory_id = register_memory_consumer("Thread working sets", MEMORY_PRIORITY_REQUIRED, NULL, NULL, NULL);
+        memory_budget_charge(memory_id, thread_bytes);
 
         // Local stats accumulator to reduce atomic contention
         int local_distribution[MAX_GUESSES + 1] = { 0 };
+        decision_totals_t local_decisions;
+        memset(&local_decisions, 0, sizeof(local_decisions));
+        decision_latency_t* p_local_latency = (p_latency != NULL) ? (decision_latency_t*)tracked_calloc(1, sizeof(decision_latency_t)) : NULL;
 
         if (p_thread_data && pp_thread_valid)
         {
@@ -184,121 +634,9 @@ static SimStats run_hybrid_strategy(const HybridConfig config, const dictionary_
             for (int t = 0; t < master_count; t++)
             {
                 const dictionary_entry_t* target_word = &p_master_dictionary[t];
-
-                // Reset: Copy fresh dictionary state for the new game
-                memcpy(p_thread_data, p_master_dictionary, sizeof(dictionary_entry_t) * master_count);
-                int current_count = master_count;
-
-                char current_guess[6];
-                strcpy_s(current_guess, 6, opening_word);
-
-                int min_required_counts[26] = { 0 };
-                bool won = false;
                 int guesses_taken = 0;
-
-                // GAME LOOP (Turns 1-6)
-                for (int turn = 1; turn <= MAX_GUESSES; turn++)
-                {
-                    guesses_taken = turn;
-
-                    // Check for Win
-                    if (strncmp(current_guess, target_word->word, 5) == 0) { won = true; break; }
-
-                    // Generate Feedback (Simulate the Game Engine)
-                    char result_pattern[6];
-                    get_feedback_pattern(current_guess, target_word->word, result_pattern);
-
-                    // Update Logic State
-                    update_min_required_counts(current_guess, result_pattern, min_required_counts);
-                    filter_dictionary_by_constraints(p_thread_data, current_count, current_guess, result_pattern);
-
-                    // Determine Next Guess (Logic differs slightly for Hard/Normal mode optimization)
-                    bool use_normal_mode_scan = (!g_isHardMode && (config.base_strategy_index == -1 || config.base_strategy_index <= 1));
-
-                    if (use_normal_mode_scan)
-                    {
-                        // NORMAL MODE: We scan all words, even invalid ones (for burner value).
-                        int validCount = 0;
-                        for (int i = 0; i < master_count; ++i) { if (!p_thread_data[i].is_eliminated) pp_thread_valid[validCount++] = &p_thread_data[i]; }
-                        if (validCount == 0) break; // Should not happen
-
-                        // Calculate Entropy for ALL candidates based on VALID answer probabilities
-                        calculate_entropy_for_candidates(p_thread_data, master_count, pp_thread_valid, validCount);
-
-                        // Sort Views
-                        duplicate_dictionary_pointers(p_thread_data, master_count, &p_thread_view_ent, compare_dictionary_entries_by_entropy_no_filter_desc);
-                        duplicate_dictionary_pointers(p_thread_data, master_count, &p_thread_view_rank, compare_dictionary_entries_by_rank_desc);
-
-                        // --- TURN 2 FORCED GUESS CHECK ---
-                        // Implements "Double Barrel" strategies (e.g., SALET -> COURD)
-                        if (turn == 1 && config.second_opener_override_word != NULL)
-                        {
-                            strcpy_s(current_guess, 6, config.second_opener_override_word);
-                        }
-                        else if (config.base_strategy_index != -1)
-                        {
-                            // Simple Strategy (Pick index 0)
-                            if (config.base_strategy_index == 0)
-                            {
-                                // If last turn, must pick a valid word!
-                                if (turn == MAX_GUESSES) { for (int i = 0; i < master_count; ++i) { if (!p_thread_view_ent[i]->is_eliminated) { strcpy_s(current_guess, 6, p_thread_view_ent[i]->word); break; } } }
-                                else { strcpy_s(current_guess, 6, p_thread_view_ent[0]->word); }
-                            }
-                            else
-                            {
-                                for (int i = 0; i < master_count; ++i) { if (!p_thread_view_ent[i]->is_eliminated) { strcpy_s(current_guess, 6, p_thread_view_ent[i]->word); break; } }
-                            }
-                        }
-                        else
-                        {
-                            // Smart Strategy
-                            const dictionary_entry_t* pNext = get_smart_hybrid_guess(p_thread_view_ent, p_thread_view_rank, master_count, &config, min_required_counts, validCount, turn + 1);
-
-                            // Safety: If last turn and bot picked an eliminated burner, force a valid pick
-                            if (turn == MAX_GUESSES && pNext->is_eliminated)
-                            {
-                                for (int i = 0; i < master_count; ++i) { if (!p_thread_view_rank[i]->is_eliminated) { pNext = p_thread_view_rank[i]; break; } }
-                            }
-                            strcpy_s(current_guess, 6, pNext->word);
-                        }
-                        free(p_thread_view_ent); free(p_thread_view_rank);
-                    }
-                    else
-                    {
-                        // HARD MODE: We physically sort/shrink the array to strictly valid words.
-                        qsort(p_thread_data, current_count, sizeof(dictionary_entry_t), compare_master_entries_eliminated_then_alpha);
-
-                        int new_count = current_count;
-                        for (int i = 0; i < current_count; ++i) { if (p_thread_data[i].is_eliminated) { new_count = i; break; } }
-                        current_count = new_count;
-                        if (current_count == 0) break;
-
-                        duplicate_dictionary_pointers(p_thread_data, current_count, &p_thread_view_ent, compare_dictionary_entries_by_entropy_desc);
-                        duplicate_dictionary_pointers(p_thread_data, current_count, &p_thread_view_rank, compare_dictionary_entries_by_rank_desc);
-
-                        if (config.base_strategy_index != -1)
-                        {
-                            recommendations_array_t turn_recs;
-                            get_best_guess_candidates(p_thread_view_ent, p_thread_view_rank, current_count, turn_recs);
-                            strcpy_s(current_guess, 6, turn_recs[config.base_strategy_index].pEntry->word);
-                        }
-                        else
-                        {
-                            const dictionary_entry_t* pNext = get_smart_hybrid_guess(
-                                p_thread_view_ent,
-                                p_thread_view_rank,
-                                current_count,
-                                &config,
-                                min_required_counts,
-                                current_count,
-                                turn + 1
-                            );
-                            strcpy_s(current_guess, 6, pNext->word);
-                        }
-
-                        free(p_thread_view_ent); free(p_thread_view_rank);
-                    }
-                }
+                bool won = play_simulated_game(&config, p_master_dictionary, master_count, target_word, opening_word,
+                    p_thread_data, pp_thread_valid, NULL, &guesses_taken, NULL, &local_decisions, p_local_latency);
 
                 // End of Game: Record Stats
                 if (won)
@@ -327,14 +665,21 @@ static SimStats run_hybrid_strategy(const HybridConfig config, const dictionary_
 #pragma omp critical
         {
             for (int i = 1; i <= MAX_GUESSES; i++) stats.guess_distribution[i] += local_distribution[i];
+            merge_decision_totals(&stats.decisions, &local_decisions);
+            if (p_local_latency != NULL) merge_decision_latency(p_latency, p_local_latency);
         }
+        tracked_free(p_local_latency);
 
         // Clean up thread-local memory
-        if (p_thread_data) free(p_thread_data);
-        if (pp_thread_valid) free(pp_thread_valid);
+        if (p_thread_data) tracked_free(p_thread_data);
+        if (pp_thread_valid) tracked_free(pp_thread_valid);
+        bind_entropy_profile_buffer(NULL, 0);
+        tracked_free(p_thread_profiles);
+        memory_budget_release(memory_id, thread_bytes);
     }
 
     // --- PHASE 3: FINALIZE STATS ---
+    set_allocation_phase(ALLOC_PHASE_SETUP);
     time_t end_time = time(NULL);
     stats.time_taken = difftime(end_time, start_time);
 
@@ -343,6 +688,8 @@ static SimStats run_hybrid_strategy(const HybridConfig config, const dictionary_
     if (master_count > 0) stats.win_percent = ((double)stats.wins / master_count) * 100.0;
 
     printf("    Finished. Wins: %d (%.2f%%) Avg: %.4f\n", stats.wins, stats.win_percent, stats.average_guesses);
+    if (p_latency != NULL) print_decision_latency_report(p_latency, config.name);
+    tracked_free(p_latency);
     return stats;
 }
 
@@ -363,10 +710,16 @@ static SimStats run_hybrid_strategy(const HybridConfig config, const dictionary_
  */
 void run_monte_carlo_simulation(const dictionary_entry_t* p_master_dictionary, int master_count)
 {
+    set_allocation_phase(ALLOC_PHASE_SETUP);
     printf("\n=============================================\n");
     printf("   STARTING ULTIMATE TOURNAMENT\n");
     printf("   Targeting %d words. Mode: %s\n", master_count, g_isHardMode ? "HARD" : "NORMAL");
+    if (g_isFibbleMode) printf("   Variant: FIBBLE (one lie per row)\n");
     printf("   (Parallel Processing Enabled)\n");
+    char tuning[128];
+    format_tuning_config(tuning, sizeof(tuning));
+    printf("   Engine: %s\n", tuning);
+    if (g_decision_budget_ms > 0.0) printf("   Decision budget: %.2f ms per guess (anytime Look Ahead)\n", g_decision_budget_ms);
     printf("=============================================\n\n");
 
     // --- MASTER ROSTER MENU ---
@@ -401,7 +754,7 @@ void run_monte_carlo_simulation(const dictionary_entry_t* p_master_dictionary, i
     };
 
     int roster_size = sizeof(active_roster) / sizeof(active_roster[0]);
-    SimStats* results = (SimStats*)malloc(sizeof(SimStats) * roster_size);
+    SimStats* results = (SimStats*)tracked_malloc(sizeof(SimStats) * roster_size);
 
     // Run the simulations
     for (int i = 0; i < roster_size; ++i)
@@ -443,6 +796,7 @@ void run_monte_carlo_simulation(const dictionary_entry_t* p_master_dictionary, i
         }
     }
     printf("===========================================================================================\n");
+    if (g_decision_budget_ms > 0.0) print_decision_budget_table(results, roster_size);
 
     if (best_idx >= 0)
     {
@@ -462,5 +816,642 @@ void run_monte_carlo_simulation(const dictionary_entry_t* p_master_dictionary, i
         print_distribution(&results[runner_up]);
     }
 
-    free(results);
-}
\ No newline at end of file
+    tracked_free(results);
+}
+
+/*
+ * HELPER: is_turn2_memo_kept_on_removal
+ *
+ * WHAT:
+ * True if retiring a word can only change a Turn 2 decision whose bucket
+ * held the word or whose guess was the word, so the other buckets' memo
+ * entries stay valid.
+ *
+ * WHY:
+ * That holds for plain selection (the first word in Entropy order that
+ * passes the filters). It does not hold once other words are compared in a
+ * window: the Look Ahead shortlist, the rank tie-breaker's best-rank word,
+ * and the fixed scan depths of the coverage, vowel, anchor and heatmap
+ * biases. Removing a word there lets the next one in, and that one can win.
+ */
+static bool is_turn2_memo_kept_on_removal(const HybridConfig* p_config)
+{
+    return p_config->look_ahead_depth == 0 && p_config->rank_priority_tolerance <= 0.0 &&
+        !p_config->prioritize_turn2_coverage && !p_config->prioritize_vowel_contingency &&
+        !p_config->prioritize_new_vowels && !p_config->prioritize_anchors && !p_config->use_heatmap_priority;
+}
+
+/*
+ * FUNCTION: run_historical_replay
+ *
+ * WHAT:
+ * Replays the Wordle history day by day with the Champion strategy.
+ * 1. Starts from the FULL dictionary (no used-word filter).
+ * 2. For each historical answer, in order:
+ * a. Re-derives the opener (and drops the Turn 2 memo if it changed).
+ * b. Plays the day's game against that answer.
+ * c. Retires the answer via the mutation API (O(N) entropy update) and
+ * invalidates the affected Turn 2 memo entries (all of them for strategies
+ * whose choice depends on a window of words).
+ * 3. Prints a day-by-day log and a summary in the tournament format.
+ *
+ * WHY:
+ * The load-time "Used Words" filter only shows today's snapshot. The replay
+ * answers "how would the Champion have done on each day, given the pool as
+ * it was on that day?". Because every shared table is updated incrementally,
+ * hundreds of simulated days cost about as much as one tournament.
+ */
+void run_historical_replay(const dictionary_entry_t* p_master_dictionary, int master_count, const char* p_history_words, int history_count)
+{
+    const HybridConfig config = ALL_STRATEGIES[0];
+    set_allocation_phase(ALLOC_PHASE_SETUP);
+
+    printf("\n=============================================\n");
+    printf("   STARTING HISTORICAL REPLAY\n");
+    printf("   Strategy: %s\n", config.name);
+    printf("   Days: %d  Pool: %d words. Mode: %s\n", history_count, master_count, g_isHardMode ? "HARD" : "NORMAL");
+    if (g_isFibbleMode) printf("   Variant: FIBBLE (one lie per row)\n");
+    char tuning[128];
+    format_tuning_config(tuning, sizeof(tuning));
+    printf("   Engine: %s\n", tuning);
+    if (g_decision_budget_ms > 0.0) printf("   Decision budget: %.2f ms per guess (anytime Look Ahead)\n", g_decision_budget_ms);
+    printf("=============================================\n\n");
+
+    SimStats stats;
+    strcpy_s(stats.strategy_name, 50, config.name);
+    stats.wins = 0; stats.losses = 0; stats.total_guesses = 0;
+    for (int i = 0; i <= MAX_GUESSES; i++) stats.guess_distribution[i] = 0;
+    memset(&stats.decisions, 0, sizeof(stats.decisions));
+
+    // The shrinking pool. The mutation API keeps its opener entropy and
+    // pattern histograms current as answers are retired.
+    mutable_dictionary_t pool;
+    dictionary_entry_t* p_game_data = (dictionary_entry_t*)tracked_malloc(sizeof(dictionary_entry_t) * master_count);
+    dictionary_entry_t** pp_game_valid = (dictionary_entry_t**)tracked_malloc(sizeof(dictionary_entry_t*) * master_count);
+    void* p_game_profiles = tracked_malloc(entropy_profile_buffer_bytes(master_count));
+    turn2_cache_t* p_turn2_cache = (turn2_cache_t*)tracked_calloc(1, sizeof(turn2_cache_t));
+    decision_latency_t* p_latency = (decision_latency_t*)tracked_calloc(1, sizeof(decision_latency_t));
+
+    if (!p_game_data || !pp_game_valid || !p_game_profiles || !p_turn2_cache || !p_latency)
+    {
+        printf("Failed to allocate replay memory.\n");
+        tracked_free(p_game_data); tracked_free(pp_game_valid); tracked_free(p_game_profiles); tracked_free(p_turn2_cache); tracked_free(p_latency);
+        return;
+    }
+
+    // --- PHASE 1: ONE-OFF O(N^2) BUILD ---
+    printf("    Building partition table for %d words...", master_count);
+    fflush(stdout);
+    time_t start_time = time(NULL);
+    if (!init_mutable_dictionary(&pool, p_master_dictionary, master_count))
+    {
+        printf(" Failed.\n");
+        tracked_free(p_game_data); tracked_free(pp_game_valid); tracked_free(p_game_profiles); tracked_free(p_turn2_cache); tracked_free(p_latency);
+        return;
+    }
+    printf(" Done.\n");
+
+    // --- PHASE 2: DAY-BY-DAY REPLAY ---
+    set_allocation_phase(ALLOC_PHASE_PLAY);
+    bind_entropy_profile_buffer(p_game_profiles, master_count);
+    char opening_word[6] = "";
+    int days_played = 0;
+    int days_skipped = 0;
+    int turn2_memo_resets = 0;
+
+    for (int day = 0; day < history_count; day++)
+    {
+        const char* p_answer = p_history_words + (size_t)day * WORDLE_WORD_LENGTH;
+
+        // Locate today's answer in the pool
+        int target_idx = find_dictionary_word(pool.p_entries, pool.count, p_answer);
+        if (target_idx < 0)
+        {
+            // Not in AllWords.txt (or already removed on an earlier day)
+            days_skipped++;
+            continue;
+        }
+
+        // A pool mutation the memo did not invalidate for: trust none of it
+        if (p_turn2_cache->generation != pool.generation)
+        {
+            memset(p_turn2_cache->is_valid, 0, sizeof(p_turn2_cache->is_valid));
+            p_turn2_cache->generation = pool.generation;
+        }
+
+        // a. Re-derive the opener from today's (already current) opener entropy.
+        // If it changed, every memoized Turn 2 decision is stale.
+        char todays_opener[6];
+        determine_opening_word(&config, pool.p_entries, pool.count, todays_opener);
+        if (strcmp(todays_opener, opening_word) != 0)
+        {
+            if (opening_word[0] != '\0') turn2_memo_resets++;
+            strcpy_s(opening_word, 6, todays_opener);
+            memset(p_turn2_cache->is_valid, 0, sizeof(p_turn2_cache->is_valid));
+        }
+
+        // b. Play the day's game
+        int guesses_taken = 0;
+        bool won = play_simulated_game(&config, pool.p_entries, pool.count, &pool.p_entries[target_idx], opening_word,
+            p_game_data, pp_game_valid, p_turn2_cache, &guesses_taken, NULL, &stats.decisions, p_latency);
+
+        days_played++;
+        if (won)
+        {
+            stats.wins++;
+            stats.total_guesses += guesses_taken;
+            stats.guess_distribution[guesses_taken]++;
+            printf("    Day %4d: %.5s  Opener: %s  Solved in %d\n", day + 1, p_answer, opening_word, guesses_taken);
+        }
+        else
+        {
+            stats.losses++;
+            printf("    Day %4d: %.5s  Opener: %s  *** LOST ***\n", day + 1, p_answer, opening_word);
+        }
+
+        // c. Retire the answer. Only the memo entries that could have depended
+        // on it are invalidated: every opener bucket it is a candidate in, and
+        // any bucket whose cached Turn 2 guess was this word (it is no longer a
+        // legal guess). Truthful feedback puts it in one bucket; in Fibble it
+        // survives every bucket exactly `lies_per_row` digits from its code.
+        // Strategies that compare windows of words lose the whole memo.
+        if (!is_turn2_memo_kept_on_removal(&config))
+        {
+            memset(p_turn2_cache->is_valid, 0, sizeof(p_turn2_cache->is_valid));
+        }
+        int true_code = get_feedback_index(opening_word, p_answer);
+        for (int b = 0; b < MAX_PATTERNS; b++)
+        {
+            bool is_candidate_bucket = g_isFibbleMode ? (pattern_digit_mismatches(b, true_code) == FIBBLE_NOISE_MODEL.lies_per_row) : (b == true_code);
+            if (is_candidate_bucket || strncmp(p_turn2_cache->guess[b], p_answer, WORDLE_WORD_LENGTH) == 0)
+            {
+                p_turn2_cache->is_valid[b] = false;
+            }
+        }
+
+        if (mutable_dictionary_remove_word(&pool, p_answer)) p_turn2_cache->generation++;
+    }
+
+    // --- PHASE 3: REPORT ---
+    set_allocation_phase(ALLOC_PHASE_SETUP);
+    time_t end_time = time(NULL);
+    stats.time_taken = difftime(end_time, start_time);
+    stats.average_guesses = (stats.wins > 0) ? (double)stats.total_guesses / stats.wins : 0.0;
+    stats.win_percent = (days_played > 0) ? ((double)stats.wins / days_played) * 100.0 : 0.0;
+
+    printf("\n===========================================================================================\n");
+    printf("                               HISTORICAL REPLAY RESULTS                          \n");
+    printf("===========================================================================================\n");
+    printf("| %-30s | %-5s | %-6s | %-10s | %-11s | %-8s |\n", "STRATEGY", "WINS", "LOSSES", "WIN %", "AVG GUESSES", "TIME (s)");
+    printf("|--------------------------------|-------|--------|------------|-------------|----------|\n");
+    printf("| %-30s | %-5d | %-6d | %9.2f%% | %11.4f | %8.0f |\n",
+        stats.strategy_name, stats.wins, stats.losses, stats.win_percent, stats.average_guesses, stats.time_taken);
+    printf("===========================================================================================\n");
+    printf("Days played: %d  Skipped (not in dictionary): %d  Opener changes: %d\n", days_played, days_skipped, turn2_memo_resets);
+    if (g_decision_budget_ms > 0.0) print_decision_budget_table(&stats, 1);
+    print_decision_latency_report(p_latency, stats.strategy_name);
+    printf("\n");
+    print_distribution(&stats);
+
+    free_mutable_dictionary(&pool);
+    bind_entropy_profile_buffer(NULL, 0);
+    tracked_free(p_game_data); tracked_free(pp_game_valid); tracked_free(p_game_profiles); tracked_free(p_turn2_cache); tracked_free(p_latency);
+}
+
+/*
+ * FUNCTION: trace_simulated_game
+ *
+ * WHAT:
+ * `play_simulated_game` with its own scratch buffers and no memo, recording
+ * every guess (and, optionally, the decision counts).
+ */
+int trace_simulated_game(int strategy_index, const dictionary_entry_t* p_dictionary, int count,
+    const dictionary_entry_t* p_target, const char* opening_word, char (*p_guess_log)[WORDLE_WORD_LENGTH + 1],
+    traced_decisions_t* p_traced)
+{
+    dictionary_entry_t* p_data = (dictionary_entry_t*)tracked_malloc(sizeof(dictionary_entry_t) * count);
+    dictionary_entry_t** pp_valid = (dictionary_entry_t**)tracked_malloc(sizeof(dictionary_entry_t*) * count);
+    void* p_profiles = tracked_malloc(entropy_profile_buffer_bytes(count));
+    if (!p_data || !pp_valid || !p_profiles) { tracked_free(p_data); tracked_free(pp_valid); tracked_free(p_profiles); return -1; }
+    bind_entropy_profile_buffer(p_profiles, count);
+
+    int guesses_taken = 0;
+    decision_totals_t decisions;
+    memset(&decisions, 0, sizeof(decisions));
+    bool won = play_simulated_game(&ALL_STRATEGIES[strategy_index], p_dictionary, count, p_target, opening_word,
+        p_data, pp_valid, NULL, &guesses_taken, p_guess_log, &decisions, NULL);
+    if (p_traced != NULL)
+    {
+        p_traced->decisions = (int)decisions.decisions;
+        p_traced->deadline_hits = (int)decisions.deadline_hits;
+    }
+
+    bind_entropy_profile_buffer(NULL, 0);
+    tracked_free(p_data); tracked_free(pp_valid); tracked_free(p_profiles);
+    return won ? guesses_taken : 0;
+}
+
+/*
+ * HELPER: time_candidate_entropy
+ *
+ * WHAT:
+ * Milliseconds for one `calculate_entropy_for_candidates` pass with the
+ * given kernel (the tuned configuration is restored afterwards).
+ */
+static double time_candidate_entropy(int kernel, dictionary_entry_t* p_guesses, int guess_count, dictionary_entry_t** pp_answers, int answer_count)
+{
+    tuning_config_t saved = g_tuning_config;
+    g_tuning_config.entropy_kernel = kernel;
+    double start = omp_get_wtime();
+    calculate_entropy_for_candidates(p_guesses, guess_count, pp_answers, answer_count);
+    double elapsed = (omp_get_wtime() - start) * 1000.0;
+    g_tuning_config = saved;
+    return elapsed;
+}
+
+/*
+ * STRUCT: counted_kernel_t
+ *
+ * WHAT:
+ * One kernel run of the scale benchmark under hardware counters: which
+ * kernel, at which size, how many feedback computations it did (words
+ * checked, for the filter) and the counts.
+ */
+typedef struct _counted_kernel
+{
+    int words;
+    const char* kernel;
+    long long feedbacks;
+    long long values[PERF_COUNTER_COUNT];
+} counted_kernel_t;
+
+/*
+ * HELPER: count_candidate_entropy
+ *
+ * WHAT:
+ * One `calculate_entropy_for_candidates` pass with the given kernel on the
+ * calling thread only, under `p_counters`.
+ */
+static void count_candidate_entropy(perf_counters_t* p_counters, int kernel, dictionary_entry_t* p_guesses, int guess_count, dictionary_entry_t** pp_answers, int answer_count)
+{
+    tuning_config_t saved = g_tuning_config;
+    g_tuning_config.entropy_kernel = kernel;
+    g_tuning_config.thread_count = 1;
+    start_perf_counters(p_counters);
+    calculate_entropy_for_candidates(p_guesses, guess_count, pp_answers, answer_count);
+    stop_perf_counters(p_counters);
+    g_tuning_config = saved;
+}
+
+/*
+ * HELPER: print_counted_kernels
+ *
+ * WHAT:
+ * The hardware counter table: IPC, and instructions and misses per
+ * feedback computation ("-" where a counter is unavailable).
+ */
+static void print_counted_kernels(const counted_kernel_t* p_rows, int row_count)
+{
+    printf("\n--- Hardware Counters (1 thread, user space, per feedback computation) ---\n");
+    printf("| %7s | %-10s | %6s | %10s | %10s | %10s | %10s |\n", "WORDS", "KERNEL", "IPC", "INSNS", "BR MISS", "L1D MISS", "LLC MISS");
+    printf("|---------|------------|--------|------------|------------|------------|------------|\n");
+    for (int r = 0; r < row_count; r++)
+    {
+        const counted_kernel_t* p_row = &p_rows[r];
+        const long long* v = p_row->values;
+        char ipc[16] = "-";
+        char per_feedback[4][16];
+        if (v[PERF_COUNTER_CYCLES] > 0 && v[PERF_COUNTER_INSTRUCTIONS] >= 0) sprintf_s(ipc, sizeof(ipc), "%.2f", (double)v[PERF_COUNTER_INSTRUCTIONS] / v[PERF_COUNTER_CYCLES]);
+
+        const int COLUMNS[4] = { PERF_COUNTER_INSTRUCTIONS, PERF_COUNTER_BRANCH_MISSES, PERF_COUNTER_L1D_MISSES, PERF_COUNTER_LLC_MISSES };
+        for (int c = 0; c < 4; c++)
+        {
+            if (v[COLUMNS[c]] >= 0 && p_row->feedbacks > 0) sprintf_s(per_feedback[c], 16, "%.3f", (double)v[COLUMNS[c]] / p_row->feedbacks);
+            else strcpy_s(per_feedback[c], 16, "-");
+        }
+        printf("| %7d | %-10s | %6s | %10s | %10s | %10s | %10s |\n",
+            p_row->words, p_row->kernel, ipc, per_feedback[0], per_feedback[1], per_feedback[2], per_feedback[3]);
+    }
+}
+
+/*
+ * HELPER: play_sample_games
+ *
+ * WHAT:
+ * `p_config` plays `games` answers spread evenly over the dictionary from
+ * `opening_word`, in parallel, with no memo.
+ *
+ * RETURNS:
+ * - The games won.
+ */
+static int play_sample_games(const HybridConfig* p_config, const dictionary_entry_t* p_dictionary, int n, int games, const char* opening_word)
+{
+    int wins = 0;
+#pragma omp parallel reduction(+:wins)
+    {
+        dictionary_entry_t* p_thread_data = (dictionary_entry_t*)tracked_malloc(sizeof(dictionary_entry_t) * n);
+        dictionary_entry_t** pp_thread_valid = (dictionary_entry_t**)tracked_malloc(sizeof(dictionary_entry_t*) * n);
+        void* p_thread_profiles = tracked_malloc(entropy_profile_buffer_bytes(n));
+        bind_entropy_profile_buffer(p_thread_profiles, n);
+        if (p_thread_data && pp_thread_valid)
+        {
+#pragma omp for schedule(dynamic)
+            for (int g = 0; g < games; g++)
+            {
+                int guesses_taken = 0;
+                if (play_simulated_game(p_config, p_dictionary, n, &p_dictionary[(long long)g * n / games], opening_word,
+                    p_thread_data, pp_thread_valid, NULL, &guesses_taken, NULL, NULL, NULL)) wins++;
+            }
+        }
+        bind_entropy_profile_buffer(NULL, 0);
+        tracked_free(p_thread_data);
+        tracked_free(pp_thread_valid);
+        tracked_free(p_thread_profiles);
+    }
+    return wins;
+}
+
+/*
+ * FUNCTION: run_scale_benchmark
+ *
+ * WHAT:
+ * For each size N:
+ * 1. Generate a synthetic dictionary (seed 1), give it a pattern cache and
+ * the tuning file's configuration for its size (no calibration here).
+ * 2. Entropy: every sampled guess (up to 2,048) against an N/32 answer set
+ * (the size of a typical Turn 2 position), with the direct kernel, then the
+ * row-lookup kernel cold (filling rows) and warm.
+ * 3. Filter: one feedback filter over all N words, averaged over 16 answers.
+ * 4. Games: the Champion plays 16 answers spread over the dictionary, from
+ * the best sampled guess as opener.
+ * 5. Memory: the dictionary, the filled pattern rows and the per-thread
+ * game working sets.
+ * 6. Counters (optional): the direct kernel, the warm row-lookup kernel and
+ * the filter once more on one thread under hardware counters.
+ * Rows go to the screen and to SCALE_BENCHMARK_CSV for plotting.
+ */
+void run_scale_benchmark(const int* p_sizes, int size_count, int letter_model, bool use_perf_counters)
+{
+    const HybridConfig config = ALL_STRATEGIES[0];
+    const double MB = 1024.0 * 1024.0;
+    const int MAX_GUESS_SAMPLE = 2048;
+    const int FILTER_SAMPLE = 16;
+    const int GAME_SAMPLE = 16;
+
+    printf("\n=============================================\n");
+    printf("   STARTING SCALE BENCHMARK\n");
+    printf("   Letters: %s  Seed: 1  Strategy: %s\n", letter_model_name(letter_model), config.name);
+    printf("   Engine: tile and threads per size from %s (defaults if absent)\n", TUNING_FILE_NAME);
+    printf("=============================================\n\n");
+
+    // Three counted kernels per size
+    perf_counters_t counters;
+    counted_kernel_t* p_counted = NULL;
+    int counted_count = 0;
+    if (use_perf_counters && open_perf_counters(&counters))
+    {
+        p_counted = (counted_kernel_t*)tracked_malloc(sizeof(counted_kernel_t) * 3 * size_count);
+        if (p_counted == NULL) close_perf_counters(&counters);
+    }
+
+    FILE* p_csv = NULL;
+    if (fopen_s(&p_csv, SCALE_BENCHMARK_CSV, "w") != 0) p_csv = NULL;
+    if (p_csv != NULL) fprintf(p_csv, "words,generate_ms,entropy_direct_ms,entropy_rows_cold_ms,entropy_rows_warm_ms,filter_ms,game_ms,win_percent,dictionary_mb,rows_mb,working_sets_mb\n");
+
+    printf("| %7s | %8s | %10s | %10s | %10s | %8s | %9s | %6s | %8s | %8s | %8s |\n",
+        "WORDS", "GEN ms", "ENT DIRECT", "ENT COLD", "ENT WARM", "FILTER", "GAME ms", "WIN %", "DICT MB", "ROWS MB", "THRD MB");
+    printf("|---------|----------|------------|------------|------------|----------|-----------|--------|----------|----------|----------|\n");
+
+    for (int s = 0; s < size_count; s++)
+    {
+        // 1. Dictionary and cache
+        synthetic_dictionary_spec_t spec = { p_sizes[s], 1, letter_model };
+        dictionary_entry_t* p_dictionary = NULL;
+        int n = 0;
+        double start = omp_get_wtime();
+        if (!generate_synthetic_dictionary(&spec, &p_dictionary, &n)) continue;
+        double generate_ms = (omp_get_wtime() - start) * 1000.0;
+
+        pattern_cache_t cache;
+        if (init_pattern_cache(&cache, p_dictionary, n, (size_t)PATTERN_CACHE_DEFAULT_BUDGET_MB * 1024 * 1024)) g_p_pattern_cache = &cache;
+        select_tuning_config(p_dictionary, n, false, false);
+
+        int guess_count = (n < MAX_GUESS_SAMPLE) ? n : MAX_GUESS_SAMPLE;
+        int answer_count = (n / 32 > 0) ? n / 32 : 1;
+        dictionary_entry_t* p_guesses = (dictionary_entry_t*)tracked_malloc(sizeof(dictionary_entry_t) * guess_count);
+        dictionary_entry_t** pp_answers = (dictionary_entry_t**)tracked_malloc(sizeof(dictionary_entry_t*) * answer_count);
+        dictionary_entry_t* p_scratch = (dictionary_entry_t*)tracked_malloc(sizeof(dictionary_entry_t) * n);
+        if (!p_guesses || !pp_answers || !p_scratch)
+        {
+            printf("Out of memory at %d words.\n", n);
+            tracked_free(p_guesses); tracked_free(pp_answers); tracked_free(p_scratch);
+            if (g_p_pattern_cache != NULL) { g_p_pattern_cache = NULL; free_pattern_cache(&cache); }
+            tracked_free(p_dictionary);
+            break;
+        }
+        for (int i = 0; i < guess_count; i++) p_guesses[i] = p_dictionary[(long long)i * n / guess_count];
+        for (int i = 0; i < answer_count; i++) pp_answers[i] = &p_dictionary[(long long)i * n / answer_count];
+
+        // 2. Entropy kernels
+        double direct_ms = time_candidate_entropy(ENTROPY_KERNEL_DIRECT, p_guesses, guess_count, pp_answers, answer_count);
+        double cold_ms = time_candidate_entropy(ENTROPY_KERNEL_ROW_LOOKUP, p_guesses, guess_count, pp_answers, answer_count);
+        double warm_ms = time_candidate_entropy(ENTROPY_KERNEL_ROW_LOOKUP, p_guesses, guess_count, pp_answers, answer_count);
+
+        const dictionary_entry_t* p_opener = &p_guesses[0];
+        for (int i = 1; i < guess_count; i++)
+        {
+            if (p_guesses[i].entropy_score > p_opener->entropy_score) p_opener = &p_guesses[i];
+        }
+        char opening_word[6];
+        strcpy_s(opening_word, 6, p_opener->word);
+
+        size_t row_count = 0;
+        if (g_p_pattern_cache != NULL)
+        {
+            for (int slot = 0; slot < cache.slot_capacity; slot++)
+            {
+                if (cache.p_row_of_slot[slot] != NULL) row_count++;
+            }
+        }
+
+        // 3. Filter
+        double filter_ms = 0.0;
+        for (int f = 0; f < FILTER_SAMPLE; f++)
+        {
+            const dictionary_entry_t* p_target = &p_dictionary[((long long)f * n + n / 2) / FILTER_SAMPLE];
+            char pattern[WORDLE_WORD_LENGTH + 1];
+            get_feedback_pattern(opening_word, p_target->word, pattern);
+            memcpy(p_scratch, p_dictionary, sizeof(dictionary_entry_t) * n);
+
+            start = omp_get_wtime();
+            filter_dictionary_by_constraints(p_scratch, n, opening_word, pattern, NULL);
+            filter_ms += (omp_get_wtime() - start) * 1000.0;
+        }
+        filter_ms /= FILTER_SAMPLE;
+
+        // 4. Games
+        int games = (n < GAME_SAMPLE) ? n : GAME_SAMPLE;
+        start = omp_get_wtime();
+        int wins = play_sample_games(&config, p_dictionary, n, games, opening_word);
+        double game_ms = (omp_get_wtime() - start) * 1000.0 / games;
+
+        // 5. Memory
+        double dictionary_mb = sizeof(dictionary_entry_t) * (double)n / MB;
+        double rows_mb = (double)row_count * n / MB;
+        double working_sets_mb = omp_get_max_threads() * ((sizeof(dictionary_entry_t) + sizeof(dictionary_entry_t*)) * (double)n + entropy_profile_buffer_bytes(n)) / MB;
+        double win_percent = 100.0 * wins / games;
+
+        printf("| %7d | %8.1f | %10.1f | %10.1f | %10.1f | %8.3f | %9.1f | %5.1f%% | %8.1f | %8.1f | %8.1f |\n",
+            n, generate_ms, direct_ms, cold_ms, warm_ms, filter_ms, game_ms, win_percent, dictionary_mb, rows_mb, working_sets_mb);
+        fflush(stdout);
+        if (p_csv != NULL)
+        {
+            fprintf(p_csv, "%d,%.3f,%.3f,%.3f,%.3f,%.4f,%.3f,%.2f,%.3f,%.3f,%.3f\n",
+                n, generate_ms, direct_ms, cold_ms, warm_ms, filter_ms, game_ms, win_percent, dictionary_mb, rows_mb, working_sets_mb);
+        }
+
+        // 6. Counters
+        if (p_counted != NULL)
+        {
+            long long entropy_feedbacks = (long long)guess_count * answer_count;
+            counted_kernel_t* p_row = &p_counted[counted_count++];
+            count_candidate_entropy(&counters, ENTROPY_KERNEL_DIRECT, p_guesses, guess_count, pp_answers, answer_count);
+            p_row->words = n; p_row->kernel = "ent direct"; p_row->feedbacks = entropy_feedbacks;
+            memcpy(p_row->values, counters.values, sizeof(p_row->values));
+
+            p_row = &p_counted[counted_count++];
+            count_candidate_entropy(&counters, ENTROPY_KERNEL_ROW_LOOKUP, p_guesses, guess_count, pp_answers, answer_count);
+            p_row->words = n; p_row->kernel = "ent warm"; p_row->feedbacks = entropy_feedbacks;
+            memcpy(p_row->values, counters.values, sizeof(p_row->values));
+
+            // The filter checks every word once against one pattern
+            p_row = &p_counted[counted_count++];
+            p_row->words = n; p_row->kernel = "filter"; p_row->feedbacks = (long long)n * FILTER_SAMPLE;
+            memset(p_row->values, 0, sizeof(p_row->values));
+            for (int f = 0; f < FILTER_SAMPLE; f++)
+            {
+                const dictionary_entry_t* p_target = &p_dictionary[((long long)f * n + n / 2) / FILTER_SAMPLE];
+                char pattern[WORDLE_WORD_LENGTH + 1];
+                get_feedback_pattern(opening_word, p_target->word, pattern);
+                memcpy(p_scratch, p_dictionary, sizeof(dictionary_entry_t) * n);
+
+                start_perf_counters(&counters);
+                filter_dictionary_by_constraints(p_scratch, n, opening_word, pattern, NULL);
+                stop_perf_counters(&counters);
+                for (int c = 0; c < PERF_COUNTER_COUNT; c++)
+                {
+                    if (counters.values[c] < 0 || p_row->values[c] < 0) p_row->values[c] = -1;
+                    else p_row->values[c] += counters.values[c];
+                }
+            }
+        }
+
+        tracked_free(p_guesses); tracked_free(pp_answers); tracked_free(p_scratch);
+        if (g_p_pattern_cache != NULL) { g_p_pattern_cache = NULL; free_pattern_cache(&cache); }
+        tracked_free(p_dictionary);
+    }
+
+    if (p_counted != NULL)
+    {
+        print_counted_kernels(p_counted, counted_count);
+        tracked_free(p_counted);
+        close_perf_counters(&counters);
+    }
+
+    if (p_csv != NULL)
+    {
+        fclose(p_csv);
+        printf("\nResults written to %s (one row per size, for plotting).\n", SCALE_BENCHMARK_CSV);
+    }
+}
+
+/*
+ * FUNCTION: run_placement_benchmark
+ *
+ * WHAT:
+ * 1. Opener, pattern cache and one untimed round of games, so every policy
+ * starts from the same warm pattern rows.
+ * 2. For each policy (the OpenMP team pinned accordingly), the fastest of
+ * REPEATS runs of:
+ * - Startup: `init_mutable_dictionary`, the partition table and opener
+ * entropy pass the startup pipeline runs on every launch.
+ * - Games: the Champion on GAME_SAMPLE answers spread over the dictionary,
+ * the tournament's parallel loop.
+ * 3. The table, with each policy's speed relative to the default, and the
+ * `--placement` policy restored.
+ */
+void run_placement_benchmark(dictionary_entry_t* p_dictionary, int count)
+{
+    const HybridConfig config = ALL_STRATEGIES[0];
+    const int GAME_SAMPLE = 256;
+    const int REPEATS = 2;
+    double startup_seconds[PLACEMENT_POLICY_COUNT];
+    double games_per_second[PLACEMENT_POLICY_COUNT];
+    int workers[PLACEMENT_POLICY_COUNT];
+
+    printf("\n=============================================\n");
+    printf("   STARTING PLACEMENT BENCHMARK\n");
+    printf("   Words: %d  Games: %d  Strategy: %s\n", count, GAME_SAMPLE, config.name);
+    printf("=============================================\n\n");
+
+    // 1. Shared setup
+    pattern_cache_t cache;
+    if (init_pattern_cache(&cache, p_dictionary, count, (size_t)PATTERN_CACHE_DEFAULT_BUDGET_MB * 1024 * 1024)) g_p_pattern_cache = &cache;
+
+    dictionary_entry_t* p_opener_data = (dictionary_entry_t*)tracked_malloc(sizeof(dictionary_entry_t) * count);
+    if (p_opener_data == NULL)
+    {
+        printf("Out of memory.\n");
+        if (g_p_pattern_cache != NULL) { g_p_pattern_cache = NULL; free_pattern_cache(&cache); }
+        return;
+    }
+    memcpy(p_opener_data, p_dictionary, sizeof(dictionary_entry_t) * count);
+    apply_thread_placement(PLACEMENT_DEFAULT);
+    calculate_entropy_on_dictionary(p_opener_data, count);
+    char opening_word[6];
+    determine_opening_word(&config, p_opener_data, count, opening_word);
+    tracked_free(p_opener_data);
+
+    int games = (count < GAME_SAMPLE) ? count : GAME_SAMPLE;
+    int wins = play_sample_games(&config, p_dictionary, count, games, opening_word);
+    printf("Opener: %s  Warm-up: %d/%d won\n\n", opening_word, wins, games);
+
+    // 2. Each policy
+    for (int policy = 0; policy < PLACEMENT_POLICY_COUNT; policy++)
+    {
+        workers[policy] = apply_thread_placement(policy);
+        print_thread_placement(policy);
+        startup_seconds[policy] = 0.0;
+        games_per_second[policy] = 0.0;
+
+        for (int r = 0; r < REPEATS; r++)
+        {
+            mutable_dictionary_t md;
+            double start = omp_get_wtime();
+            bool is_built = init_mutable_dictionary(&md, p_dictionary, count);
+            double elapsed = omp_get_wtime() - start;
+            if (is_built) free_mutable_dictionary(&md);
+            if (r == 0 || elapsed < startup_seconds[policy]) startup_seconds[policy] = elapsed;
+
+            start = omp_get_wtime();
+            play_sample_games(&config, p_dictionary, count, games, opening_word);
+            elapsed = omp_get_wtime() - start;
+            if (elapsed > 0.0 && games / elapsed > games_per_second[policy]) games_per_second[policy] = games / elapsed;
+        }
+        fflush(stdout);
+    }
+
+    // 3. Report
+    printf("\n| %-8s | %7s | %9s | %11s | %9s | %11s |\n", "POLICY", "WORKERS", "STARTUP s", "vs DEFAULT", "GAMES/s", "vs DEFAULT");
+    printf("|----------|---------|-----------|-------------|-----------|-------------|\n");
+    for (int policy = 0; policy < PLACEMENT_POLICY_COUNT; policy++)
+    {
+        double startup_speedup = (startup_seconds[policy] > 0.0) ? startup_seconds[PLACEMENT_DEFAULT] / startup_seconds[policy] : 0.0;
+        double games_speedup = (games_per_second[PLACEMENT_DEFAULT] > 0.0) ? games_per_second[policy] / games_per_second[PLACEMENT_DEFAULT] : 0.0;
+        printf("| %-8s | %7d | %9.3f | %10.2fx | %9.1f | %10.2fx |\n", placement_policy_name(policy), workers[policy],
+            startup_seconds[policy], startup_speedup, games_per_second[policy], games_speedup);
+    }
+
+    apply_thread_placement(g_placement_policy);
+    if (g_p_pattern_cache != NULL) { g_p_pattern_cache = NULL; free_pattern_cache(&cache); }
+}
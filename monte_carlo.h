@@ -41,4 +41,99 @@
   */
 void run_monte_carlo_simulation(const dictionary_entry_t* p_master_dictionary, int master_count);
 
-#endif
\ No newline at end of file
+/*
+ * FUNCTION: run_historical_replay
+ *
+ * WHAT:
+ * Walks the historical answer list in order. For each day it plays the
+ * Champion against that day's answer using the pool as it stood on that day
+ * (full dictionary minus every earlier answer), then retires the answer.
+ *
+ * PARAMETERS:
+ * - p_master_dictionary: The FULL dictionary (loaded without the history filter).
+ * - master_count: The number of words in the list.
+ * - p_history_words: Packed answers (5 bytes each, no terminators), oldest first.
+ * - history_count: Number of answers in `p_history_words`.
+ *
+ * WHY:
+ * Shows how the Champion would have performed as the answer pool shrank,
+ * rather than only against today's snapshot. Opener entropy, pattern
+ * histograms and the Turn 2 memo are updated incrementally per day, so the
+ * whole replay costs roughly one tournament instead of one per day.
+ */
+void run_historical_replay(const dictionary_entry_t* p_master_dictionary, int master_count, const char* p_history_words, int history_count);
+
+/*
+ * STRUCT: traced_decisions_t
+ *
+ * WHAT:
+ * The Smart Strategy decisions of a traced game, and how many of them the
+ * decision budget (`g_decision_budget_ms`) cut short.
+ */
+typedef struct _traced_decisions
+{
+    int decisions;
+    int deadline_hits;
+} traced_decisions_t;
+
+/*
+ * FUNCTION: trace_simulated_game
+ *
+ * WHAT:
+ * Plays one tournament game of strategy `ALL_STRATEGIES[strategy_index]`
+ * against `p_target`, writing each turn's guess to `p_guess_log` (room for
+ * 6 guesses) and the decision counts to `p_traced` (NULL to skip).
+ *
+ * RETURNS:
+ * - The guesses taken if the game was won, 0 if lost, -1 if out of memory.
+ *
+ * WHY:
+ * Lets the differential verifier compare whole decision sequences, not
+ * just final scores.
+ */
+int trace_simulated_game(int strategy_index, const dictionary_entry_t* p_dictionary, int count,
+    const dictionary_entry_t* p_target, const char* opening_word, char (*p_guess_log)[WORDLE_WORD_LENGTH + 1],
+    traced_decisions_t* p_traced);
+
+/*
+ * CONSTANT: SCALE_BENCHMARK_CSV
+ */
+#define SCALE_BENCHMARK_CSV "scale_benchmark.csv"
+
+/*
+ * FUNCTION: run_scale_benchmark
+ *
+ * WHAT:
+ * Generates a synthetic dictionary of each size in `p_sizes` (see
+ * dictionary_generator.h) and measures, per size, the time of each engine
+ * (entropy with each kernel, filtering, full games) and the memory of the
+ * dictionary, the pattern rows and the game working sets. Prints a table
+ * and writes the same numbers to SCALE_BENCHMARK_CSV.
+ *
+ * With `use_perf_counters`, each kernel is also run once on a single thread
+ * under hardware counters (see perf_counters.h) and a second table reports
+ * IPC and misses per feedback computation.
+ *
+ * WHY:
+ * The real dictionary is one fixed size. This shows how each engine grows
+ * with N (and with skewed letter statistics) before a bigger word list is
+ * ever used for real.
+ */
+void run_scale_benchmark(const int* p_sizes, int size_count, int letter_model, bool use_perf_counters);
+
+/*
+ * FUNCTION: run_placement_benchmark
+ *
+ * WHAT:
+ * Times the startup partition-table and entropy pass and a sample of
+ * tournament games under each thread placement policy (see
+ * thread_placement.h), and prints the throughput of each relative to the
+ * default placement. `p_dictionary` gets the pattern cache stamps.
+ *
+ * WHY:
+ * Whether SMT siblings help or hurt these kernels depends on the machine.
+ * This measures it instead of guessing which `--placement` to use.
+ */
+void run_placement_benchmark(dictionary_entry_t* p_dictionary, int count);
+
+#endif
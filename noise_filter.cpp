@@ -0,0 +1,170 @@
+/*
+ * FILE: noise_filter.cpp
+ *
+ * WHAT:
+ * Implements the Noise-Tolerant Filter (typo recovery and Fibble).
+ *
+ * KEY OPTIMIZATIONS:
+ * 1. Integer Pattern Codes: The observed result is encoded once per turn, and
+ * each word's hypothetical feedback comes from `get_feedback_index`, the
+ * same routine the entropy engine uses. No pattern strings are built.
+ * 2. Distance Table: The number of differing positions between two codes is
+ * a 243 x 243 byte table (59 KB) built once, so the tolerance check is a
+ * single lookup.
+ * 3. Per-Word Counters: Mismatches accumulate in the dictionary entry, so
+ * each new turn only costs one pass, exactly like the strict filter.
+ *
+ * WHY:
+ * A strict filter has no way to recover from a wrong input: the true answer
+ * is gone after the first bad character. Counting mismatches instead of
+ * rejecting on the first one keeps the answer alive and ranks it by how
+ * much of the entered feedback it explains.
+ */
+
+#include "noise_filter.h"
+#include "entropy_calculator.h"
+#include <string.h>
+#include <math.h>
+
+/*
+ * GLOBAL: FIBBLE_NOISE_MODEL
+ *
+ * WHAT:
+ * One lie per row. The total is bounded only by the number of rows. A lie is
+ * certain, so the error rate is 1/5 (one of five positions).
+ */
+const noise_model_t FIBBLE_NOISE_MODEL = { FEEDBACK_HISTORY_TURNS, 1, 0.2 };
+
+/*
+ * HELPER: build_distance_table
+ *
+ * WHAT:
+ * Fills the 243 x 243 table of differing base-3 digits.
+ */
+static unsigned char s_pattern_distance[MAX_PATTERNS][MAX_PATTERNS];
+
+static bool build_distance_table()
+{
+    for (int a = 0; a < MAX_PATTERNS; a++)
+    {
+        for (int b = 0; b < MAX_PATTERNS; b++)
+        {
+            int x = a, y = b, distance = 0;
+            for (int i = 0; i < WORDLE_WORD_LENGTH; i++)
+            {
+                if (x % 3 != y % 3) distance++;
+                x /= 3; y /= 3;
+            }
+            s_pattern_distance[a][b] = (unsigned char)distance;
+        }
+    }
+    return true;
+}
+
+/*
+ * FUNCTION: pattern_digit_mismatches
+ *
+ * WHY:
+ * The table is built on first use. A function-local static is initialized
+ * exactly once even when several tournament threads get here together.
+ */
+int pattern_digit_mismatches(int pattern_code_a, int pattern_code_b)
+{
+    static const bool s_is_table_built = build_distance_table();
+    (void)s_is_table_built;
+    return s_pattern_distance[pattern_code_a][pattern_code_b];
+}
+
+/*
+ * FUNCTION: record_feedback
+ */
+void record_feedback(feedback_history_t* p_history, const char* guess, int pattern_code)
+{
+    if (p_history->turn_count >= FEEDBACK_HISTORY_TURNS) return;
+    strcpy_s(p_history->guess[p_history->turn_count], WORDLE_WORD_LENGTH + 1, guess);
+    p_history->pattern_code[p_history->turn_count] = pattern_code;
+    p_history->turn_count++;
+}
+
+/*
+ * FUNCTION: apply_noisy_feedback
+ *
+ * WHAT:
+ * 1. Skip words that are already eliminated.
+ * 2. Distance between this word's feedback and the observed code.
+ * 3. Fibble rows must differ in exactly `lies_per_row` positions.
+ * 4. Accumulate and enforce the total budget.
+ */
+int apply_noisy_feedback(dictionary_entry_t* p_dictionary, int count, const char* guess, int observed_code, const noise_model_t* p_model)
+{
+    int remaining = 0;
+    for (int i = 0; i < count; ++i)
+    {
+        dictionary_entry_t* pEntry = &p_dictionary[i];
+        if (pEntry->is_eliminated) continue;
+
+        int distance = pattern_digit_mismatches(get_feedback_index(guess, pEntry->word), observed_code);
+
+        if (p_model->lies_per_row > 0 && distance != p_model->lies_per_row) { pEntry->is_eliminated = true; continue; }
+
+        int total = pEntry->feedback_mismatches + distance;
+        if (total > p_model->max_total_mismatches) { pEntry->is_eliminated = true; continue; }
+
+        pEntry->feedback_mismatches = (unsigned char)total;
+        remaining++;
+    }
+    return remaining;
+}
+
+/*
+ * FUNCTION: refilter_with_noise
+ */
+int refilter_with_noise(dictionary_entry_t* p_dictionary, int count, const feedback_history_t* p_history, const noise_model_t* p_model)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        p_dictionary[i].is_eliminated = false;
+        p_dictionary[i].feedback_mismatches = 0;
+    }
+
+    int remaining = count;
+    for (int t = 0; t < p_history->turn_count; t++)
+    {
+        remaining = apply_noisy_feedback(p_dictionary, count, p_history->guess[t], p_history->pattern_code[t], p_model);
+    }
+    return remaining;
+}
+
+/*
+ * FUNCTION: noise_log_likelihood
+ */
+double noise_log_likelihood(const dictionary_entry_t* pEntry, int turn_count, const noise_model_t* p_model)
+{
+    int wrong = pEntry->feedback_mismatches;
+    int right = turn_count * WORDLE_WORD_LENGTH - wrong;
+    return wrong * log(p_model->digit_error_rate / 2.0) + right * log(1.0 - p_model->digit_error_rate);
+}
+
+/*
+ * FUNCTION: inject_feedback_lie
+ *
+ * WHAT:
+ * 1. Hash (answer, turn) with FNV-1a.
+ * 2. Pick the lying position and a color offset of 1 or 2 (never 0, so the
+ * tile really changes).
+ */
+int inject_feedback_lie(int true_code, const char* answer, int turn)
+{
+    unsigned int hash = 2166136261u;
+    for (int i = 0; i < WORDLE_WORD_LENGTH; i++) { hash ^= (unsigned char)answer[i]; hash *= 16777619u; }
+    hash ^= (unsigned int)turn; hash *= 16777619u;
+
+    int position = (int)(hash % WORDLE_WORD_LENGTH);
+    int offset = 1 + (int)((hash / WORDLE_WORD_LENGTH) % 2);
+
+    int place = 1;
+    for (int i = 0; i < position; i++) place *= 3;
+    int digit = (true_code / place) % 3;
+    int lying_digit = (digit + offset) % 3;
+    return true_code + (lying_digit - digit) * place;
+}
@@ -0,0 +1,158 @@
+/*
+ * FILE: noise_filter.h
+ *
+ * WHAT:
+ * Defines the interface for the Noise-Tolerant Filter. The strict filter
+ * (`filter_dictionary_by_constraints`) eliminates every word whose feedback
+ * differs from the entered result in even one position. This module instead
+ * counts, per word, how many pattern positions disagree across the whole
+ * game, and only eliminates a word once that count exceeds a tolerance.
+ *
+ * Two uses:
+ * 1. Typo Recovery (Interactive): One mistyped character in a result pattern
+ * eliminates the true answer and ends in "No words remaining". Re-filtering
+ * the game history with a tolerance of 1 (then 2) keeps the words that are
+ * one slip away from consistent, ordered by likelihood.
+ * 2. Fibble (Tournament / Interactive, `--fibble`): Each row of feedback
+ * contains exactly one lie. A word survives only if every row differs from
+ * its true feedback in exactly one position.
+ *
+ * WHY:
+ * Everything works on integer pattern codes (0-242) and a precomputed
+ * 243 x 243 "digit distance" table, so tolerant filtering costs the same
+ * single feedback computation per word as the strict filter.
+ */
+
+#pragma once
+#ifndef NOISE_FILTER_H
+#define NOISE_FILTER_H
+#include "wordle_types.h"
+
+/*
+ * CONSTANT: FEEDBACK_HISTORY_TURNS
+ *
+ * WHAT:
+ * The number of turns a feedback history can hold (one Wordle game).
+ */
+#define FEEDBACK_HISTORY_TURNS 6
+
+/*
+ * STRUCT: noise_model_t
+ *
+ * WHAT:
+ * Describes how far entered feedback may stray from the truth.
+ *
+ * FIELDS:
+ * - max_total_mismatches: A word is eliminated once its mismatch total
+ * (over all turns) exceeds this. 0 = strict filtering.
+ * - lies_per_row: 0 = any row may be wrong (bounded by the total).
+ * > 0 = every row is wrong in EXACTLY this many positions (Fibble = 1).
+ * - digit_error_rate: Assumed chance that one entered position is wrong.
+ * Only used to turn mismatch counts into likelihoods.
+ */
+typedef struct _noise_model
+{
+    int max_total_mismatches;
+    int lies_per_row;
+    double digit_error_rate;
+} noise_model_t;
+
+/*
+ * STRUCT: feedback_history_t
+ *
+ * WHAT:
+ * The guesses made so far and the feedback entered for each, as pattern codes.
+ *
+ * WHY:
+ * Tolerant filtering has to be re-run from scratch when the tolerance changes
+ * (e.g., after the strict filter empties the pool), so the raw turns are kept.
+ */
+typedef struct _feedback_history
+{
+    int turn_count;
+    char guess[FEEDBACK_HISTORY_TURNS][WORDLE_WORD_LENGTH + 1];
+    int pattern_code[FEEDBACK_HISTORY_TURNS];
+} feedback_history_t;
+
+/*
+ * GLOBAL: FIBBLE_NOISE_MODEL
+ *
+ * WHAT:
+ * Exactly one lie in every row, no other limit.
+ */
+extern const noise_model_t FIBBLE_NOISE_MODEL;
+
+/*
+ * FUNCTION: pattern_digit_mismatches
+ *
+ * WHAT:
+ * Returns the number of positions (0-5) in which two pattern codes differ.
+ *
+ * WHY:
+ * Table lookup instead of five divide/modulo pairs per word per turn.
+ */
+int pattern_digit_mismatches(int pattern_code_a, int pattern_code_b);
+
+/*
+ * FUNCTION: record_feedback
+ *
+ * WHAT:
+ * Appends a turn to the history. Turns beyond FEEDBACK_HISTORY_TURNS are ignored.
+ */
+void record_feedback(feedback_history_t* p_history, const char* guess, int pattern_code);
+
+/*
+ * FUNCTION: apply_noisy_feedback
+ *
+ * WHAT:
+ * The tolerant counterpart of `filter_dictionary_by_constraints`. For every
+ * non-eliminated word, computes the feedback it would have produced, adds the
+ * distance to `observed_code` to its `feedback_mismatches`, and eliminates it
+ * if the noise model rules it out.
+ *
+ * RETURNS:
+ * - The number of words still not eliminated.
+ */
+int apply_noisy_feedback(dictionary_entry_t* p_dictionary, int count, const char* guess, int observed_code, const noise_model_t* p_model);
+
+/*
+ * FUNCTION: refilter_with_noise
+ *
+ * WHAT:
+ * Clears `is_eliminated` and `feedback_mismatches` on every entry, then
+ * applies every turn of `p_history` under `p_model`.
+ *
+ * RETURNS:
+ * - The number of words still not eliminated.
+ */
+int refilter_with_noise(dictionary_entry_t* p_dictionary, int count, const feedback_history_t* p_history, const noise_model_t* p_model);
+
+/*
+ * FUNCTION: noise_log_likelihood
+ *
+ * WHAT:
+ * log P(entered feedback | word is the answer) for a word with
+ * `feedback_mismatches` wrong positions out of `turn_count` * 5 entered.
+ * Each wrong position can be either of the two other colors, so it
+ * contributes log(rate / 2); each correct one contributes log(1 - rate).
+ *
+ * WHY:
+ * With a uniform prior, exponentiating and normalizing these gives the
+ * posterior probability of each surviving word.
+ */
+double noise_log_likelihood(const dictionary_entry_t* pEntry, int turn_count, const noise_model_t* p_model);
+
+/*
+ * FUNCTION: inject_feedback_lie
+ *
+ * WHAT:
+ * Returns `true_code` with exactly one position changed to a different color.
+ * The position and color are derived from a hash of the answer and the turn.
+ *
+ * WHY:
+ * Fibble tournaments must be reproducible: the same strategy against the same
+ * answer sees the same lies on every run and every thread count.
+ */
+int inject_feedback_lie(int true_code, const char* answer, int turn);
+
+#endif
@@ -0,0 +1,308 @@
+/*
+ * FILE: partition_table.cpp
+ *
+ * WHAT:
+ * Implements the Incremental Partition Table: per-guess pattern histograms
+ * that can be updated one answer at a time.
+ *
+ * KEY OPTIMIZATIONS:
+ * 1. Running Sums: Each row caches Sum( c * log2(c) ) as an integer score.
+ * Moving one answer out of a bucket changes that sum by a closed-form delta,
+ * so the entropy of a row is refreshed without rescanning its 243 buckets,
+ * and integer deltas never drift from a fresh scan.
+ * 2. Row-Major Layout: A row is a contiguous block of 243 ints, so deleting a
+ * guess is a single `memmove` and building a row stays in L1 cache.
+ * 3. OpenMP Parallelism: Both the initial build and the per-answer updates
+ * are embarrassingly parallel across rows.
+ *
+ * WHY:
+ * The Historical Replay shrinks the answer pool by one word per simulated day.
+ * Rebuilding opener entropy from scratch each day would cost one full O(N^2)
+ * pass per day; with this table the whole replay costs roughly one pass.
+ */
+
+#include "partition_table.h"
+#include "entropy_calculator.h"
+#include "memory_budget.h"
+#include "alloc_tracker.h"
+#include <stdlib.h>
+#include <string.h>
+#include <omp.h>
+
+/*
+ * HELPER: table_memory_id
+ *
+ * WHAT:
+ * The memory manager consumer shared by every partition table, and the bytes
+ * one row occupies (histogram + running sum).
+ */
+static int table_memory_id()
+{
+    return register_memory_consumer("Partition tables", MEMORY_PRIORITY_REQUIRED, NULL, NULL, NULL);
+}
+static const size_t TABLE_ROW_BYTES = sizeof(int) * MAX_PATTERNS + sizeof(long long);
+
+/*
+ * FUNCTION: build_partition_table
+ *
+ * WHAT:
+ * Allocates and fills the N x 243 histogram block, then derives the running
+ * sums for every row.
+ *
+ * WHY:
+ * Same O(N^2) work as `calculate_entropy_on_dictionary`, but the histograms
+ * are kept instead of being thrown away after each row.
+ */
+bool build_partition_table(partition_table_t* p_table, const dictionary_entry_t* p_dictionary, int count)
+{
+    p_table->row_count = 0;
+    p_table->row_capacity = 0;
+    p_table->answer_count = 0;
+    p_table->p_bucket_counts = NULL;
+    p_table->p_sum_c_log_c = NULL;
+    if (count <= 0) return false;
+
+    // Charged first, so lower-priority caches make room before the allocation
+    memory_budget_charge(table_memory_id(), TABLE_ROW_BYTES * count);
+    p_table->p_bucket_counts = (int*)tracked_calloc((size_t)count * MAX_PATTERNS, sizeof(int));
+    p_table->p_sum_c_log_c = (long long*)tracked_malloc(sizeof(long long) * count);
+    if (p_table->p_bucket_counts == NULL || p_table->p_sum_c_log_c == NULL)
+    {
+        memory_budget_release(table_memory_id(), TABLE_ROW_BYTES * count);
+        free_partition_table(p_table);
+        return false;
+    }
+
+#pragma omp parallel for schedule(dynamic)
+    for (int g = 0; g < count; g++)
+    {
+        int* row = p_table->p_bucket_counts + (size_t)g * MAX_PATTERNS;
+        for (int a = 0; a < count; a++)
+        {
+            row[get_feedback_index(p_dictionary[g].word, p_dictionary[a].word)]++;
+        }
+
+        long long sum = 0;
+        for (int b = 0; b < MAX_PATTERNS; b++) sum += get_c_log2_c_score(row[b]);
+        p_table->p_sum_c_log_c[g] = sum;
+    }
+
+    p_table->row_count = count;
+    p_table->row_capacity = count;
+    p_table->answer_count = count;
+    return true;
+}
+
+/*
+ * FUNCTION: partition_table_remove_word
+ *
+ * WHAT:
+ * 1. Answer removal: For every guess row, find the bucket the removed word
+ * fell into, decrement it, and patch the running sum.
+ * 2. Guess removal: Shift the rows after `index` down by one.
+ *
+ * WHY:
+ * Step 1 is O(N) feedback computations (one per row) instead of the O(N^2)
+ * of a full rebuild. Step 2 is a single contiguous memory move.
+ */
+void partition_table_remove_word(partition_table_t* p_table, const dictionary_entry_t* p_dictionary, int index)
+{
+    if (index < 0 || index >= p_table->row_count) return;
+    const char* removed_word = p_dictionary[index].word;
+
+    // 1. Remove the word as an ANSWER from every guess row
+#pragma omp parallel for schedule(static)
+    for (int g = 0; g < p_table->row_count; g++)
+    {
+        int* row = p_table->p_bucket_counts + (size_t)g * MAX_PATTERNS;
+        int bucket = get_feedback_index(p_dictionary[g].word, removed_word);
+        int c = row[bucket];
+        p_table->p_sum_c_log_c[g] += get_c_log2_c_score(c - 1) - get_c_log2_c_score(c);
+        row[bucket] = c - 1;
+    }
+    p_table->answer_count--;
+
+    // 2. Remove the word as a GUESS (delete its row)
+    int rows_after = p_table->row_count - index - 1;
+    if (rows_after > 0)
+    {
+        memmove(p_table->p_bucket_counts + (size_t)index * MAX_PATTERNS,
+            p_table->p_bucket_counts + (size_t)(index + 1) * MAX_PATTERNS,
+            sizeof(int) * MAX_PATTERNS * (size_t)rows_after);
+        memmove(p_table->p_sum_c_log_c + index, p_table->p_sum_c_log_c + index + 1, sizeof(long long) * rows_after);
+    }
+    p_table->row_count--;
+}
+
+/*
+ * FUNCTION: partition_table_remove_words
+ *
+ * WHAT:
+ * 1. Mark the removed rows.
+ * 2. For every surviving row, subtract each removed answer (parallel by row).
+ * 3. Slide surviving rows down over the gaps, in order.
+ */
+void partition_table_remove_words(partition_table_t* p_table, const dictionary_entry_t* p_dictionary, const int* p_indices, int index_count)
+{
+    if (index_count <= 0) return;
+
+    // 1. Mark
+    bool* p_is_removed = (bool*)tracked_calloc(p_table->row_count, sizeof(bool));
+    if (p_is_removed == NULL)
+    {
+        // Fall back to one-at-a-time removal (highest index first keeps the rest valid)
+        for (int k = index_count - 1; k >= 0; k--) partition_table_remove_word(p_table, p_dictionary, p_indices[k]);
+        return;
+    }
+    for (int k = 0; k < index_count; k++) p_is_removed[p_indices[k]] = true;
+
+    // 2. Remove as ANSWERS from every surviving row
+#pragma omp parallel for schedule(static)
+    for (int g = 0; g < p_table->row_count; g++)
+    {
+        if (p_is_removed[g]) continue;
+        int* row = p_table->p_bucket_counts + (size_t)g * MAX_PATTERNS;
+        long long sum = p_table->p_sum_c_log_c[g];
+        for (int k = 0; k < index_count; k++)
+        {
+            int bucket = get_feedback_index(p_dictionary[g].word, p_dictionary[p_indices[k]].word);
+            int c = row[bucket];
+            sum += get_c_log2_c_score(c - 1) - get_c_log2_c_score(c);
+            row[bucket] = c - 1;
+        }
+        p_table->p_sum_c_log_c[g] = sum;
+    }
+    p_table->answer_count -= index_count;
+
+    // 3. Remove as GUESSES (compact the rows)
+    int kept = 0;
+    for (int g = 0; g < p_table->row_count; g++)
+    {
+        if (p_is_removed[g]) continue;
+        if (kept != g)
+        {
+            memcpy(p_table->p_bucket_counts + (size_t)kept * MAX_PATTERNS, p_table->p_bucket_counts + (size_t)g * MAX_PATTERNS, sizeof(int) * MAX_PATTERNS);
+            p_table->p_sum_c_log_c[kept] = p_table->p_sum_c_log_c[g];
+        }
+        kept++;
+    }
+    p_table->row_count = kept;
+    tracked_free(p_is_removed);
+}
+
+/*
+ * FUNCTION: partition_table_insert_word
+ *
+ * WHAT:
+ * 1. Grows the row buffers if needed (doubling, like a vector).
+ * 2. Opens a gap at `index` and fills the new GUESS row against every answer.
+ * 3. Adds the new ANSWER to every other row and patches their running sums.
+ *
+ * WHY:
+ * O(N) feedback computations per inserted word, versus O(N^2) to rebuild.
+ */
+bool partition_table_insert_word(partition_table_t* p_table, const dictionary_entry_t* p_dictionary, int count, int index)
+{
+    if (index < 0 || index >= count || count != p_table->row_count + 1) return false;
+
+    // 1. Grow
+    if (count > p_table->row_capacity)
+    {
+        int new_capacity = (p_table->row_capacity > 0) ? p_table->row_capacity * 2 : 64;
+        if (new_capacity < count) new_capacity = count;
+        size_t grown_bytes = TABLE_ROW_BYTES * (size_t)(new_capacity - p_table->row_capacity);
+        memory_budget_charge(table_memory_id(), grown_bytes);
+
+        int* p_new_counts = (int*)tracked_realloc(p_table->p_bucket_counts, sizeof(int) * MAX_PATTERNS * (size_t)new_capacity);
+        if (p_new_counts == NULL) { memory_budget_release(table_memory_id(), grown_bytes); return false; }
+        p_table->p_bucket_counts = p_new_counts;
+
+        long long* p_new_sums = (long long*)tracked_realloc(p_table->p_sum_c_log_c, sizeof(long long) * new_capacity);
+        if (p_new_sums == NULL) { memory_budget_release(table_memory_id(), grown_bytes); return false; }
+        p_table->p_sum_c_log_c = p_new_sums;
+
+        p_table->row_capacity = new_capacity;
+    }
+
+    // 2. Open a gap and fill the new GUESS row
+    int rows_after = p_table->row_count - index;
+    if (rows_after > 0)
+    {
+        memmove(p_table->p_bucket_counts + (size_t)(index + 1) * MAX_PATTERNS,
+            p_table->p_bucket_counts + (size_t)index * MAX_PATTERNS,
+            sizeof(int) * MAX_PATTERNS * (size_t)rows_after);
+        memmove(p_table->p_sum_c_log_c + index + 1, p_table->p_sum_c_log_c + index, sizeof(long long) * rows_after);
+    }
+
+    int* new_row = p_table->p_bucket_counts + (size_t)index * MAX_PATTERNS;
+    memset(new_row, 0, sizeof(int) * MAX_PATTERNS);
+    const char* added_word = p_dictionary[index].word;
+    for (int a = 0; a < count; a++)
+    {
+        new_row[get_feedback_index(added_word, p_dictionary[a].word)]++;
+    }
+    long long sum = 0;
+    for (int b = 0; b < MAX_PATTERNS; b++) sum += get_c_log2_c_score(new_row[b]);
+    p_table->p_sum_c_log_c[index] = sum;
+
+    // 3. Add the word as an ANSWER to every other guess row
+#pragma omp parallel for schedule(static)
+    for (int g = 0; g < count; g++)
+    {
+        if (g == index) continue;
+        int* row = p_table->p_bucket_counts + (size_t)g * MAX_PATTERNS;
+        int bucket = get_feedback_index(p_dictionary[g].word, added_word);
+        int c = row[bucket];
+        p_table->p_sum_c_log_c[g] += get_c_log2_c_score(c + 1) - get_c_log2_c_score(c);
+        row[bucket] = c + 1;
+    }
+
+    p_table->row_count = count;
+    p_table->answer_count++;
+    return true;
+}
+
+/*
+ * FUNCTION: partition_table_apply_entropy
+ *
+ * WHAT:
+ * H = log2(n) - Sum( c * log2(c) ) / n, for every row.
+ *
+ * WHY:
+ * Algebraically identical to -Sum( p * log2(p) ) with p = c / n, but needs
+ * only the cached sum instead of a 243-bucket scan.
+ */
+void partition_table_apply_entropy(const partition_table_t* p_table, dictionary_entry_t* p_dictionary)
+{
+    for (int g = 0; g < p_table->row_count; g++)
+    {
+        p_dictionary[g].entropy_score = calculate_entropy_score_from_sum(p_table->p_sum_c_log_c[g], p_table->answer_count);
+    }
+}
+
+/*
+ * FUNCTION: partition_table_apply_exact_entropy
+ */
+void partition_table_apply_exact_entropy(const partition_table_t* p_table, dictionary_entry_t* p_dictionary)
+{
+#pragma omp parallel for schedule(static)
+    for (int g = 0; g < p_table->row_count; g++)
+    {
+        p_dictionary[g].entropy_score = calculate_entropy_score_from_histogram(p_table->p_bucket_counts + (size_t)g * MAX_PATTERNS, p_table->answer_count);
+    }
+}
+
+/*
+ * FUNCTION: free_partition_table
+ */
+void free_partition_table(partition_table_t* p_table)
+{
+    if (p_table->row_capacity > 0) memory_budget_release(table_memory_id(), TABLE_ROW_BYTES * p_table->row_capacity);
+    if (p_table->p_bucket_counts != NULL) tracked_free(p_table->p_bucket_counts);
+    if (p_table->p_sum_c_log_c != NULL) tracked_free(p_table->p_sum_c_log_c);
+    p_table->p_bucket_counts = NULL;
+    p_table->p_sum_c_log_c = NULL;
+    p_table->row_count = 0;
+    p_table->row_capacity = 0;
+    p_table->answer_count = 0;
+}
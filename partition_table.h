@@ -0,0 +1,157 @@
+/*
+ * FILE: partition_table.h
+ *
+ * WHAT:
+ * Defines the interface for the Incremental Partition Table.
+ * For every word in a dictionary (treated as a GUESS), the table keeps the
+ * full 243-bucket histogram of feedback patterns against every word in the
+ * same dictionary (treated as an ANSWER), plus the running sum of c*log2(c)
+ * over those buckets.
+ *
+ * WHY:
+ * `calculate_entropy_on_dictionary` is an O(N^2) pass. That is fine once at
+ * startup, but the Historical Replay removes one answer per simulated day and
+ * needs the opener entropy of the shrunken pool every time. With the histograms
+ * kept around, removing one answer only touches one bucket per guess row, so
+ * the opener entropy of the whole dictionary is refreshed in O(N) instead of
+ * O(N^2).
+ */
+
+#pragma once
+#ifndef PARTITION_TABLE_H
+#define PARTITION_TABLE_H
+#include "wordle_types.h"
+
+/*
+ * STRUCT: partition_table_t
+ *
+ * WHAT:
+ * Row `i` belongs to dictionary entry `i`. Rows are kept in the same order
+ * as the dictionary array they were built from, so callers that delete an
+ * entry from their array must delete the matching row as well.
+ *
+ * FIELDS:
+ * - row_count: Number of live rows (== dictionary word count).
+ * - row_capacity: Number of rows the buffers can hold before growing.
+ * - answer_count: Number of answers contributing to every histogram.
+ * - p_bucket_counts: row_count * MAX_PATTERNS pattern counts (row-major).
+ * - p_sum_c_log_c: Per row, Sum( c * log2(c) ) over the non-empty buckets, as
+ * a fixed-point score (see `get_c_log2_c_score`).
+ *
+ * WHY:
+ * Entropy can be rewritten as H = log2(n) - Sum( c * log2(c) ) / n.
+ * Keeping the sum per row means a single bucket change updates H in O(1).
+ */
+typedef struct _partition_table
+{
+    int row_count;
+    int row_capacity;
+    int answer_count;
+    int* p_bucket_counts;
+    long long* p_sum_c_log_c;
+} partition_table_t;
+
+/*
+ * FUNCTION: build_partition_table
+ *
+ * WHAT:
+ * Allocates the table and fills it with the full N x N pattern histograms
+ * for `p_dictionary` (every word as guess, every word as answer).
+ *
+ * RETURNS:
+ * - true if successful, false if memory allocation fails.
+ *
+ * WHY:
+ * This is the one-off O(N^2) cost. Every later update is incremental.
+ */
+bool build_partition_table(partition_table_t* p_table, const dictionary_entry_t* p_dictionary, int count);
+
+/*
+ * FUNCTION: partition_table_remove_word
+ *
+ * WHAT:
+ * Removes dictionary entry `index` from the table, both as an ANSWER (its
+ * pattern is subtracted from every remaining guess row) and as a GUESS (its
+ * row is deleted, shifting later rows down by one).
+ *
+ * WHY:
+ * Mirrors what the load-time "Used Words" filter does: a used answer is
+ * removed from the dictionary entirely. The caller must remove the same
+ * entry from its dictionary array so rows and entries stay aligned.
+ */
+void partition_table_remove_word(partition_table_t* p_table, const dictionary_entry_t* p_dictionary, int index);
+
+/*
+ * FUNCTION: partition_table_remove_words
+ *
+ * WHAT:
+ * Batch form of `partition_table_remove_word`. Removes every entry listed in
+ * `p_indices` (ascending, no duplicates) as an ANSWER from every surviving
+ * row, then deletes their rows in a single compaction pass.
+ *
+ * WHY:
+ * Applying the ~1,500 "Used Words" one at a time would move the whole table
+ * once per word. The batch version does the same O(rows x removed) pattern
+ * work but moves each surviving row at most once.
+ */
+void partition_table_remove_words(partition_table_t* p_table, const dictionary_entry_t* p_dictionary, const int* p_indices, int index_count);
+
+/*
+ * FUNCTION: partition_table_insert_word
+ *
+ * WHAT:
+ * Adds dictionary entry `index` to the table, both as a GUESS (a new row is
+ * inserted at `index` and filled against every answer) and as an ANSWER (its
+ * pattern is added to every other guess row).
+ *
+ * PARAMETERS:
+ * - p_dictionary: The dictionary AFTER the new entry was inserted at `index`.
+ * - count: The dictionary word count AFTER the insert.
+ *
+ * RETURNS:
+ * - true if successful, false if the row buffers could not grow.
+ *
+ * WHY:
+ * The mirror image of `partition_table_remove_word`. Both cost O(N) feedback
+ * computations, so a long-running process can accept new words without the
+ * O(N^2) rebuild.
+ */
+bool partition_table_insert_word(partition_table_t* p_table, const dictionary_entry_t* p_dictionary, int count, int index);
+
+/*
+ * FUNCTION: partition_table_apply_entropy
+ *
+ * WHAT:
+ * Writes the current entropy of every row into the `entropy_score` field of
+ * the matching dictionary entry.
+ *
+ * WHY:
+ * Produces the same values `calculate_entropy_on_dictionary` would compute
+ * for an un-eliminated dictionary, at O(N) cost.
+ */
+void partition_table_apply_entropy(const partition_table_t* p_table, dictionary_entry_t* p_dictionary);
+
+/*
+ * FUNCTION: partition_table_apply_exact_entropy
+ *
+ * WHAT:
+ * Same as `partition_table_apply_entropy`, but recomputes every row's entropy
+ * from its histogram with `calculate_entropy_score_from_histogram`.
+ *
+ * WHY:
+ * The running sums are exact integers, so both give the same scores. This
+ * one does not trust the sums: the startup pipeline hands its result to the
+ * rest of the program, and the verifier compares the two. Costs O(N x 243),
+ * still far below the O(N^2) pass.
+ */
+void partition_table_apply_exact_entropy(const partition_table_t* p_table, dictionary_entry_t* p_dictionary);
+
+/*
+ * FUNCTION: free_partition_table
+ *
+ * WHAT:
+ * Releases the histogram memory and resets the table to empty.
+ */
+void free_partition_table(partition_table_t* p_table);
+
+#endif
@@ -0,0 +1,354 @@
+/*
+ * FILE: pattern_cache.cpp
+ *
+ * WHAT:
+ * Implements the Row-on-Demand Pattern Cache.
+ *
+ * HOW:
+ * - Lookup: under the lock, map guess -> slot. On a hit, pin the slot and
+ * move it to the head of the LRU list.
+ * - Miss: under the lock, take a free slot or the least recently used
+ * unpinned one (if the new guess has more than twice the lookups of the
+ * one it would replace), map it to the new guess as "not ready" and pin it. Then,
+ * outside the lock, fill the row and mark it ready.
+ * - Release: an atomic unpin, no lock.
+ * - Reclaim (memory manager): under the lock, drop unpinned slots from the
+ * LRU tail for good and free their rows.
+ *
+ * WHY:
+ * Rows are only read after they are ready and only rewritten once unpinned,
+ * so the row bytes never need the lock; the critical sections are a handful
+ * of integer updates per scored guess.
+ */
+
+#include "pattern_cache.h"
+#include "entropy_calculator.h"
+#include "memory_budget.h"
+#include "alloc_tracker.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * HELPER: lru_unlink
+ */
+static void lru_unlink(pattern_cache_t* p_cache, int slot)
+{
+    int prev = p_cache->p_lru_prev[slot];
+    int next = p_cache->p_lru_next[slot];
+    if (prev >= 0) p_cache->p_lru_next[prev] = next; else p_cache->lru_head = next;
+    if (next >= 0) p_cache->p_lru_prev[next] = prev; else p_cache->lru_tail = prev;
+    p_cache->p_lru_prev[slot] = -1;
+    p_cache->p_lru_next[slot] = -1;
+}
+
+/*
+ * HELPER: lru_push_front
+ */
+static void lru_push_front(pattern_cache_t* p_cache, int slot)
+{
+    p_cache->p_lru_prev[slot] = -1;
+    p_cache->p_lru_next[slot] = p_cache->lru_head;
+    if (p_cache->lru_head >= 0) p_cache->p_lru_prev[p_cache->lru_head] = slot;
+    p_cache->lru_head = slot;
+    if (p_cache->lru_tail < 0) p_cache->lru_tail = slot;
+}
+
+/*
+ * HELPER: count_lookup
+ *
+ * WHAT:
+ * Bumps the guess's lookup count. Every `universe_count * 8` lookups all
+ * counts are halved, so guesses that were hot long ago can be displaced.
+ */
+static void count_lookup(pattern_cache_t* p_cache, int guess_index)
+{
+    p_cache->p_access_count[guess_index]++;
+    if (--p_cache->lookups_until_aging > 0) return;
+
+    for (int i = 0; i < p_cache->universe_count; i++) p_cache->p_access_count[i] >>= 1;
+    p_cache->lookups_until_aging = p_cache->universe_count * 8;
+}
+
+/*
+ * HELPER: shrink_pattern_cache
+ *
+ * WHAT:
+ * Memory manager callback. Retires unpinned slots, least recently used
+ * first, until `bytes_wanted` is covered. Retired slots leave the LRU list,
+ * so they are never used again.
+ */
+static size_t shrink_pattern_cache(void* p_context, size_t bytes_wanted)
+{
+    pattern_cache_t* p_cache = (pattern_cache_t*)p_context;
+    size_t row_bytes = (size_t)p_cache->universe_count;
+    size_t freed = 0;
+
+    omp_set_lock(&p_cache->lock);
+    int slot = p_cache->lru_tail;
+    while (slot >= 0 && freed < bytes_wanted)
+    {
+        int prev = p_cache->p_lru_prev[slot];
+        int pins;
+#pragma omp atomic read
+        pins = p_cache->p_pin_count[slot];
+        if (pins == 0)
+        {
+            int old_guess = p_cache->p_guess_of_slot[slot];
+            if (old_guess >= 0) p_cache->p_slot_of_guess[old_guess] = -1;
+            p_cache->p_guess_of_slot[slot] = -1;
+            tracked_free(p_cache->p_row_of_slot[slot]);
+            p_cache->p_row_of_slot[slot] = NULL;
+            lru_unlink(p_cache, slot);
+            p_cache->slot_count--;
+            freed += row_bytes;
+        }
+        slot = prev;
+    }
+    omp_unset_lock(&p_cache->lock);
+    return freed;
+}
+
+/*
+ * HELPER: report_pattern_cache_hits
+ */
+static void report_pattern_cache_hits(void* p_context, long long* p_hits, long long* p_lookups)
+{
+    const pattern_cache_t* p_cache = (const pattern_cache_t*)p_context;
+    *p_hits = p_cache->hits;
+    *p_lookups = p_cache->hits + p_cache->misses + p_cache->bypasses;
+}
+
+/*
+ * FUNCTION: init_pattern_cache
+ *
+ * WHAT:
+ * 1. Size the bookkeeping for the rows wanted: `budget_bytes` worth, capped
+ * at one slot per word.
+ * 2. Allocate the bookkeeping arrays.
+ * 3. Copy the universe words and stamp `dictionary_index`.
+ * 4. Register with the memory manager once, with the reclaim callback, and
+ * reserve the rows; only the granted slots become usable.
+ * 5. Put every usable slot on the LRU list as free (free slots are used
+ * first because they sit at the tail).
+ */
+bool init_pattern_cache(pattern_cache_t* p_cache, dictionary_entry_t* p_universe, int universe_count, size_t budget_bytes)
+{
+    memset(p_cache, 0, sizeof(pattern_cache_t));
+    p_cache->lru_head = -1;
+    p_cache->lru_tail = -1;
+    p_cache->memory_id = -1;
+    if (universe_count <= 0) return false;
+
+    // 1. Pool size
+    size_t row_bytes = (size_t)universe_count;
+    size_t wanted = budget_bytes / row_bytes;
+    if (wanted > (size_t)universe_count) wanted = (size_t)universe_count;
+
+    p_cache->universe_count = universe_count;
+    p_cache->slot_capacity = (int)wanted;
+
+    // 2. Allocation (calloc for the row pointers, flags and counters)
+    int alloc_slots = p_cache->slot_capacity > 0 ? p_cache->slot_capacity : 1;
+    p_cache->p_row_of_slot = (unsigned char**)tracked_calloc(alloc_slots, sizeof(unsigned char*));
+    p_cache->p_words = (char(*)[WORDLE_WORD_LENGTH + 1])tracked_malloc(sizeof(*p_cache->p_words) * universe_count);
+    p_cache->p_slot_of_guess = (int*)tracked_malloc(sizeof(int) * universe_count);
+    p_cache->p_guess_of_slot = (int*)tracked_malloc(sizeof(int) * alloc_slots);
+    p_cache->p_pin_count = (int*)tracked_calloc(alloc_slots, sizeof(int));
+    p_cache->p_is_ready = (bool*)tracked_calloc(alloc_slots, sizeof(bool));
+    p_cache->p_lru_prev = (int*)tracked_malloc(sizeof(int) * alloc_slots);
+    p_cache->p_lru_next = (int*)tracked_malloc(sizeof(int) * alloc_slots);
+    p_cache->p_access_count = (unsigned int*)tracked_calloc(universe_count, sizeof(unsigned int));
+    if (!p_cache->p_row_of_slot || !p_cache->p_words || !p_cache->p_slot_of_guess || !p_cache->p_guess_of_slot ||
+        !p_cache->p_pin_count || !p_cache->p_is_ready || !p_cache->p_lru_prev || !p_cache->p_lru_next || !p_cache->p_access_count)
+    {
+        tracked_free(p_cache->p_row_of_slot); tracked_free(p_cache->p_words); tracked_free(p_cache->p_slot_of_guess); tracked_free(p_cache->p_guess_of_slot);
+        tracked_free(p_cache->p_pin_count); tracked_free(p_cache->p_is_ready); tracked_free(p_cache->p_lru_prev); tracked_free(p_cache->p_lru_next);
+        tracked_free(p_cache->p_access_count);
+        memset(p_cache, 0, sizeof(pattern_cache_t));
+        return false;
+    }
+
+    // 3. Universe
+    for (int i = 0; i < universe_count; i++)
+    {
+        strcpy_s(p_cache->p_words[i], WORDLE_WORD_LENGTH + 1, p_universe[i].word);
+        p_cache->p_slot_of_guess[i] = -1;
+        p_universe[i].dictionary_index = i;
+    }
+
+    p_cache->lookups_until_aging = universe_count * 8;
+    omp_init_lock(&p_cache->lock);
+
+    // 4. Rows. Reserving only reclaims lower priorities, never this cache,
+    // whose LRU list is still empty anyway.
+    p_cache->memory_id = register_memory_consumer("Pattern cache", MEMORY_PRIORITY_CACHE, shrink_pattern_cache, report_pattern_cache_hits, p_cache);
+    size_t granted = memory_budget_reserve(p_cache->memory_id, wanted * row_bytes);
+    size_t slots = granted / row_bytes;
+    memory_budget_release(p_cache->memory_id, granted - slots * row_bytes);
+    p_cache->slot_count = (int)slots;
+
+    // 5. The granted slots, all free (the rest are never used)
+    for (int s = 0; s < p_cache->slot_capacity; s++)
+    {
+        p_cache->p_guess_of_slot[s] = -1;
+        if (s < p_cache->slot_count) lru_push_front(p_cache, s);
+    }
+    return true;
+}
+
+/*
+ * FUNCTION: pattern_cache_covers
+ */
+bool pattern_cache_covers(const pattern_cache_t* p_cache, dictionary_entry_t* const* ppEntries, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        if ((unsigned)ppEntries[i]->dictionary_index >= (unsigned)p_cache->universe_count) return false;
+    }
+    return true;
+}
+
+/*
+ * FUNCTION: pattern_cache_acquire_row
+ *
+ * WHAT:
+ * 1. Hit: pin, move to the head, return (or bypass if still being filled).
+ * 2. Miss: walk from the tail for the first unpinned slot; remap it if it
+ * is free or holds a much colder guess. The factor of two keeps guesses
+ * with similar counts from trading places (each trade costs a full row).
+ * 3. Fill the row outside the lock and publish it.
+ */
+const unsigned char* pattern_cache_acquire_row(pattern_cache_t* p_cache, int guess_index)
+{
+    if ((unsigned)guess_index >= (unsigned)p_cache->universe_count || p_cache->slot_count == 0) return NULL;
+
+    omp_set_lock(&p_cache->lock);
+    count_lookup(p_cache, guess_index);
+
+    // 1. Hit
+    int slot = p_cache->p_slot_of_guess[guess_index];
+    if (slot >= 0)
+    {
+        if (!p_cache->p_is_ready[slot])
+        {
+            p_cache->bypasses++;
+            omp_unset_lock(&p_cache->lock);
+            return NULL;
+        }
+        p_cache->hits++;
+#pragma omp atomic
+        p_cache->p_pin_count[slot]++;
+        lru_unlink(p_cache, slot);
+        lru_push_front(p_cache, slot);
+        omp_unset_lock(&p_cache->lock);
+        return p_cache->p_row_of_slot[slot];
+    }
+
+    // 2. Miss: least recently used unpinned slot
+    for (slot = p_cache->lru_tail; slot >= 0; slot = p_cache->p_lru_prev[slot])
+    {
+        int pins;
+#pragma omp atomic read
+        pins = p_cache->p_pin_count[slot];
+        if (pins == 0) break;
+    }
+    int old_guess = (slot >= 0) ? p_cache->p_guess_of_slot[slot] : -1;
+    if (slot < 0 || (old_guess >= 0 && p_cache->p_access_count[guess_index] <= 2 * p_cache->p_access_count[old_guess]))
+    {
+        p_cache->bypasses++;
+        omp_unset_lock(&p_cache->lock);
+        return NULL;
+    }
+
+    p_cache->misses++;
+    if (old_guess >= 0)
+    {
+        p_cache->p_slot_of_guess[old_guess] = -1;
+        p_cache->evictions++;
+    }
+    p_cache->p_guess_of_slot[slot] = guess_index;
+    p_cache->p_slot_of_guess[guess_index] = slot;
+    p_cache->p_is_ready[slot] = false;
+#pragma omp atomic
+    p_cache->p_pin_count[slot]++;
+    lru_unlink(p_cache, slot);
+    lru_push_front(p_cache, slot);
+    omp_unset_lock(&p_cache->lock);
+
+    // 3. Fill (only this thread can see the slot until it is ready)
+    unsigned char* p_row = p_cache->p_row_of_slot[slot];
+    if (p_row == NULL) p_row = (unsigned char*)tracked_malloc((size_t)p_cache->universe_count);
+    if (p_row == NULL)
+    {
+        // Out of memory: give the slot back empty
+        omp_set_lock(&p_cache->lock);
+        p_cache->p_slot_of_guess[guess_index] = -1;
+        p_cache->p_guess_of_slot[slot] = -1;
+#pragma omp atomic
+        p_cache->p_pin_count[slot]--;
+        omp_unset_lock(&p_cache->lock);
+        return NULL;
+    }
+
+    const char* guess = p_cache->p_words[guess_index];
+    for (int a = 0; a < p_cache->universe_count; a++)
+    {
+        p_row[a] = (unsigned char)get_feedback_index(guess, p_cache->p_words[a]);
+    }
+
+    omp_set_lock(&p_cache->lock);
+    p_cache->p_row_of_slot[slot] = p_row;
+    p_cache->p_is_ready[slot] = true;
+    omp_unset_lock(&p_cache->lock);
+    return p_row;
+}
+
+/*
+ * FUNCTION: pattern_cache_release_row
+ *
+ * WHY:
+ * A pinned row cannot be evicted, so its guess -> slot mapping is stable
+ * until the unpin and can be read without the lock.
+ */
+void pattern_cache_release_row(pattern_cache_t* p_cache, int guess_index)
+{
+    int slot = p_cache->p_slot_of_guess[guess_index];
+#pragma omp atomic
+    p_cache->p_pin_count[slot]--;
+}
+
+/*
+ * FUNCTION: print_pattern_cache_stats
+ */
+void print_pattern_cache_stats(const pattern_cache_t* p_cache)
+{
+    long long lookups = p_cache->hits + p_cache->misses + p_cache->bypasses;
+    double row_mb = (double)p_cache->slot_count * p_cache->universe_count / (1024.0 * 1024.0);
+    printf("Pattern cache: %d/%d rows (%.1f MB). Hits %lld (%.1f%%), misses %lld, bypasses %lld, evictions %lld.\n",
+        p_cache->slot_count, p_cache->universe_count, row_mb,
+        p_cache->hits, lookups > 0 ? 100.0 * p_cache->hits / lookups : 0.0,
+        p_cache->misses, p_cache->bypasses, p_cache->evictions);
+}
+
+/*
+ * FUNCTION: free_pattern_cache
+ */
+void free_pattern_cache(pattern_cache_t* p_cache)
+{
+    if (p_cache->p_row_of_slot == NULL) return;
+    unregister_memory_consumer(p_cache->memory_id);
+    memory_budget_release(p_cache->memory_id, (size_t)p_cache->slot_count * p_cache->universe_count);
+    omp_destroy_lock(&p_cache->lock);
+    for (int s = 0; s < p_cache->slot_capacity; s++) tracked_free(p_cache->p_row_of_slot[s]);
+    tracked_free(p_cache->p_row_of_slot);
+    tracked_free(p_cache->p_words);
+    tracked_free(p_cache->p_slot_of_guess);
+    tracked_free(p_cache->p_guess_of_slot);
+    tracked_free(p_cache->p_pin_count);
+    tracked_free(p_cache->p_is_ready);
+    tracked_free(p_cache->p_lru_prev);
+    tracked_free(p_cache->p_lru_next);
+    tracked_free(p_cache->p_access_count);
+    memset(p_cache, 0, sizeof(pattern_cache_t));
+}
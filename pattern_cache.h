@@ -0,0 +1,169 @@
+/*
+ * FILE: pattern_cache.h
+ *
+ * WHAT:
+ * Defines the interface for the Row-on-Demand Pattern Cache.
+ * A "row" is the feedback pattern (0-242, one byte) of one GUESS against
+ * every word of a fixed universe (the dictionary the cache was built for),
+ * treated as ANSWERS. Rows are computed the first time a guess is scored and
+ * kept until the memory budget forces the least recently used row out.
+ * A row only replaces another if its guess has been asked for more than
+ * twice as often (frequency-gated admission).
+ *
+ * WHY:
+ * A full N x N pattern matrix is 42 MB at 6,500 words, 2.5 GB at 50,000 and
+ * out of reach beyond that. The tournament and the replay score the same few
+ * thousand guesses over and over, so most of the benefit of a full matrix
+ * comes from the rows that are actually hot. With a budget, the hot rows are
+ * table lookups and everything else falls back to computing patterns directly,
+ * which is what happened before the cache existed.
+ */
+
+#pragma once
+#ifndef PATTERN_CACHE_H
+#define PATTERN_CACHE_H
+#include "wordle_types.h"
+#include <omp.h>
+
+/*
+ * CONSTANT: PATTERN_CACHE_DEFAULT_BUDGET_MB
+ *
+ * WHAT:
+ * Memory for cached rows (megabytes). Enough for the full matrix of the
+ * shipped dictionary; larger vocabularies keep their hottest rows.
+ */
+#define PATTERN_CACHE_DEFAULT_BUDGET_MB 256
+
+/*
+ * STRUCT: pattern_cache_t
+ *
+ * WHAT:
+ * A fixed pool of row slots with a guess -> slot map and an LRU list.
+ *
+ * FIELDS:
+ * - universe_count: Words in the universe (= bytes per row).
+ * - slot_capacity: Slots the bookkeeping arrays were sized for (the rows
+ * wanted).
+ * - slot_count: Slots still usable (may be 0: every lookup bypasses). Below
+ * `slot_capacity` when the memory manager granted fewer rows or reclaims
+ * some.
+ * - p_row_of_slot: Per slot, its row buffer (allocated on first fill).
+ * - p_slot_of_guess: Per universe word, its slot or -1.
+ * - p_guess_of_slot: Per slot, the universe word it holds or -1 (free).
+ * - p_pin_count: Per slot, callers currently reading the row. Pinned rows
+ * are never evicted.
+ * - p_is_ready: Per slot, false while the row is still being filled.
+ * - p_lru_prev / p_lru_next, lru_head (most recent) / lru_tail (least recent).
+ * - p_access_count: Per universe word, lookups so far (halved periodically).
+ * - lookups_until_aging: Lookups left before the next halving.
+ * - hits / misses / bypasses / evictions: Counters for the end-of-run report.
+ * - lock: Guards everything above except the row bytes themselves.
+ *
+ * WHY:
+ * The lock is held only for the map and list updates; filling a row happens
+ * outside it, so other threads keep reading their own rows meanwhile.
+ * Admission matters because every turn scores all candidates in the same
+ * order: with plain LRU and a budget below the working set, each lookup
+ * would evict exactly the row needed next, and a miss (N patterns) costs
+ * far more than scoring the guess directly against a small answer set.
+ */
+typedef struct _pattern_cache
+{
+    int universe_count;
+    int slot_capacity;
+    int slot_count;
+    unsigned char** p_row_of_slot;
+    char (*p_words)[WORDLE_WORD_LENGTH + 1];
+    int* p_slot_of_guess;
+    int* p_guess_of_slot;
+    int* p_pin_count;
+    bool* p_is_ready;
+    int* p_lru_prev;
+    int* p_lru_next;
+    int lru_head;
+    int lru_tail;
+    unsigned int* p_access_count;
+    int lookups_until_aging;
+    long long hits;
+    long long misses;
+    long long bypasses;
+    long long evictions;
+    int memory_id;
+    omp_lock_t lock;
+} pattern_cache_t;
+
+/*
+ * GLOBAL: g_p_pattern_cache
+ *
+ * WHAT:
+ * The cache the entropy engine consults, or NULL (patterns are computed
+ * directly). Set by `main` for the Monte Carlo and Replay modes.
+ */
+extern pattern_cache_t* g_p_pattern_cache;
+
+/*
+ * FUNCTION: init_pattern_cache
+ *
+ * WHAT:
+ * Reserves row memory from the memory manager (at most `budget_bytes`, at
+ * most one row per word), sizes the slot pool to what was granted, and
+ * stamps `dictionary_index` = position on every entry of `p_universe`.
+ * Row buffers are only allocated when first filled.
+ *
+ * WHY:
+ * Working copies made with `memcpy` after this call carry the stamp along, so
+ * any entry from the universe finds its column (as an answer) and its row (as
+ * a guess) in O(1), even after Hard Mode re-sorts the copy.
+ *
+ * RETURNS:
+ * - false if memory allocation fails.
+ */
+bool init_pattern_cache(pattern_cache_t* p_cache, dictionary_entry_t* p_universe, int universe_count, size_t budget_bytes);
+
+/*
+ * FUNCTION: pattern_cache_covers
+ *
+ * WHAT:
+ * true if every entry in `ppEntries` carries a stamp from this universe.
+ */
+bool pattern_cache_covers(const pattern_cache_t* p_cache, dictionary_entry_t* const* ppEntries, int count);
+
+/*
+ * FUNCTION: pattern_cache_acquire_row
+ *
+ * WHAT:
+ * Returns the row for universe word `guess_index` (computing it on a miss),
+ * pinned until `pattern_cache_release_row`. `row[answer->dictionary_index]`
+ * is then the feedback index of the guess against that answer.
+ *
+ * RETURNS:
+ * - NULL if the caller should compute patterns directly: the index is not
+ * in the universe, the budget holds no rows, every slot is pinned, the
+ * guess is colder than the row it would replace, or another thread is
+ * still filling this row.
+ */
+const unsigned char* pattern_cache_acquire_row(pattern_cache_t* p_cache, int guess_index);
+
+/*
+ * FUNCTION: pattern_cache_release_row
+ *
+ * WHAT:
+ * Unpins the row of `guess_index` after a successful
+ * `pattern_cache_acquire_row`.
+ */
+void pattern_cache_release_row(pattern_cache_t* p_cache, int guess_index);
+
+/*
+ * FUNCTION: print_pattern_cache_stats
+ */
+void print_pattern_cache_stats(const pattern_cache_t* p_cache);
+
+/*
+ * FUNCTION: free_pattern_cache
+ *
+ * WHAT:
+ * Frees every row and returns the reservation to the memory manager.
+ */
+void free_pattern_cache(pattern_cache_t* p_cache);
+
+#endif
@@ -0,0 +1,132 @@
+/*
+ * FILE: perf_counters.cpp
+ *
+ * WHAT:
+ * Implements the hardware counters with `perf_event_open` on Linux, and a
+ * stand-in that reports them unavailable everywhere else.
+ */
+
+#include "perf_counters.h"
+#include <stdio.h>
+#include <string.h>
+#ifdef __linux__
+#include <errno.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+#ifdef __linux__
+
+/*
+ * HELPER: open_counter
+ *
+ * WHAT:
+ * One disabled, user-space-only event on the calling thread. The read
+ * format carries the enabled and running times for multiplexing.
+ */
+static int open_counter(unsigned int type, unsigned long long config)
+{
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+/*
+ * FUNCTION: open_perf_counters
+ */
+bool open_perf_counters(perf_counters_t* p_counters)
+{
+    const unsigned long long L1D_READ_MISS = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+
+    p_counters->fds[PERF_COUNTER_CYCLES] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    int first_error = errno;
+    p_counters->fds[PERF_COUNTER_INSTRUCTIONS] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    p_counters->fds[PERF_COUNTER_BRANCH_MISSES] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+    p_counters->fds[PERF_COUNTER_L1D_MISSES] = open_counter(PERF_TYPE_HW_CACHE, L1D_READ_MISS);
+    p_counters->fds[PERF_COUNTER_LLC_MISSES] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+
+    int open_count = 0;
+    for (int c = 0; c < PERF_COUNTER_COUNT; c++)
+    {
+        p_counters->values[c] = -1;
+        if (p_counters->fds[c] >= 0) open_count++;
+    }
+    if (open_count > 0) return true;
+
+    printf("Hardware counters unavailable: perf_event_open failed (%s).\n", strerror(first_error));
+    if (first_error == EACCES || first_error == EPERM) printf("    Allow them with: sysctl kernel.perf_event_paranoid=2\n");
+    else if (first_error == ENOENT || first_error == EOPNOTSUPP) printf("    This CPU or VM exposes no hardware events.\n");
+    return false;
+}
+
+/*
+ * FUNCTION: close_perf_counters
+ */
+void close_perf_counters(perf_counters_t* p_counters)
+{
+    for (int c = 0; c < PERF_COUNTER_COUNT; c++)
+    {
+        if (p_counters->fds[c] >= 0) close(p_counters->fds[c]);
+        p_counters->fds[c] = -1;
+    }
+}
+
+/*
+ * FUNCTION: start_perf_counters
+ */
+void start_perf_counters(perf_counters_t* p_counters)
+{
+    for (int c = 0; c < PERF_COUNTER_COUNT; c++)
+    {
+        if (p_counters->fds[c] < 0) continue;
+        ioctl(p_counters->fds[c], PERF_EVENT_IOC_RESET, 0);
+        ioctl(p_counters->fds[c], PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+/*
+ * FUNCTION: stop_perf_counters
+ *
+ * WHY:
+ * With more events than hardware counters the kernel time-slices them;
+ * value * enabled / running estimates the full-interval count.
+ */
+void stop_perf_counters(perf_counters_t* p_counters)
+{
+    for (int c = 0; c < PERF_COUNTER_COUNT; c++)
+    {
+        if (p_counters->fds[c] >= 0) ioctl(p_counters->fds[c], PERF_EVENT_IOC_DISABLE, 0);
+    }
+    for (int c = 0; c < PERF_COUNTER_COUNT; c++)
+    {
+        unsigned long long data[3]; // value, time enabled, time running
+        p_counters->values[c] = -1;
+        if (p_counters->fds[c] < 0 || read(p_counters->fds[c], data, sizeof(data)) != (ssize_t)sizeof(data)) continue;
+        if (data[2] == 0) continue; // Never scheduled onto a hardware counter
+        p_counters->values[c] = (data[2] < data[1]) ? (long long)((double)data[0] * data[1] / data[2]) : (long long)data[0];
+    }
+}
+
+#else
+
+bool open_perf_counters(perf_counters_t* p_counters)
+{
+    for (int c = 0; c < PERF_COUNTER_COUNT; c++) { p_counters->fds[c] = -1; p_counters->values[c] = -1; }
+    printf("Hardware counters unavailable: perf_event_open is Linux only.\n");
+    return false;
+}
+
+void close_perf_counters(perf_counters_t* p_counters) { (void)p_counters; }
+void start_perf_counters(perf_counters_t* p_counters) { (void)p_counters; }
+void stop_perf_counters(perf_counters_t* p_counters) { (void)p_counters; }
+
+#endif
@@ -0,0 +1,74 @@
+/*
+ * FILE: perf_counters.h
+ *
+ * WHAT:
+ * Defines the interface for hardware performance counters (Linux
+ * `perf_event_open`): cycles, instructions, branch misses, L1 data cache
+ * misses and last-level cache misses of the calling thread, user space
+ * only, between a start and a stop.
+ *
+ * WHY:
+ * Wall time says a kernel got slower, not why. Instructions per cycle and
+ * misses per feedback computation tell a branch-bound feedback loop from
+ * one that waits on memory (the `ppValidAnswers` pointers, the pattern
+ * rows) or one that is simply doing more work.
+ *
+ * AVAILABILITY:
+ * Counters are opened one by one, so a machine that lacks one event (many
+ * VMs have no LLC event, containers often have no PMU at all) still reports
+ * the rest. Unavailable counters read as -1. With none available, or on a
+ * platform other than Linux, `open_perf_counters` returns false and says
+ * why; the benchmarks then run without them.
+ */
+
+#pragma once
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+/*
+ * CONSTANTS: Counters
+ */
+#define PERF_COUNTER_CYCLES 0
+#define PERF_COUNTER_INSTRUCTIONS 1
+#define PERF_COUNTER_BRANCH_MISSES 2
+#define PERF_COUNTER_L1D_MISSES 3
+#define PERF_COUNTER_LLC_MISSES 4
+#define PERF_COUNTER_COUNT 5
+
+/*
+ * STRUCT: perf_counters_t
+ *
+ * FIELDS:
+ * - fds: One event per counter (-1 = unavailable).
+ * - values: The counts of the last start/stop interval (-1 = unavailable),
+ * scaled up if the kernel had to multiplex the counters.
+ */
+typedef struct _perf_counters
+{
+    int fds[PERF_COUNTER_COUNT];
+    long long values[PERF_COUNTER_COUNT];
+} perf_counters_t;
+
+/*
+ * FUNCTION: open_perf_counters / close_perf_counters
+ *
+ * WHAT:
+ * Opens the counters for the calling thread only (run the measured code on
+ * this thread, e.g. with `omp_set_num_threads(1)`).
+ *
+ * RETURNS (open):
+ * - false if no counter could be opened (the reason is printed).
+ */
+bool open_perf_counters(perf_counters_t* p_counters);
+void close_perf_counters(perf_counters_t* p_counters);
+
+/*
+ * FUNCTION: start_perf_counters / stop_perf_counters
+ *
+ * WHAT:
+ * Resets and enables every open counter; disables them and reads `values`.
+ */
+void start_perf_counters(perf_counters_t* p_counters);
+void stop_perf_counters(perf_counters_t* p_counters);
+
+#endif
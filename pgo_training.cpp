@@ -0,0 +1,253 @@
+/*
+ * FILE: pgo_training.cpp
+ *
+ * WHAT:
+ * Implements the PGO Training Workload.
+ *
+ * HOW:
+ * 1. Sample: every (count / N)-th dictionary word, so letter statistics,
+ * ranks and tags keep the shape of the full file.
+ * 2. Tournaments: the sample gets its opener entropy and a pattern cache,
+ * exactly as `main` prepares a batch run, then `run_monte_carlo_simulation`
+ * plays the roster in Normal Mode, Hard Mode and Fibble.
+ * 3. Interactive sessions: on the FULL dictionary (what a player searches),
+ * with the cache switched off (interactive play never has one),
+ * `play_scripted_session` repeats the per-turn work of `run_interactive_mode`
+ * against answers spread over the dictionary, feeding back the pattern the
+ * answer produces instead of reading it from stdin.
+ */
+
+#include "pgo_training.h"
+#include "monte_carlo.h"
+#include "solver_logic.h"
+#include "entropy_calculator.h"
+#include "duplicate_dictionary.h"
+#include "comparators.h"
+#include "hybrid_strategies.h"
+#include "noise_filter.h"
+#include "pattern_cache.h"
+#include "alloc_tracker.h"
+#include <stdio.h>
+#include <string.h>
+#include <omp.h>
+
+#define MAX_GUESSES 6
+extern bool g_isHardMode;
+extern bool g_isFibbleMode;
+
+/*
+ * CONSTANT: PGO_TRAIN_TOP_N
+ *
+ * WHAT:
+ * Rows of partition statistics asked for per turn (as the interactive
+ * statistics table does).
+ */
+#define PGO_TRAIN_TOP_N 10
+
+/*
+ * HELPER: refresh_views
+ *
+ * WHAT:
+ * Rebuilds both sorted views over the first `count` entries, with the
+ * comparator the interactive loop uses for the current mode.
+ */
+static void refresh_views(dictionary_entry_t* p_data, int count, dictionary_pointer_array_t* pp_entropy, dictionary_pointer_array_t* pp_rank)
+{
+    tracked_free(*pp_entropy); *pp_entropy = NULL;
+    tracked_free(*pp_rank); *pp_rank = NULL;
+    duplicate_dictionary_pointers(p_data, count, pp_entropy, g_isHardMode ? compare_dictionary_entries_by_entropy_desc : compare_dictionary_entries_by_entropy_no_filter_desc);
+    duplicate_dictionary_pointers(p_data, count, pp_rank, compare_dictionary_entries_by_rank_desc);
+}
+
+/*
+ * HELPER: play_scripted_session
+ *
+ * WHAT:
+ * One interactive game against `p_answer` with the Champion, turn by turn:
+ * 1. Collect the valid answers; ask for the smart pick, the four category
+ * picks and the top-N statistics.
+ * 2. Play the smart pick; the feedback is what the answer produces (with
+ * one lie per row in Fibble).
+ * 3. Apply it the way the interactive loop does (letter minimums and the
+ * constraint filter, or the noisy filter), then recompute entropy and the
+ * views: candidates against the valid set in Normal Mode, compaction and
+ * a Hard Mode pass otherwise.
+ *
+ * RETURNS:
+ * - The guesses taken, or 0 if the game was not solved.
+ */
+static int play_scripted_session(const dictionary_entry_t* p_dictionary, int count, const dictionary_entry_t* p_answer)
+{
+    dictionary_entry_t* p_data = (dictionary_entry_t*)tracked_malloc(sizeof(dictionary_entry_t) * count);
+    dictionary_entry_t** ppValidAnswers = (dictionary_entry_t**)tracked_malloc(sizeof(dictionary_entry_t*) * count);
+    if (!p_data || !ppValidAnswers) { tracked_free(p_data); tracked_free(ppValidAnswers); return 0; }
+    memcpy(p_data, p_dictionary, sizeof(dictionary_entry_t) * count);
+
+    dictionary_pointer_array_t p_entropy_sorted = NULL;
+    dictionary_pointer_array_t p_rank_sorted = NULL;
+    refresh_views(p_data, count, &p_entropy_sorted, &p_rank_sorted);
+
+    HybridConfig championConfig = ALL_STRATEGIES[0];
+    int min_required_counts[26] = { 0 };
+    feedback_history_t history;
+    memset(&history, 0, sizeof(history));
+    recommendations_array_t candidates;
+    partition_stats_t stats[PGO_TRAIN_TOP_N];
+
+    int active_count = count;
+    int solved_turn = 0;
+    for (int turn = 1; turn <= MAX_GUESSES && solved_turn == 0; turn++)
+    {
+        // 1. Recommendations
+        int validCount = 0;
+        for (int i = 0; i < active_count; ++i)
+        {
+            if (!p_data[i].is_eliminated) ppValidAnswers[validCount++] = &p_data[i];
+        }
+        if (validCount == 0) break;
+
+        int pool = g_isHardMode ? validCount : active_count;
+        const dictionary_entry_t* pSmartPick = get_smart_hybrid_guess(p_entropy_sorted, p_rank_sorted, pool, &championConfig, min_required_counts, validCount, turn);
+        get_best_guess_candidates(p_entropy_sorted, p_rank_sorted, pool, candidates);
+        recommend_top_n(p_entropy_sorted, pool, ppValidAnswers, validCount, PGO_TRAIN_TOP_N, stats);
+        if (pSmartPick == NULL) pSmartPick = ppValidAnswers[0];
+
+        // 2. Feedback
+        char guess[WORDLE_WORD_LENGTH + 1];
+        char result_pattern[WORDLE_WORD_LENGTH + 1];
+        strcpy_s(guess, sizeof(guess), pSmartPick->word);
+        int result_code = get_feedback_index(guess, p_answer->word);
+        if (strcmp(guess, p_answer->word) == 0) { solved_turn = turn; break; }
+        if (g_isFibbleMode) result_code = inject_feedback_lie(result_code, p_answer->word, turn);
+        decode_feedback_index(result_code, result_pattern);
+        record_feedback(&history, guess, result_code);
+
+        // 3. Filter, entropy, views
+        if (g_isFibbleMode)
+        {
+            apply_noisy_feedback(p_data, active_count, guess, result_code, &FIBBLE_NOISE_MODEL);
+        }
+        else
+        {
+            update_min_required_counts(guess, result_pattern, min_required_counts);
+            filter_dictionary_by_constraints(p_data, active_count, guess, result_pattern, NULL);
+        }
+
+        if (!g_isHardMode)
+        {
+            validCount = 0;
+            for (int i = 0; i < active_count; ++i)
+            {
+                if (!p_data[i].is_eliminated) ppValidAnswers[validCount++] = &p_data[i];
+            }
+            if (validCount == 0) break;
+            calculate_entropy_for_candidates(p_data, active_count, ppValidAnswers, validCount);
+        }
+        else
+        {
+            qsort(p_data, active_count, sizeof(dictionary_entry_t), compare_master_entries_eliminated_then_alpha);
+            int new_count = active_count;
+            for (int i = 0; i < active_count; ++i)
+            {
+                if (p_data[i].is_eliminated) { new_count = i; break; }
+            }
+            active_count = new_count;
+            if (active_count == 0) break;
+            calculate_entropy_on_dictionary(p_data, active_count);
+        }
+        refresh_views(p_data, active_count, &p_entropy_sorted, &p_rank_sorted);
+    }
+
+    tracked_free(p_entropy_sorted);
+    tracked_free(p_rank_sorted);
+    tracked_free(ppValidAnswers);
+    tracked_free(p_data);
+    return solved_turn;
+}
+
+/*
+ * FUNCTION: run_pgo_training
+ *
+ * WHAT:
+ * Sample, tournaments in each mode, then scripted interactive sessions in
+ * each mode. Prints the time of each phase and the sessions' results.
+ */
+void run_pgo_training(const dictionary_entry_t* p_dictionary, int count, int word_count)
+{
+    bool saved_hard_mode = g_isHardMode;
+    bool saved_fibble_mode = g_isFibbleMode;
+    pattern_cache_t* p_saved_cache = g_p_pattern_cache;
+
+    // 1. Sample
+    if (word_count <= 0 || word_count > count) word_count = count;
+    dictionary_entry_t* p_sample = (dictionary_entry_t*)tracked_malloc(sizeof(dictionary_entry_t) * word_count);
+    if (p_sample == NULL) { printf("Out of memory for the training sample.\n"); return; }
+    for (int i = 0; i < word_count; i++)
+    {
+        p_sample[i] = p_dictionary[(int)((long long)i * count / word_count)];
+        p_sample[i].is_eliminated = false;
+        p_sample[i].feedback_mismatches = 0;
+    }
+    calculate_entropy_on_dictionary(p_sample, word_count);
+
+    printf("\n=============================================\n");
+    printf("   PGO TRAINING WORKLOAD\n");
+    printf("   Sample: %d of %d words\n", word_count, count);
+    printf("=============================================\n");
+
+    const struct { const char* name; bool is_hard; bool is_fibble; } MODES[] = {
+        { "Normal", false, false }, { "Hard", true, false }, { "Fibble", false, true }
+    };
+    const int mode_count = (int)(sizeof(MODES) / sizeof(MODES[0]));
+
+    // 2. Tournaments (batch setup: pattern cache on)
+    double start = omp_get_wtime();
+    pattern_cache_t pattern_cache;
+    memset(&pattern_cache, 0, sizeof(pattern_cache));
+    bool has_cache = init_pattern_cache(&pattern_cache, p_sample, word_count, (size_t)PATTERN_CACHE_DEFAULT_BUDGET_MB * 1024 * 1024);
+    g_p_pattern_cache = has_cache ? &pattern_cache : NULL;
+    for (int m = 0; m < mode_count; m++)
+    {
+        g_isHardMode = MODES[m].is_hard;
+        g_isFibbleMode = MODES[m].is_fibble;
+        run_monte_carlo_simulation(p_sample, word_count);
+    }
+    g_p_pattern_cache = NULL;
+    if (has_cache) free_pattern_cache(&pattern_cache);
+    double tournament_seconds = omp_get_wtime() - start;
+
+    // 3. Interactive sessions (full dictionary, no cache, as in interactive play)
+    start = omp_get_wtime();
+    dictionary_entry_t* p_full = (dictionary_entry_t*)tracked_malloc(sizeof(dictionary_entry_t) * count);
+    if (p_full == NULL) { printf("Out of memory for the interactive sessions.\n"); count = 0; }
+    else
+    {
+        memcpy(p_full, p_dictionary, sizeof(dictionary_entry_t) * count);
+        for (int i = 0; i < count; i++) { p_full[i].is_eliminated = false; p_full[i].feedback_mismatches = 0; }
+        calculate_entropy_on_dictionary(p_full, count);
+    }
+    printf("\n--- Scripted interactive sessions (%d per mode) ---\n", PGO_TRAIN_SESSIONS);
+    for (int m = 0; m < mode_count; m++)
+    {
+        g_isHardMode = MODES[m].is_hard;
+        g_isFibbleMode = MODES[m].is_fibble;
+
+        int solved = 0, total_guesses = 0;
+        for (int s = 0; s < PGO_TRAIN_SESSIONS && count > 0; s++)
+        {
+            const dictionary_entry_t* p_answer = &p_full[(int)((long long)(2 * s + 1) * count / (2 * PGO_TRAIN_SESSIONS))];
+            int guesses = play_scripted_session(p_full, count, p_answer);
+            if (guesses > 0) { solved++; total_guesses += guesses; }
+        }
+        printf("   %-6s: solved %d/%d, avg %.2f guesses\n", MODES[m].name, solved, PGO_TRAIN_SESSIONS, solved ? (double)total_guesses / solved : 0.0);
+    }
+    tracked_free(p_full);
+    double session_seconds = omp_get_wtime() - start;
+
+    printf("\nPGO training finished: tournaments %.1fs, interactive sessions %.1fs.\n", tournament_seconds, session_seconds);
+
+    g_isHardMode = saved_hard_mode;
+    g_isFibbleMode = saved_fibble_mode;
+    g_p_pattern_cache = p_saved_cache;
+    tracked_free(p_sample);
+}
@@ -0,0 +1,50 @@
+/*
+ * FILE: pgo_training.h
+ *
+ * WHAT:
+ * Defines the interface for the PGO Training Workload (`--pgo-train`). It
+ * drives the engine's hot paths with a fixed, prompt-free script so an
+ * instrumented build (CMake `-DWORDLE_PGO=GENERATE`) can record a profile:
+ * - Tournaments: the regular roster in Normal Mode, Hard Mode and Fibble
+ * (pattern cache on, row-lookup kernel, OpenMP game loop, Turn 2 memo).
+ * - Interactive sessions: the per-turn work of the interactive loop
+ * (smart guess, category picks, top-N statistics, letter minimums,
+ * constraint or noisy filter, candidate entropy with the direct kernel,
+ * re-sorting the views) against scripted answers, in all three modes.
+ *
+ * WHY:
+ * A compiler only optimizes a profile as well as the run that produced it.
+ * Interactive play waits on the user and needs the network for the history,
+ * and a full tournament takes minutes, so neither makes a usable training
+ * run. This workload reads only the dictionary file, uses no clock or random
+ * seed in its decisions, and runs in about a minute, so every profile is
+ * built from the same mix.
+ */
+
+#pragma once
+#ifndef PGO_TRAINING_H
+#define PGO_TRAINING_H
+#include "wordle_types.h"
+
+/*
+ * CONSTANTS: Training Size
+ *
+ * WHAT:
+ * - PGO_TRAIN_DEFAULT_WORDS: Words taken (evenly spaced) from the dictionary
+ * for the tournaments. `--pgo-train=N` overrides it.
+ * - PGO_TRAIN_SESSIONS: Scripted interactive games per mode (full dictionary).
+ */
+#define PGO_TRAIN_DEFAULT_WORDS 1500
+#define PGO_TRAIN_SESSIONS 12
+
+/*
+ * FUNCTION: run_pgo_training
+ *
+ * WHAT:
+ * Runs the tournaments on an evenly spaced sample of `word_count` words
+ * from `p_dictionary` and the interactive sessions on all of it (it is not
+ * modified). Hard Mode, Fibble and the pattern cache are restored afterwards.
+ */
+void run_pgo_training(const dictionary_entry_t* p_dictionary, int count, int word_count);
+
+#endif
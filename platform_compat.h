@@ -0,0 +1,84 @@
+/*
+ * FILE: platform_compat.h
+ *
+ * WHAT:
+ * Portable stand-ins for the MSVC "secure CRT" functions the engine uses
+ * (`strcpy_s`, `sprintf_s`, `fopen_s` and `errno_t`) when compiling with
+ * GCC or Clang. Under MSVC this header is empty and the real CRT versions
+ * are used.
+ *
+ * WHY:
+ * The code was written against the Visual Studio CRT, which has no
+ * equivalent in glibc. Keeping the MSVC spelling at every call site and
+ * mapping it here means the Windows build is untouched and the Linux build
+ * (CMakeLists.txt) needs no per-file #ifdefs.
+ *
+ * NOTE:
+ * Only the three-argument forms used in this code base are provided.
+ * Truncation behaves like `snprintf` (the result is always terminated);
+ * MSVC would instead invoke its invalid-parameter handler.
+ */
+
+#pragma once
+#ifndef PLATFORM_COMPAT_H
+#define PLATFORM_COMPAT_H
+
+#ifndef _MSC_VER
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <errno.h>
+
+typedef int errno_t;
+
+/*
+ * FUNCTION: strcpy_s
+ *
+ * RETURNS:
+ * - 0, or ERANGE if `src` did not fit (the copy is truncated).
+ */
+static inline errno_t strcpy_s(char* dest, size_t dest_size, const char* src)
+{
+    if (dest == NULL || dest_size == 0) return EINVAL;
+    size_t length = strlen(src);
+    if (length >= dest_size)
+    {
+        memcpy(dest, src, dest_size - 1);
+        dest[dest_size - 1] = '\0';
+        return ERANGE;
+    }
+    memcpy(dest, src, length + 1);
+    return 0;
+}
+
+/*
+ * FUNCTION: sprintf_s
+ *
+ * RETURNS:
+ * - The number of characters written, or -1 on error.
+ */
+static inline int sprintf_s(char* buffer, size_t buffer_size, const char* format, ...) __attribute__((format(printf, 3, 4)));
+static inline int sprintf_s(char* buffer, size_t buffer_size, const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    int written = vsnprintf(buffer, buffer_size, format, args);
+    va_end(args);
+    return (written < 0 || (size_t)written >= buffer_size) ? -1 : written;
+}
+
+/*
+ * FUNCTION: fopen_s
+ *
+ * RETURNS:
+ * - 0 on success, otherwise the `errno` of the failed `fopen`.
+ */
+static inline errno_t fopen_s(FILE** pp_file, const char* path, const char* mode)
+{
+    if (pp_file == NULL) return EINVAL;
+    *pp_file = fopen(path, mode);
+    return (*pp_file != NULL) ? 0 : errno;
+}
+#endif
+
+#endif
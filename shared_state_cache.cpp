@@ -0,0 +1,314 @@
+/*
+ * FILE: shared_state_cache.cpp
+ *
+ * WHAT:
+ * Implements the Shared State Cache on a memory-mapped file
+ * (`CreateFileMapping` on Windows, `mmap` elsewhere).
+ *
+ * LAYOUT:
+ * [header][SHARED_CACHE_CAPACITY slots]. A freshly created file is all
+ * zeroes, which is a valid "uninitialized header, all slots empty" state,
+ * so no process ever has to clear the table.
+ */
+
+#include "shared_state_cache.h"
+#include "game_state.h"
+#include "memory_budget.h"
+#include "entropy_calculator.h"
+#include <stdio.h>
+#include <string.h>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+/*
+ * STRUCT: shared_cache_header_t
+ *
+ * FIELDS:
+ * - init_state: 0 = fresh file, 1 = a process is writing the header, 2 = ready.
+ * - format_version / version_key / capacity: Checked by every opener.
+ */
+typedef struct _shared_cache_header
+{
+    std::atomic<unsigned int> init_state;
+    unsigned int format_version;
+    unsigned long long version_key;
+    unsigned int capacity;
+} shared_cache_header_t;
+
+/*
+ * STRUCT: shared_cache_slot_t
+ *
+ * FIELDS:
+ * - key: 0 = empty. Claimed with compare-and-swap.
+ * - is_ready: Set (release) after `guess` is written.
+ * - guess: The decided guess.
+ */
+typedef struct _shared_cache_slot
+{
+    std::atomic<unsigned long long> key;
+    std::atomic<unsigned int> is_ready;
+    char guess[WORDLE_WORD_LENGTH + 1];
+} shared_cache_slot_t;
+
+static_assert(sizeof(std::atomic<unsigned long long>) == sizeof(unsigned long long), "shared slots need plain 64-bit atomics");
+
+static const unsigned int HEADER_READY = 2;
+static const size_t HEADER_BYTES = 64; // Keeps the slots cache-line aligned
+
+/*
+ * HELPER: mix64
+ *
+ * WHAT:
+ * SplitMix64 finalizer (same mixer as the Zobrist keys).
+ */
+static unsigned long long mix64(unsigned long long x)
+{
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+/*
+ * FUNCTION: compute_shared_cache_version
+ *
+ * WHAT:
+ * Order-independent: XOR of one mixed value per entry (word key, rank, tags).
+ */
+unsigned long long compute_shared_cache_version(const dictionary_entry_t* p_dictionary, int count, bool is_hard_mode, double decision_budget_ms)
+{
+    unsigned long long version = mix64(SHARED_CACHE_FORMAT_VERSION) ^ mix64(is_hard_mode ? 0x48415244ULL : 0x4E4F524DULL);
+
+    // Scoring that decides ties differently decides positions differently
+    version ^= mix64(0x53434F52ULL + ((unsigned long long)ENTROPY_SCORE_FORMAT << 8) + ENTROPY_SCORE_FRACTION_BITS);
+
+    // Budget in microseconds (0 = unbudgeted)
+    unsigned long long budget_us = (decision_budget_ms > 0.0) ? (unsigned long long)(decision_budget_ms * 1000.0 + 0.5) : 0;
+    version ^= mix64(0x42554447ULL + budget_us);
+    for (int i = 0; i < count; i++)
+    {
+        const dictionary_entry_t* pEntry = &p_dictionary[i];
+        unsigned long long tags = ((unsigned long long)pEntry->frequency_rank << 16) | ((unsigned long long)(unsigned char)pEntry->noun_type << 8) | (unsigned char)pEntry->verb_type;
+        version ^= mix64(word_zobrist_key(pEntry->word) ^ tags);
+    }
+    return version;
+}
+
+/*
+ * FUNCTION: make_shared_state_key
+ */
+unsigned long long make_shared_state_key(unsigned long long pool_hash, unsigned long long candidate_hash,
+    int turn, const int* min_required_counts, const char* strategy_name)
+{
+    unsigned long long key = mix64(pool_hash) ^ mix64(candidate_hash + (unsigned long long)turn);
+
+    unsigned long long counts = 0;
+    for (int i = 0; i < 26; i++) counts = counts * 7 + (unsigned long long)min_required_counts[i];
+    key = mix64(key ^ counts);
+
+    // FNV-1a over the strategy name
+    unsigned long long name_hash = 0xCBF29CE484222325ULL;
+    for (const char* p = strategy_name; *p != '\0'; p++) name_hash = (name_hash ^ (unsigned char)*p) * 0x100000001B3ULL;
+    key = mix64(key ^ name_hash);
+
+    return (key != 0) ? key : 1;
+}
+
+/*
+ * HELPER: map_file
+ *
+ * WHAT:
+ * Opens or creates `path`, sizes a new file to `bytes`, and maps it.
+ * An existing file must already be exactly `bytes` long.
+ */
+static bool map_file(shared_state_cache_t* p_cache, const char* path, size_t bytes)
+{
+#ifdef _WIN32
+    HANDLE h_file = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (h_file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(h_file, &size) || (size.QuadPart != 0 && (size_t)size.QuadPart != bytes)) { CloseHandle(h_file); return false; }
+
+    // Mapping a larger size than the file grows it (zero-filled)
+    HANDLE h_mapping = CreateFileMappingA(h_file, NULL, PAGE_READWRITE, (DWORD)((unsigned long long)bytes >> 32), (DWORD)(bytes & 0xFFFFFFFF), NULL);
+    if (h_mapping == NULL) { CloseHandle(h_file); return false; }
+
+    void* p_mapping = MapViewOfFile(h_mapping, FILE_MAP_ALL_ACCESS, 0, 0, bytes);
+    if (p_mapping == NULL) { CloseHandle(h_mapping); CloseHandle(h_file); return false; }
+
+    p_cache->h_file = h_file;
+    p_cache->h_mapping = h_mapping;
+#else
+    int fd = open(path, O_RDWR | O_CREAT, 0666);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) { close(fd); return false; }
+    if (st.st_size == 0)
+    {
+        // Two processes may both get here; both set the same size (zero-filled)
+        if (ftruncate(fd, (off_t)bytes) != 0) { close(fd); return false; }
+    }
+    else if ((size_t)st.st_size != bytes)
+    {
+        close(fd);
+        return false;
+    }
+
+    void* p_mapping = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (p_mapping == MAP_FAILED) { close(fd); return false; }
+
+    p_cache->fd = fd;
+#endif
+    p_cache->p_mapping = p_mapping;
+    p_cache->mapping_bytes = bytes;
+    return true;
+}
+
+/*
+ * HELPER: report_shared_cache_hits
+ */
+static void report_shared_cache_hits(void* p_context, long long* p_hits, long long* p_lookups)
+{
+    const shared_state_cache_t* p_cache = (const shared_state_cache_t*)p_context;
+    *p_hits = p_cache->hits;
+    *p_lookups = p_cache->hits + p_cache->misses;
+}
+
+/*
+ * FUNCTION: open_shared_state_cache
+ *
+ * WHAT:
+ * 1. Map the file.
+ * 2. Header: the first process to see a fresh file writes it; others wait
+ * (up to a few seconds) for it to become ready.
+ * 3. Reject a file with a different format, capacity or version.
+ * 4. Account the mapping with the memory manager.
+ */
+bool open_shared_state_cache(shared_state_cache_t* p_cache, const char* path, unsigned long long version_key)
+{
+    memset(p_cache, 0, sizeof(shared_state_cache_t));
+    p_cache->memory_id = -1;
+    size_t bytes = HEADER_BYTES + sizeof(shared_cache_slot_t) * (size_t)SHARED_CACHE_CAPACITY;
+
+    // 1. Map
+    if (!map_file(p_cache, path, bytes))
+    {
+        printf("Warning: Could not map shared cache '%s' (unreadable, or not a %zu-byte cache file).\n", path, bytes);
+        return false;
+    }
+    p_cache->p_header = p_cache->p_mapping;
+    p_cache->p_slots = (char*)p_cache->p_mapping + HEADER_BYTES;
+    shared_cache_header_t* p_header = (shared_cache_header_t*)p_cache->p_header;
+
+    // 2. Initialize or wait
+    unsigned int expected = 0;
+    if (p_header->init_state.compare_exchange_strong(expected, 1))
+    {
+        p_header->format_version = SHARED_CACHE_FORMAT_VERSION;
+        p_header->version_key = version_key;
+        p_header->capacity = SHARED_CACHE_CAPACITY;
+        p_header->init_state.store(HEADER_READY, std::memory_order_release);
+    }
+    for (int wait = 0; wait < 500 && p_header->init_state.load(std::memory_order_acquire) != HEADER_READY; wait++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    // 3. Validate
+    bool is_ready = (p_header->init_state.load(std::memory_order_acquire) == HEADER_READY);
+    if (!is_ready || p_header->format_version != SHARED_CACHE_FORMAT_VERSION || p_header->capacity != SHARED_CACHE_CAPACITY || p_header->version_key != version_key)
+    {
+        printf("Warning: Shared cache '%s' was built for a different dictionary, mode or decision budget. Not using it (delete it or pick another path).\n", path);
+        close_shared_state_cache(p_cache);
+        return false;
+    }
+
+    // 4. Account
+    p_cache->memory_id = register_memory_consumer("Shared state cache", MEMORY_PRIORITY_REQUIRED, NULL, report_shared_cache_hits, p_cache);
+    memory_budget_charge(p_cache->memory_id, bytes);
+    return true;
+}
+
+/*
+ * FUNCTION: shared_state_cache_lookup
+ */
+bool shared_state_cache_lookup(shared_state_cache_t* p_cache, unsigned long long key, char* guess)
+{
+    shared_cache_slot_t* p_slots = (shared_cache_slot_t*)p_cache->p_slots;
+    unsigned int mask = SHARED_CACHE_CAPACITY - 1;
+
+    for (int probe = 0; probe < SHARED_CACHE_MAX_PROBES; probe++)
+    {
+        shared_cache_slot_t* p_slot = &p_slots[(key + probe) & mask];
+        unsigned long long slot_key = p_slot->key.load(std::memory_order_acquire);
+        if (slot_key == 0) break; // Keys are never removed: an empty slot ends the chain
+        if (slot_key != key) continue;
+
+        if (p_slot->is_ready.load(std::memory_order_acquire) == 0) break; // Being written
+        memcpy(guess, p_slot->guess, WORDLE_WORD_LENGTH + 1);
+#pragma omp atomic
+        p_cache->hits++;
+        return true;
+    }
+#pragma omp atomic
+    p_cache->misses++;
+    return false;
+}
+
+/*
+ * FUNCTION: shared_state_cache_insert
+ */
+void shared_state_cache_insert(shared_state_cache_t* p_cache, unsigned long long key, const char* guess)
+{
+    shared_cache_slot_t* p_slots = (shared_cache_slot_t*)p_cache->p_slots;
+    unsigned int mask = SHARED_CACHE_CAPACITY - 1;
+
+    for (int probe = 0; probe < SHARED_CACHE_MAX_PROBES; probe++)
+    {
+        shared_cache_slot_t* p_slot = &p_slots[(key + probe) & mask];
+        unsigned long long expected = 0;
+        if (p_slot->key.compare_exchange_strong(expected, key))
+        {
+            memcpy(p_slot->guess, guess, WORDLE_WORD_LENGTH);
+            p_slot->guess[WORDLE_WORD_LENGTH] = '\0';
+            p_slot->is_ready.store(1, std::memory_order_release);
+#pragma omp atomic
+            p_cache->inserts++;
+            return;
+        }
+        if (expected == key) return; // Another thread or process got there first
+    }
+}
+
+/*
+ * FUNCTION: close_shared_state_cache
+ */
+void close_shared_state_cache(shared_state_cache_t* p_cache)
+{
+    if (p_cache->p_mapping == NULL) return;
+    if (p_cache->memory_id >= 0)
+    {
+        unregister_memory_consumer(p_cache->memory_id);
+        memory_budget_release(p_cache->memory_id, p_cache->mapping_bytes);
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(p_cache->p_mapping);
+    CloseHandle((HANDLE)p_cache->h_mapping);
+    CloseHandle((HANDLE)p_cache->h_file);
+#else
+    munmap(p_cache->p_mapping, p_cache->mapping_bytes);
+    close(p_cache->fd);
+#endif
+    memset(p_cache, 0, sizeof(shared_state_cache_t));
+}
@@ -0,0 +1,148 @@
+/*
+ * FILE: shared_state_cache.h
+ *
+ * WHAT:
+ * Defines the interface for the Shared State Cache: a fixed-size hash table
+ * in a memory-mapped file (`--shared-cache=path`) that maps a game position
+ * to the guess the bot decided on there. Every process that maps the same
+ * file sees every other process's decisions.
+ *
+ * A position key covers everything a decision depends on:
+ * - The pool the game started from and the live candidate set (Zobrist
+ * hashes, see game_state.h).
+ * - The turn, the letter minimums, and the strategy.
+ * The file header carries a version key (format, entropy score format,
+ * dictionary contents, Hard Mode, decision budget); a file written under a
+ * different version is not used. Only complete decisions are stored: one
+ * cut short by the decision budget is the best guess so far, not the
+ * position's decision.
+ *
+ * WHY:
+ * Several tournament or replay processes on one host replay the same
+ * post-opener positions over and over, and so does a single tournament
+ * (every answer with the same opener pattern reaches the same Turn 2
+ * position). Deciding a position costs a full entropy scan; looking it up
+ * costs a few probes.
+ *
+ * CONCURRENCY:
+ * Inserts are lock-free: a slot is claimed with a compare-and-swap on its
+ * key, filled, then published with a release store on its ready flag.
+ * Readers only trust a slot after an acquire load of that flag. Slots are
+ * never removed, so no reader can see a half-rewritten entry. On Linux, put
+ * the file in `/dev/shm` to keep it in RAM.
+ */
+
+#pragma once
+#ifndef SHARED_STATE_CACHE_H
+#define SHARED_STATE_CACHE_H
+#include "wordle_types.h"
+
+/*
+ * CONSTANTS: Table Geometry
+ *
+ * WHAT:
+ * - SHARED_CACHE_CAPACITY: Slots in the table (power of two, 24 MB file).
+ * - SHARED_CACHE_MAX_PROBES: Linear probe limit; past it an insert is dropped.
+ * - SHARED_CACHE_FORMAT_VERSION: Bump when the layout, the key recipe or the
+ * decision rules change. Version 2: fixed-point entropy scores (exact ties).
+ */
+#define SHARED_CACHE_CAPACITY (1 << 20)
+#define SHARED_CACHE_MAX_PROBES 32
+#define SHARED_CACHE_FORMAT_VERSION 2
+
+/*
+ * STRUCT: shared_state_cache_t
+ *
+ * WHAT:
+ * One process's view of the mapping, plus its own counters.
+ */
+typedef struct _shared_state_cache
+{
+    void* p_mapping;
+    size_t mapping_bytes;
+    void* p_header;
+    void* p_slots;
+    int memory_id;
+    long long hits;
+    long long misses;
+    long long inserts;
+#ifdef _WIN32
+    void* h_file;
+    void* h_mapping;
+#else
+    int fd;
+#endif
+} shared_state_cache_t;
+
+/*
+ * GLOBAL: g_p_shared_cache
+ *
+ * WHAT:
+ * The open cache, or NULL (`--shared-cache` not given or not usable).
+ */
+extern shared_state_cache_t* g_p_shared_cache;
+
+/*
+ * FUNCTION: compute_shared_cache_version
+ *
+ * WHAT:
+ * Hash of the format version, the entropy score format, every dictionary
+ * field that can influence a decision, the Hard Mode flag and the decision
+ * budget (a budgeted run must
+ * not be served another budget's decisions, or the trade-off it measures is
+ * lost).
+ */
+unsigned long long compute_shared_cache_version(const dictionary_entry_t* p_dictionary, int count, bool is_hard_mode, double decision_budget_ms);
+
+/*
+ * FUNCTION: make_shared_state_key
+ *
+ * WHAT:
+ * Mixes the parts of a position into one 64-bit key (never 0, which marks
+ * an empty slot).
+ */
+unsigned long long make_shared_state_key(unsigned long long pool_hash, unsigned long long candidate_hash,
+    int turn, const int* min_required_counts, const char* strategy_name);
+
+/*
+ * FUNCTION: open_shared_state_cache
+ *
+ * WHAT:
+ * Creates or opens the file at `path`, maps it, and initializes or checks
+ * the header against `version_key`.
+ *
+ * RETURNS:
+ * - false (with a printed reason) if the file cannot be mapped, has the
+ * wrong size, or was written for a different version.
+ */
+bool open_shared_state_cache(shared_state_cache_t* p_cache, const char* path, unsigned long long version_key);
+
+/*
+ * FUNCTION: shared_state_cache_lookup
+ *
+ * WHAT:
+ * Copies the decided guess for `key` into `guess` (6 bytes).
+ *
+ * RETURNS:
+ * - true on a hit.
+ */
+bool shared_state_cache_lookup(shared_state_cache_t* p_cache, unsigned long long key, char* guess);
+
+/*
+ * FUNCTION: shared_state_cache_insert
+ *
+ * WHAT:
+ * Publishes the decided guess for `key`. Does nothing if the key is already
+ * present (or being inserted) or its probe window is full.
+ */
+void shared_state_cache_insert(shared_state_cache_t* p_cache, unsigned long long key, const char* guess);
+
+/*
+ * FUNCTION: close_shared_state_cache
+ *
+ * WHAT:
+ * Unmaps the file (its contents stay for the next process).
+ */
+void close_shared_state_cache(shared_state_cache_t* p_cache);
+
+#endif
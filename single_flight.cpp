@@ -0,0 +1,136 @@
+/*
+ * FILE: single_flight.cpp
+ *
+ * WHAT:
+ * Implements Request Coalescing with a mutex, one condition variable and a
+ * fixed table of in-flight keys.
+ *
+ * LIFECYCLE OF A KEY:
+ * 1. The first `single_flight_join` claims a free entry and leads.
+ * 2. Later joins find the entry, count themselves as waiters and sleep.
+ * 3. `single_flight_finish` stores the guess, marks the entry done and wakes
+ * everyone. A join that arrives after this copies the guess at once. An
+ * abandoned key (no guess) sends every waiter off to compute it alone.
+ * 4. The last waiter to copy (or the leader, if nobody waited) frees the entry.
+ */
+
+#include "single_flight.h"
+#include <string.h>
+#include <new>
+#include <mutex>
+#include <condition_variable>
+
+/*
+ * STRUCT: flight_entry_t
+ *
+ * FIELDS:
+ * - key: The position being decided (0 = free entry).
+ * - waiters: Joins still waiting for (or copying) the guess.
+ * - is_done: The leader has published `guess`.
+ */
+typedef struct _flight_entry
+{
+    unsigned long long key;
+    int waiters;
+    bool is_done;
+    char guess[WORDLE_WORD_LENGTH + 1];
+} flight_entry_t;
+
+typedef struct _single_flight_impl
+{
+    std::mutex lock;
+    std::condition_variable finished;
+    flight_entry_t entries[SINGLE_FLIGHT_MAX_IN_FLIGHT];
+} single_flight_impl_t;
+
+/*
+ * FUNCTION: init_single_flight
+ */
+bool init_single_flight(single_flight_t* p_flight)
+{
+    memset(p_flight, 0, sizeof(single_flight_t));
+    single_flight_impl_t* p_impl = new (std::nothrow) single_flight_impl_t;
+    if (p_impl == NULL) return false;
+    memset(p_impl->entries, 0, sizeof(p_impl->entries));
+    p_flight->p_impl = p_impl;
+    return true;
+}
+
+/*
+ * FUNCTION: free_single_flight
+ *
+ * WHY:
+ * Only called once the batch run is over, so no thread can still be waiting.
+ */
+void free_single_flight(single_flight_t* p_flight)
+{
+    delete (single_flight_impl_t*)p_flight->p_impl;
+    p_flight->p_impl = NULL;
+}
+
+/*
+ * FUNCTION: single_flight_join
+ */
+int single_flight_join(single_flight_t* p_flight, unsigned long long key, char* guess)
+{
+    single_flight_impl_t* p_impl = (single_flight_impl_t*)p_flight->p_impl;
+    std::unique_lock<std::mutex> guard(p_impl->lock);
+
+    flight_entry_t* p_free = NULL;
+    for (int i = 0; i < SINGLE_FLIGHT_MAX_IN_FLIGHT; i++)
+    {
+        flight_entry_t* p_entry = &p_impl->entries[i];
+        if (p_entry->key == key)
+        {
+            // Someone is (or just finished) deciding this position: wait for it
+            p_entry->waiters++;
+            p_impl->finished.wait(guard, [p_entry] { return p_entry->is_done; });
+            bool is_abandoned = (p_entry->guess[0] == '\0');
+            if (!is_abandoned) strcpy_s(guess, WORDLE_WORD_LENGTH + 1, p_entry->guess);
+            if (--p_entry->waiters == 0) p_entry->key = 0;
+            if (is_abandoned)
+            {
+                p_flight->bypassed++;
+                return SINGLE_FLIGHT_BYPASS;
+            }
+            p_flight->coalesced++;
+            return SINGLE_FLIGHT_COALESCED;
+        }
+        if (p_entry->key == 0 && p_free == NULL) p_free = p_entry;
+    }
+
+    if (p_free == NULL)
+    {
+        p_flight->bypassed++;
+        return SINGLE_FLIGHT_BYPASS;
+    }
+
+    p_free->key = key;
+    p_free->waiters = 0;
+    p_free->is_done = false;
+    p_flight->computed++;
+    return SINGLE_FLIGHT_LEADER;
+}
+
+/*
+ * FUNCTION: single_flight_finish
+ */
+void single_flight_finish(single_flight_t* p_flight, unsigned long long key, const char* guess)
+{
+    single_flight_impl_t* p_impl = (single_flight_impl_t*)p_flight->p_impl;
+    {
+        std::lock_guard<std::mutex> guard(p_impl->lock);
+        for (int i = 0; i < SINGLE_FLIGHT_MAX_IN_FLIGHT; i++)
+        {
+            flight_entry_t* p_entry = &p_impl->entries[i];
+            if (p_entry->key != key || p_entry->is_done) continue;
+
+            if (guess != NULL) strcpy_s(p_entry->guess, WORDLE_WORD_LENGTH + 1, guess);
+            else p_entry->guess[0] = '\0';
+            p_entry->is_done = true;
+            if (p_entry->waiters == 0) p_entry->key = 0;
+            break;
+        }
+    }
+    p_impl->finished.notify_all();
+}
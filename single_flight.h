@@ -0,0 +1,114 @@
+/*
+ * FILE: single_flight.h
+ *
+ * WHAT:
+ * Defines the interface for Request Coalescing ("single flight"): when
+ * several threads ask for the decision of the same position at the same
+ * time, the first one computes it and the others wait for its result
+ * instead of repeating the work.
+ *
+ * The key is the Shared State Cache position key (`make_shared_state_key`:
+ * candidate set, pool, turn, letter minimums and strategy). The game mode
+ * is fixed for the whole process, so it does not need to be part of it.
+ *
+ * WHY:
+ * Concurrent games reach identical positions at the same moment: every
+ * answer with the same opener pattern lands in the same Turn 2 state, and
+ * the parallel tournament starts them side by side. The Shared State Cache
+ * only helps once a decision is finished; until then each thread misses
+ * and computes the same full entropy scan. Coalescing closes that window.
+ * It stores nothing once a decision is handed over; remembering decisions
+ * is the caches' job.
+ *
+ * CONCURRENCY:
+ * One mutex guards a small table of in-flight keys; waiters sleep on a
+ * condition variable. A decision takes milliseconds and the table is only
+ * touched twice per decision, so the lock is not contended.
+ */
+
+#pragma once
+#ifndef SINGLE_FLIGHT_H
+#define SINGLE_FLIGHT_H
+#include "wordle_types.h"
+
+/*
+ * CONSTANT: SINGLE_FLIGHT_MAX_IN_FLIGHT
+ *
+ * WHAT:
+ * Distinct keys computed at once. Each thread leads at most one, so this
+ * only has to exceed the thread count; past it a request is computed alone.
+ */
+#define SINGLE_FLIGHT_MAX_IN_FLIGHT 256
+
+/*
+ * CONSTANTS: Join Results
+ *
+ * WHAT:
+ * - SINGLE_FLIGHT_LEADER: Nobody is computing the key. The caller must
+ * compute it and hand the result to `single_flight_finish`.
+ * - SINGLE_FLIGHT_COALESCED: Another thread computed it; the guess was copied.
+ * - SINGLE_FLIGHT_BYPASS: The table is full, or the leader abandoned the key.
+ * Compute without coalescing (and do not call `single_flight_finish`).
+ */
+#define SINGLE_FLIGHT_LEADER 0
+#define SINGLE_FLIGHT_COALESCED 1
+#define SINGLE_FLIGHT_BYPASS 2
+
+/*
+ * STRUCT: single_flight_t
+ *
+ * WHAT:
+ * The in-flight table (opaque) and its counters (updated under its lock).
+ */
+typedef struct _single_flight
+{
+    void* p_impl;
+    long long computed;     /* Requests that led a computation            */
+    long long coalesced;    /* Requests answered by another's computation */
+    long long bypassed;     /* Requests computed alone (full, abandoned)  */
+} single_flight_t;
+
+/*
+ * GLOBAL: g_p_single_flight
+ *
+ * WHAT:
+ * The coalescer used by batch runs, or NULL (interactive play, Fibble).
+ */
+extern single_flight_t* g_p_single_flight;
+
+/*
+ * FUNCTION: init_single_flight / free_single_flight
+ *
+ * RETURNS (init):
+ * - false if out of memory.
+ */
+bool init_single_flight(single_flight_t* p_flight);
+void free_single_flight(single_flight_t* p_flight);
+
+/*
+ * FUNCTION: single_flight_join
+ *
+ * WHAT:
+ * Registers interest in `key`. If another thread is already computing it,
+ * blocks until that thread finishes and copies its guess into `guess`
+ * (6 bytes).
+ *
+ * RETURNS:
+ * - SINGLE_FLIGHT_LEADER, SINGLE_FLIGHT_COALESCED or SINGLE_FLIGHT_BYPASS.
+ */
+int single_flight_join(single_flight_t* p_flight, unsigned long long key, char* guess);
+
+/*
+ * FUNCTION: single_flight_finish
+ *
+ * WHAT:
+ * Publishes the leader's `guess` for `key` and wakes its waiters. The key
+ * leaves the table once the last waiter has copied the guess.
+ *
+ * `guess` NULL abandons the key (the leader's guess is not fit to share,
+ * e.g. a decision cut short by its budget): the waiters are bypassed and
+ * compute the position themselves.
+ */
+void single_flight_finish(single_flight_t* p_flight, unsigned long long key, const char* guess);
+
+#endif
@@ -16,11 +16,13 @@
 
 #include "solver_logic.h"
 #include "entropy_calculator.h" 
+#include "trace_probes.h"
 #include <stdio.h>
 #include <stddef.h> 
 #include <string.h>
 #include <stdlib.h> 
 #include <math.h>   
+#include <omp.h>
 
 /*
  * CONSTANTS: Tuning Parameters
@@ -336,26 +338,38 @@ static double calculate_lookahead_bonus(const dictionary_entry_t* candidate, con
 {
     if (valid_count <= 1) return 0.0;
 
-    // Histogram of resulting bucket sizes for this candidate (243 possible patterns)
-    int bins[243] = { 0 };
+    double sum_squares = 0.0; int singles_count = 0; int max_bucket = 0;
 
-    // Simulate the guess against every valid answer
-    for (int i = 0; i < valid_count; i++)
+    if (valid_count <= SMALL_SET_MAX_ANSWERS)
     {
-        int pattern_idx = lookahead_feedback_index(candidate->word, p_rank_sorted[i]->word);
-        bins[pattern_idx]++;
+        // Few answers: the small-set kernel gives the same bucket statistics without a histogram
+        small_set_stats_t stats;
+        calculate_small_set_stats(candidate->word, p_rank_sorted, valid_count, &stats);
+        sum_squares = (double)stats.sum_squares;
+        singles_count = stats.singleton_count;
+        max_bucket = stats.max_bucket;
     }
+    else
+    {
+        // Histogram of resulting bucket sizes for this candidate (243 possible patterns)
+        int bins[243] = { 0 };
 
-    double sum_squares = 0.0; int singles_count = 0; int max_bucket = 0;
+        // Simulate the guess against every valid answer
+        for (int i = 0; i < valid_count; i++)
+        {
+            int pattern_idx = lookahead_feedback_index(candidate->word, p_rank_sorted[i]->word);
+            bins[pattern_idx]++;
+        }
 
-    // Analyze the distribution of buckets
-    for (int i = 0; i < 243; i++)
-    {
-        if (bins[i] > 0)
+        // Analyze the distribution of buckets
+        for (int i = 0; i < 243; i++)
         {
-            sum_squares += (double)bins[i] * (double)bins[i];
-            if (bins[i] == 1) singles_count++;
-            if (bins[i] > max_bucket) max_bucket = bins[i];
+            if (bins[i] > 0)
+            {
+                sum_squares += (double)bins[i] * (double)bins[i];
+                if (bins[i] == 1) singles_count++;
+                if (bins[i] > max_bucket) max_bucket = bins[i];
+            }
         }
     }
 
@@ -384,10 +398,34 @@ static double calculate_lookahead_bonus(const dictionary_entry_t* candidate, con
 }
 
 /*
- * FUNCTION: get_smart_hybrid_guess
+ * HELPER: passes_main_loop_filters
+ *
+ * WHAT:
+ * The candidate filters of the Standard Hybrid loop (Strategy C).
+ * 1. Endgame Solvers: a valid answer with 10 or fewer left skips the filters
+ * (we are trying to guess the answer directly).
+ * 2. Otherwise the Linguistic filter (off in panic mode, to allow more
+ * flexibility in splitting) and the Risk filter.
+ */
+static bool passes_main_loop_filters(const dictionary_entry_t* cand, const HybridConfig* config, const int* min_required_counts, int valid_count, int turn, bool is_endgame_panic)
+{
+    bool is_endgame_solver = (!cand->is_eliminated && valid_count <= 10);
+    if (is_endgame_solver) return true;
+
+    bool apply_ling = config->use_linguistic_filter && (turn >= config->linguistic_filter_start_turn);
+    if (is_endgame_panic) apply_ling = false;
+
+    if (apply_ling && !is_linguistically_sound(cand)) return false;
+    if (config->use_risk_filter && is_risky_guess(cand, min_required_counts)) return false;
+    return true;
+}
+
+/*
+ * HELPER: select_smart_hybrid_guess
  *
  * WHAT:
- * The Master Decision Engine.
+ * The Master Decision Engine (`get_anytime_hybrid_guess` without the tracepoints
+ * and the clock).
  * It evaluates candidates based on the active strategy configuration.
  *
  * FLOW:
@@ -399,8 +437,9 @@ static double calculate_lookahead_bonus(const dictionary_entry_t* candidate, con
  * - Iterates through candidates sorted by Entropy.
  * - Applies Linguistic Filters (unless in Panic Mode).
  * - Applies "Endgame Clamp": If valid_count <= 20, disable LookAhead/RankBias.
- * - Calculates Look Ahead bonus.
- * - Selects the best candidate.
+ * - Calculates Look Ahead bonus (shortlisted candidates in parallel, best-first
+ * until the deadline if there is one).
+ * - Selects the best candidate (first of equal scores, as a serial scan would).
  *
  * WHY:
  * This function consolidates all the experimental logic into a single pipeline.
@@ -408,14 +447,16 @@ static double calculate_lookahead_bonus(const dictionary_entry_t* candidate, con
  * and start being "safe" (Pure Greedy Entropy) when the word count gets low,
  * ensuring the 100% win rate.
  */
-const dictionary_entry_t* get_smart_hybrid_guess(
+static const dictionary_entry_t* select_smart_hybrid_guess(
     const dictionary_pointer_array_t p_entropy_sorted,
     const dictionary_pointer_array_t p_rank_sorted,
     int count,
     const HybridConfig* config,
     const int* min_required_counts,
     int valid_count,
-    int turn)
+    int turn,
+    double deadline,
+    decision_report_t* p_report)
 {
     if (count == 0) return NULL;
     const dictionary_entry_t* best_candidate = NULL;
@@ -461,7 +502,7 @@ const dictionary_entry_t* get_smart_hybrid_guess(
         int known = count_known_vowels(min_required_counts);
         if (known < 2)
         {
-            int best_new = -1; double best_ent = -1.0;
+            int best_new = -1; long long best_ent = -1;
             int scan = (count < 30) ? count : 30;
             for (int i = 0; i < scan; i++)
             {
@@ -472,8 +513,8 @@ const dictionary_entry_t* get_smart_hybrid_guess(
                 if (pass)
                 {
                     int v = count_new_vowels(cand->word, min_required_counts);
-                    if (v > best_new) { best_new = v; best_candidate = cand; best_ent = cand->entropy; }
-                    else if (v == best_new) { if (cand->entropy > best_ent) { best_candidate = cand; best_ent = cand->entropy; } }
+                    if (v > best_new) { best_new = v; best_candidate = cand; best_ent = cand->entropy_score; }
+                    else if (v == best_new) { if (cand->entropy_score > best_ent) { best_candidate = cand; best_ent = cand->entropy_score; } }
                 }
             }
             if (best_candidate != NULL) return best_candidate;
@@ -484,7 +525,7 @@ const dictionary_entry_t* get_smart_hybrid_guess(
     // Prioritize structural anchors or unique vowels in the first 2 turns.
     if (turn <= 2 && (config->prioritize_new_vowels || config->prioritize_anchors))
     {
-        int best_score = -1; double best_ent = -1.0;
+        int best_score = -1; long long best_ent = -1;
         int scan = (count < 30) ? count : 30;
         for (int i = 0; i < scan; i++)
         {
@@ -496,8 +537,8 @@ const dictionary_entry_t* get_smart_hybrid_guess(
             if (pass)
             {
                 int sc = config->prioritize_anchors ? calculate_anchor_score(cand->word) : count_unique_vowels_simple(cand->word);
-                if (sc > best_score) { best_score = sc; best_candidate = cand; best_ent = cand->entropy; }
-                else if (sc == best_score) { if (cand->entropy > best_ent) { best_candidate = cand; best_ent = cand->entropy; } }
+                if (sc > best_score) { best_score = sc; best_candidate = cand; best_ent = cand->entropy_score; }
+                else if (sc == best_score) { if (cand->entropy_score > best_ent) { best_candidate = cand; best_ent = cand->entropy_score; } }
             }
         }
         if (best_candidate != NULL) return best_candidate;
@@ -539,36 +580,55 @@ const dictionary_entry_t* get_smart_hybrid_guess(
     // (Look Ahead, Rank Bias) and revert to pure Greedy Entropy.
     // This is the safety net that ensures 100% win rates.
     bool is_endgame_panic = (valid_count <= 20);
-    int candidates_evaluated = 0;
-    int max_evals = (config->look_ahead_depth > 0 && !is_endgame_panic) ? PRUNE_COUNT : count;
 
-    for (int i = 0; i < count; i++)
+    // Apply Look Ahead bonus ONLY if not in panic mode
+    if (config->look_ahead_depth > 0 && !is_endgame_panic)
     {
-        if (candidates_evaluated >= max_evals) break;
-        const dictionary_entry_t* cand = p_entropy_sorted[i];
-        bool pass = true;
-
-        // Special Case: Endgame Solvers (Trying to guess the answer directly)
-        // If the word is a valid answer and the list is small, skip filters.
-        bool is_endgame_solver = (!cand->is_eliminated && valid_count <= 10);
+        // 1. Shortlist: the first PRUNE_COUNT candidates (Entropy order) that pass the filters
+        const dictionary_entry_t* shortlist[PRUNE_COUNT];
+        double scores[PRUNE_COUNT];
+        int shortlist_count = 0;
+        for (int i = 0; i < count && shortlist_count < PRUNE_COUNT; i++)
+        {
+            if (passes_main_loop_filters(p_entropy_sorted[i], config, min_required_counts, valid_count, turn, is_endgame_panic)) shortlist[shortlist_count++] = p_entropy_sorted[i];
+        }
 
-        if (!is_endgame_solver)
+        // 2. Look Ahead: each candidate is an independent read-only pass over the valid answers.
+        // Inside a tournament worker the nested region runs serially.
+        // With a deadline, rounds of one candidate per thread, best-first, until time runs out.
+        int evaluated = 0;
+        int round_size = shortlist_count;
+        if (deadline > 0.0) round_size = omp_in_parallel() ? 1 : omp_get_max_threads();
+        while (evaluated < shortlist_count)
         {
-            bool apply_ling = config->use_linguistic_filter && (turn >= config->linguistic_filter_start_turn);
-            // Disable Linguistic filter in panic mode to allow more flexibility in splitting
-            if (is_endgame_panic) apply_ling = false;
+            if (deadline > 0.0 && omp_get_wtime() >= deadline) { p_report->is_deadline_hit = true; break; }
+            int round_end = (evaluated + round_size < shortlist_count) ? evaluated + round_size : shortlist_count;
+#pragma omp parallel for schedule(static) if(round_end - evaluated > 1)
+            for (int k = evaluated; k < round_end; k++)
+            {
+                scores[k] = ENTROPY_SCORE_TO_BITS(shortlist[k]->entropy_score) + calculate_lookahead_bonus(shortlist[k], p_rank_sorted, valid_count, turn);
+            }
+            evaluated = round_end;
+        }
+        p_report->lookahead_total = shortlist_count;
+        p_report->lookahead_evaluated = evaluated;
 
-            if (apply_ling && !is_linguistically_sound(cand)) pass = false;
-            if (pass && config->use_risk_filter && is_risky_guess(cand, min_required_counts)) pass = false;
+        // 3. Reduce in shortlist order: the first of equal scores wins, whatever the thread count
+        for (int k = 0; k < evaluated; k++)
+        {
+            if (scores[k] > best_combined_score) { best_combined_score = scores[k]; best_final_candidate = shortlist[k]; }
         }
 
-        if (pass)
+        // Out of time before any Look Ahead: best-so-far is the top filtered Entropy pick
+        if (evaluated == 0 && shortlist_count > 0) best_final_candidate = shortlist[0];
+    }
+    else
+    {
+        for (int i = 0; i < count; i++)
         {
-            double current_score = cand->entropy;
-            // Apply Look Ahead bonus ONLY if not in panic mode
-            if (config->look_ahead_depth > 0 && !is_endgame_panic) { current_score += calculate_lookahead_bonus(cand, p_rank_sorted, valid_count, turn); }
-            if (current_score > best_combined_score) { best_combined_score = current_score; best_final_candidate = cand; }
-            candidates_evaluated++;
+            const dictionary_entry_t* cand = p_entropy_sorted[i];
+            if (!passes_main_loop_filters(cand, config, min_required_counts, valid_count, turn, is_endgame_panic)) continue;
+            if (ENTROPY_SCORE_TO_BITS(cand->entropy_score) > best_combined_score) { best_combined_score = ENTROPY_SCORE_TO_BITS(cand->entropy_score); best_final_candidate = cand; }
         }
     }
     if (best_final_candidate == NULL) best_final_candidate = p_entropy_sorted[0];
@@ -591,12 +651,61 @@ const dictionary_entry_t* get_smart_hybrid_guess(
             }
             if (pass) { best_rank_cand = cand; break; }
         }
-        double diff = best_final_candidate->entropy - best_rank_cand->entropy;
+        double diff = ENTROPY_SCORE_TO_BITS(best_final_candidate->entropy_score - best_rank_cand->entropy_score);
         if (diff < config->rank_priority_tolerance) { return best_rank_cand; }
     }
     return best_final_candidate;
 }
 
+/*
+ * FUNCTION: get_anytime_hybrid_guess
+ *
+ * WHAT:
+ * `select_smart_hybrid_guess` between the decision__start/end tracepoints
+ * (one exit for the probe, however the strategy decides), timed from
+ * `start_time` against the deadline.
+ */
+const dictionary_entry_t* get_anytime_hybrid_guess(
+    const dictionary_pointer_array_t p_entropy_sorted,
+    const dictionary_pointer_array_t p_rank_sorted,
+    int count,
+    const HybridConfig* config,
+    const int* min_required_counts,
+    int valid_count,
+    int turn,
+    double start_time,
+    double budget_ms,
+    decision_report_t* p_report)
+{
+    decision_report_t report;
+    memset(&report, 0, sizeof(report));
+    double start = (start_time > 0.0) ? start_time : omp_get_wtime();
+    double deadline = (budget_ms > 0.0) ? start + budget_ms / 1000.0 : 0.0;
+
+    TRACE_DECISION_START(turn, count, valid_count);
+    const dictionary_entry_t* p_guess = select_smart_hybrid_guess(p_entropy_sorted, p_rank_sorted, count, config, min_required_counts, valid_count, turn, deadline, &report);
+    TRACE_DECISION_END(turn, (p_guess != NULL) ? p_guess->word : "");
+
+    report.elapsed_ms = (omp_get_wtime() - start) * 1000.0;
+    if (p_report != NULL) *p_report = report;
+    return p_guess;
+}
+
+/*
+ * FUNCTION: get_smart_hybrid_guess
+ */
+const dictionary_entry_t* get_smart_hybrid_guess(
+    const dictionary_pointer_array_t p_entropy_sorted,
+    const dictionary_pointer_array_t p_rank_sorted,
+    int count,
+    const HybridConfig* config,
+    const int* min_required_counts,
+    int valid_count,
+    int turn)
+{
+    return get_anytime_hybrid_guess(p_entropy_sorted, p_rank_sorted, count, config, min_required_counts, valid_count, turn, 0.0, g_decision_budget_ms, NULL);
+}
+
 // --- Standard Filtering Helpers ---
 
 /*
@@ -669,6 +778,29 @@ bool get_best_guess_candidates(const dictionary_pointer_array_t p_entropy_sorted
     return true;
 }
 
+/*
+ * FUNCTION: recommend_top_n
+ *
+ * WHAT:
+ * Runs the fused partition kernel on the first `n` words of the Entropy View.
+ *
+ * WHY:
+ * The rows are independent, so they are spread across threads. When called
+ * from inside a tournament worker, the nested region runs serially.
+ */
+int recommend_top_n(const dictionary_pointer_array_t p_entropy_sorted, int count, dictionary_entry_t** ppValidAnswers, int valid_count, int n, partition_stats_t* p_stats)
+{
+    if (n > count) n = count;
+    if (n <= 0) return 0;
+
+#pragma omp parallel for schedule(static) if(n > 1)
+    for (int i = 0; i < n; i++)
+    {
+        calculate_partition_stats(p_entropy_sorted[i], ppValidAnswers, valid_count, &p_stats[i]);
+    }
+    return n;
+}
+
 /*
  * FUNCTION: filter_dictionary_by_constraints
  *
@@ -678,18 +810,28 @@ bool get_best_guess_candidates(const dictionary_pointer_array_t p_entropy_sorted
  * that conflicts with the feedback from the last guess.
  *
  * WHY:
- * This reduces the search space. It uses `get_feedback_pattern` to simulate
+ * This reduces the search space. It uses `get_feedback_index` to simulate
  * "If the answer was X, what pattern would I have gotten?". If that matches
  * the *actual* pattern we got, X is still a valid candidate.
  */
-void filter_dictionary_by_constraints(dictionary_entry_t* p_dictionary, int count, const char* guess, const char* result_pattern)
+void filter_dictionary_by_constraints(dictionary_entry_t* p_dictionary, int count, const char* guess, const char* result_pattern, game_state_t* p_state)
 {
-    char hypothetical_pattern[6];
+    // Encode the observed result once, so each word costs one integer compare
+    // instead of building and comparing a pattern string.
+    int observed_index = encode_feedback_pattern(result_pattern);
+    int eliminated = 0;
+    TRACE_FILTER_START(count);
     for (int i = 0; i < count; ++i)
     {
         dictionary_entry_t* pEntry = &p_dictionary[i];
         if (pEntry->is_eliminated) continue;
-        get_feedback_pattern(guess, pEntry->word, hypothetical_pattern);
-        if (strcmp(hypothetical_pattern, result_pattern) != 0) pEntry->is_eliminated = true;
+        if (get_feedback_index(guess, pEntry->word) != observed_index)
+        {
+            pEntry->is_eliminated = true;
+            eliminated++;
+            if (p_state != NULL) game_state_eliminate(p_state, pEntry);
+        }
     }
+    TRACE_FILTER_END(count, eliminated);
+    (void)eliminated; // Only read by the probe
 }
\ No newline at end of file
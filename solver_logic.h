@@ -20,6 +20,8 @@
 #include "wordle_types.h"
 #include "comparators.h"
 #include "hybrid_strategies.h" 
+#include "entropy_calculator.h"
+#include "game_state.h"
 
  /*
   * CONSTANT: Max Recommendations
@@ -62,6 +64,9 @@ void update_min_required_counts(const char* guess, const char* result_pattern, i
  * dictionary and applies the active Strategy Configuration (heuristics,
  * look-ahead, linguistic filters) to return the single best guess.
  *
+ * The decision runs within `g_decision_budget_ms` (see
+ * `get_anytime_hybrid_guess`).
+ *
  * WHY:
  * This consolidates all strategy logic into one entry point. Whether
  * we are doing a simple Entropy scan or a complex multi-turn simulation,
@@ -77,6 +82,63 @@ const dictionary_entry_t* get_smart_hybrid_guess(
     int turn
 );
 
+/*
+ * GLOBAL: g_decision_budget_ms
+ *
+ * WHAT:
+ * Time budget of one `get_smart_hybrid_guess` decision in milliseconds
+ * (`--decision-budget-ms=N`). 0 = unbounded.
+ */
+extern double g_decision_budget_ms;
+
+/*
+ * STRUCT: decision_report_t
+ *
+ * WHAT:
+ * How far one anytime decision got.
+ */
+typedef struct _decision_report
+{
+    double elapsed_ms;          /* Wall-clock time since `start_time` (end to end)  */
+    int lookahead_total;        /* Candidates shortlisted for Look Ahead (0 = none) */
+    int lookahead_evaluated;    /* Of those, scored before the deadline            */
+    bool is_deadline_hit;       /* true if the budget cut the decision short       */
+} decision_report_t;
+
+/*
+ * FUNCTION: get_anytime_hybrid_guess
+ *
+ * WHAT:
+ * `get_smart_hybrid_guess` with an explicit deadline `budget_ms` after
+ * `start_time` (`omp_get_wtime()` seconds, 0 = the call; `budget_ms` 0 =
+ * unbounded). The Look Ahead scores its shortlist best-first (Entropy order)
+ * in rounds of one candidate per thread, checking the clock between rounds;
+ * at the deadline it returns the best candidate scored so far, or the best
+ * by Entropy alone if none was. `p_report` (optional) receives how far it
+ * got.
+ *
+ * WHY:
+ * A service must answer within a fixed latency even when the strategy would
+ * like to look further. With time to spare the result is exactly the
+ * unbounded decision. Callers start the clock before the entropy pass that
+ * prepares the views and bound that pass with the same deadline
+ * (`calculate_entropy_for_candidates_until`), so the budget and
+ * `elapsed_ms` cover the whole decision; they set `is_deadline_hit` when
+ * that pass was cut short.
+ */
+const dictionary_entry_t* get_anytime_hybrid_guess(
+    const dictionary_pointer_array_t p_entropy_sorted,
+    const dictionary_pointer_array_t p_rank_sorted,
+    int count,
+    const HybridConfig* config,
+    const int* min_required_counts,
+    int valid_count,
+    int turn,
+    double start_time,
+    double budget_ms,
+    decision_report_t* p_report
+);
+
 /*
  * FUNCTION: get_best_guess_candidates
  *
@@ -98,6 +160,38 @@ bool get_best_guess_candidates(
     recommendations_array_t candidates
 );
 
+/*
+ * FUNCTION: recommend_top_n
+ *
+ * WHAT:
+ * Returns the top `n` guesses of an entropy-sorted view together with their
+ * full partition statistics (expected remaining, worst case, win chance and
+ * bucket histogram), computed against the current valid answers.
+ *
+ * PARAMETERS:
+ * - p_entropy_sorted / count: The Entropy View (already sorted this turn).
+ * - ppValidAnswers / valid_count: The answers still possible.
+ * - n: How many guesses to describe.
+ * - p_stats: Output array with room for `n` entries.
+ *
+ * RETURNS:
+ * - The number of entries written (min(n, count)).
+ *
+ * WHY:
+ * `get_best_guess_candidates` only returns four fixed categories. Clients
+ * that list alternatives need the statistics behind each one, but only for
+ * the few rows they show. Computing them lazily for the top N costs
+ * N x valid_count feedback computations, small enough to serve per keystroke.
+ */
+int recommend_top_n(
+    const dictionary_pointer_array_t p_entropy_sorted,
+    int count,
+    dictionary_entry_t** ppValidAnswers,
+    int valid_count,
+    int n,
+    partition_stats_t* p_stats
+);
+
 /*
  * FUNCTION: filter_dictionary_by_constraints
  *
@@ -105,6 +199,9 @@ bool get_best_guess_candidates(
  * Scans the dictionary and marks entries as "eliminated" (is_eliminated = true)
  * if they conflict with the latest feedback (guess + pattern).
  *
+ * If `p_state` is not NULL, every word eliminated here is also removed from
+ * its candidate hash and count.
+ *
  * WHY:
  * This is the mechanism that narrows the search space. After every turn,
  * impossible words are flagged so they are ignored in future entropy calculations.
@@ -113,7 +210,8 @@ void filter_dictionary_by_constraints(
     dictionary_entry_t* p_dictionary,
     int count,
     const char* guess,
-    const char* result_pattern
+    const char* result_pattern,
+    game_state_t* p_state
 );
 
 #endif
\ No newline at end of file
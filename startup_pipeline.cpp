@@ -0,0 +1,181 @@
+/*
+ * FILE: startup_pipeline.cpp
+ *
+ * WHAT:
+ * Implements the staged startup pipeline (Fetch and Compute workers, then an
+ * incremental join on the main thread).
+ *
+ * ARCHITECTURE:
+ * 1. Fetch Worker (std::thread): `load_used_words` (blocking HTTP + parse).
+ * 2. Compute Worker (std::thread): `read_dictionary_file`, then
+ * `init_mutable_dictionary`, whose partition table build is itself an
+ * OpenMP parallel loop.
+ * 3. Join (main thread): `mutable_dictionary_remove_words` with the used list.
+ *
+ * WHY:
+ * OpenMP parallelizes loops, but it cannot keep a job running while the main
+ * thread returns to the prompts; plain threads can. The two workers share
+ * no data until the join, so no locking is needed: each writes only its own
+ * results, and the main thread reads them after `join`. Both workers are
+ * always joined (an unneeded download is cancelled first), so neither
+ * outlives the pipeline.
+ */
+
+#include "startup_pipeline.h"
+#include "load_dictionary.h"
+#include "load_used_words.h"
+#include "dictionary_mutation.h"
+#include "alloc_tracker.h"
+#include "thread_placement.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <omp.h>
+#include <thread>
+
+/*
+ * STATICS: Pipeline State
+ *
+ * WHAT:
+ * Results written by the workers, read by the main thread after `join`.
+ * The Fetch worker fills its own buffer; it only becomes
+ * `g_p_used_words` once joined.
+ */
+static std::thread s_fetch_worker;
+static std::thread s_compute_worker;
+
+static bool s_is_fetch_ok = false;
+static double s_fetch_seconds = 0.0;
+static char* s_p_fetched_words = NULL;
+static int s_fetched_word_count = 0;
+
+static bool s_is_compute_ok = false;
+static double s_compute_seconds = 0.0;
+static mutable_dictionary_t s_dictionary;
+
+/*
+ * HELPER: fetch_worker
+ */
+static void fetch_worker()
+{
+    double start = omp_get_wtime();
+    s_is_fetch_ok = load_used_words(&s_p_fetched_words, &s_fetched_word_count);
+    s_fetch_seconds = omp_get_wtime() - start;
+}
+
+/*
+ * HELPER: compute_worker
+ *
+ * WHAT:
+ * Parse, then build the partition table and opener entropy for the whole
+ * file. The parsed array is only needed until the mutable copy exists.
+ */
+static void compute_worker()
+{
+    double start = omp_get_wtime();
+    dictionary_entry_t* p_parsed = NULL;
+    int parsed_count = 0;
+
+    // This thread leads its own OpenMP team for the partition table build
+    if (g_placement_policy != PLACEMENT_DEFAULT) apply_thread_placement(g_placement_policy);
+
+    s_is_compute_ok = false;
+    if (read_dictionary_file(&p_parsed, &parsed_count))
+    {
+        s_is_compute_ok = init_mutable_dictionary(&s_dictionary, p_parsed, parsed_count);
+        tracked_free(p_parsed);
+    }
+    s_compute_seconds = omp_get_wtime() - start;
+}
+
+/*
+ * FUNCTION: start_startup_pipeline
+ */
+void start_startup_pipeline()
+{
+    s_fetch_worker = std::thread(fetch_worker);
+    s_compute_worker = std::thread(compute_worker);
+}
+
+/*
+ * FUNCTION: finish_startup_pipeline
+ *
+ * WHAT:
+ * 1. Join Fetch, cancelling the download first if nothing needs it.
+ * 2. Apply exclusions incrementally once Compute has joined.
+ * 3. Copy the entries into a plain array for the rest of the program.
+ *
+ * WHY:
+ * Fetch is joined first so its messages come out in the same order as the
+ * sequential loader's.
+ */
+bool finish_startup_pipeline(bool should_filter_history, bool need_used_words, dictionary_entry_t** pp_dictionary, int* p_dictionary_count)
+{
+    double join_start = omp_get_wtime();
+
+    // 1. Fetch
+    bool is_fetch_needed = should_filter_history || need_used_words;
+    if (!is_fetch_needed)
+    {
+        // Not needed: do not make the user wait on the network.
+        set_used_words_download_cancelled(true);
+    }
+    s_fetch_worker.join();
+    set_used_words_download_cancelled(false);
+    if (is_fetch_needed && s_is_fetch_ok)
+    {
+        g_p_used_words = s_p_fetched_words;
+        g_used_word_count = s_fetched_word_count;
+    }
+    else
+    {
+        tracked_free(s_p_fetched_words);
+        if (!s_is_fetch_ok && should_filter_history)
+        {
+            printf("Warning: Failed to load used words. Continuing with full dictionary.\n");
+            should_filter_history = false;
+        }
+    }
+    s_p_fetched_words = NULL;
+    s_fetched_word_count = 0;
+
+    s_compute_worker.join();
+    if (!s_is_compute_ok) return false;
+
+    // 2. Exclusions (O(N x removed) on the already computed table)
+    int total_loaded_words = s_dictionary.count;
+    double exclusion_start = omp_get_wtime();
+    if (should_filter_history)
+    {
+        int removed = mutable_dictionary_remove_words(&s_dictionary, g_p_used_words, g_used_word_count);
+        printf("Loaded %d words from the new consolidated dictionary.\n", s_dictionary.count);
+        printf("Filtered out %d used words from %d loaded.  Did not find %d used words.\n", removed, total_loaded_words, g_used_word_count - removed);
+    }
+    else
+    {
+        printf("Loaded %d words from the new consolidated dictionary.\n", total_loaded_words);
+        printf("History Filter DISABLED. All %d words are active.\n", total_loaded_words);
+    }
+    double exclusion_seconds = omp_get_wtime() - exclusion_start;
+
+    // 3. Hand over a plain array (the partition table is no longer needed),
+    // with entropy bit-identical to the sequential loader's.
+    printf("Calculating entropy for each word in the dictionary...");
+    partition_table_apply_exact_entropy(&s_dictionary.table, s_dictionary.p_entries);
+    printf(" Done.\n");
+    *p_dictionary_count = s_dictionary.count;
+    *pp_dictionary = (dictionary_entry_t*)tracked_malloc(sizeof(dictionary_entry_t) * (s_dictionary.count > 0 ? s_dictionary.count : 1));
+    if (*pp_dictionary != NULL) memcpy(*pp_dictionary, s_dictionary.p_entries, sizeof(dictionary_entry_t) * s_dictionary.count);
+    free_mutable_dictionary(&s_dictionary);
+    if (*pp_dictionary == NULL) return false;
+
+    char fetch_str[32];
+    if (!is_fetch_needed) sprintf_s(fetch_str, 32, "not needed");
+    else if (!s_is_fetch_ok) sprintf_s(fetch_str, 32, "failed");
+    else sprintf_s(fetch_str, 32, "%.2fs", s_fetch_seconds);
+
+    printf("Startup pipeline: compute %.2fs, fetch %s, exclusions %.2fs, waited %.2fs after setup.\n",
+        s_compute_seconds, fetch_str, exclusion_seconds, omp_get_wtime() - join_start);
+    fflush(stdout);
+    return true;
+}
@@ -0,0 +1,63 @@
+/*
+ * FILE: startup_pipeline.h
+ *
+ * WHAT:
+ * Defines the interface for the staged startup pipeline. Instead of running
+ * prompts -> download -> parse -> O(N^2) entropy strictly in sequence, two
+ * background workers start as soon as the program launches:
+ * - Fetch Worker: Downloads and parses the "Used Words" list.
+ * - Compute Worker: Parses `AllWords.txt` and builds the partition table
+ * (the O(N^2) opener entropy pass) for the FULL dictionary.
+ * Meanwhile the main thread asks the setup questions. When the answers are
+ * in, the used words (if wanted) are removed incrementally from the
+ * already-computed data through the mutation API.
+ *
+ * WHY:
+ * Time-to-first-recommendation drops from (prompts + fetch + compute) to
+ * roughly max(prompts, fetch, compute). The exclusions cost O(N x removed)
+ * instead of a second O(N^2) pass, because the partition table keeps every
+ * per-guess histogram.
+ */
+
+#pragma once
+#ifndef STARTUP_PIPELINE_H
+#define STARTUP_PIPELINE_H
+#include "wordle_types.h"
+
+/*
+ * FUNCTION: start_startup_pipeline
+ *
+ * WHAT:
+ * Launches the Fetch and Compute workers and returns immediately.
+ *
+ * WHY:
+ * Call this first thing in `main`, before any prompt, so the heavy work
+ * overlaps the time the user spends answering.
+ */
+void start_startup_pipeline();
+
+/*
+ * FUNCTION: finish_startup_pipeline
+ *
+ * WHAT:
+ * 1. Waits for the Compute worker.
+ * 2. Joins the Fetch worker. If the used words are not needed (no history
+ * filter, no replay without a history file), the download is cancelled
+ * first so the join is immediate and its results are dropped.
+ * 3. If filtering, removes the used words incrementally and refreshes entropy.
+ * 4. Hands the result over as a plain dictionary array.
+ *
+ * PARAMETERS:
+ * - should_filter_history: Remove the used words from the dictionary.
+ * - need_used_words: Wait for the download even when not filtering
+ * (e.g., the Historical Replay needs the list itself unless a history file
+ * was given).
+ * - pp_dictionary / p_dictionary_count: Output, same contract as `load_dictionary`
+ * (entropy already calculated, caller frees).
+ *
+ * RETURNS:
+ * - false if the dictionary could not be loaded.
+ */
+bool finish_startup_pipeline(bool should_filter_history, bool need_used_words, dictionary_entry_t** pp_dictionary, int* p_dictionary_count);
+
+#endif
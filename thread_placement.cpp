@@ -0,0 +1,288 @@
+/*
+ * FILE: thread_placement.cpp
+ *
+ * WHAT:
+ * Implements Thread Placement: the sysfs topology reader, the placement
+ * plans and the pinning of a team, on Linux; a stand-in that keeps the
+ * default placement everywhere else.
+ */
+
+#include "thread_placement.h"
+#include "wordle_types.h"
+#include "alloc_tracker.h"
+#include <omp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <mutex>
+#ifdef __linux__
+#include <errno.h>
+#include <sched.h>
+#endif
+
+static const char* POLICY_NAMES[PLACEMENT_POLICY_COUNT] = { "default", "compact", "spread", "cores" };
+
+/*
+ * STRUCT: placement_cpu_t
+ *
+ * FIELDS:
+ * - cpu: Logical CPU number.
+ * - package / core_id: The physical core it belongs to (core ids are only
+ * unique within a package).
+ * - sibling: 0 for the core's lowest-numbered logical CPU, 1 for the next...
+ * - core_rank: The core's position among its package's cores.
+ */
+typedef struct _placement_cpu
+{
+    int cpu;
+    int package;
+    int core_id;
+    int sibling;
+    int core_rank;
+} placement_cpu_t;
+
+/*
+ * STATIC: Topology
+ *
+ * WHAT:
+ * The allowed CPUs, read once (before any pinning narrows the mask), and
+ * the OpenMP team size the process started with.
+ */
+static placement_cpu_t s_cpus[PLACEMENT_MAX_CPUS];
+static int s_cpu_count = 0;
+static int s_core_count = 0;
+static int s_package_count = 0;
+static int s_default_team_size = 1;
+static std::once_flag s_topology_once;
+
+/*
+ * FUNCTION: parse_placement_policy
+ */
+bool parse_placement_policy(const char* name, int* p_policy)
+{
+    for (int p = 0; p < PLACEMENT_POLICY_COUNT; p++)
+    {
+        if (strcmp(name, POLICY_NAMES[p]) == 0) { *p_policy = p; return true; }
+    }
+    return false;
+}
+
+/*
+ * FUNCTION: placement_policy_name
+ */
+const char* placement_policy_name(int policy)
+{
+    return (policy >= 0 && policy < PLACEMENT_POLICY_COUNT) ? POLICY_NAMES[policy] : "unknown";
+}
+
+/*
+ * HELPER: compare_compact / compare_spread
+ *
+ * WHAT:
+ * Compact: core by core, siblings together. Spread: sibling level by
+ * sibling level, alternating packages within a level.
+ */
+static int compare_compact(const void* a, const void* b)
+{
+    const placement_cpu_t* x = (const placement_cpu_t*)a;
+    const placement_cpu_t* y = (const placement_cpu_t*)b;
+    if (x->package != y->package) return (x->package < y->package) ? -1 : 1;
+    if (x->core_rank != y->core_rank) return (x->core_rank < y->core_rank) ? -1 : 1;
+    return (x->sibling < y->sibling) ? -1 : (x->sibling > y->sibling);
+}
+
+static int compare_spread(const void* a, const void* b)
+{
+    const placement_cpu_t* x = (const placement_cpu_t*)a;
+    const placement_cpu_t* y = (const placement_cpu_t*)b;
+    if (x->sibling != y->sibling) return (x->sibling < y->sibling) ? -1 : 1;
+    if (x->core_rank != y->core_rank) return (x->core_rank < y->core_rank) ? -1 : 1;
+    return (x->package < y->package) ? -1 : (x->package > y->package);
+}
+
+/*
+ * HELPER: build_placement_plan
+ *
+ * WHAT:
+ * Writes the CPUs for `policy` in worker order into `p_plan`.
+ *
+ * RETURNS:
+ * - The number of workers, or 0 for the default placement (no plan).
+ */
+static int build_placement_plan(int policy, int* p_plan)
+{
+    if (policy == PLACEMENT_DEFAULT || s_cpu_count == 0) return 0;
+
+    placement_cpu_t* p_order = (placement_cpu_t*)tracked_malloc(sizeof(placement_cpu_t) * s_cpu_count);
+    if (p_order == NULL) return 0;
+    memcpy(p_order, s_cpus, sizeof(placement_cpu_t) * s_cpu_count);
+    qsort(p_order, s_cpu_count, sizeof(placement_cpu_t), (policy == PLACEMENT_COMPACT) ? compare_compact : compare_spread);
+
+    int worker_count = 0;
+    for (int i = 0; i < s_cpu_count; i++)
+    {
+        if (policy == PLACEMENT_CORES && p_order[i].sibling != 0) continue;
+        p_plan[worker_count++] = p_order[i].cpu;
+    }
+    tracked_free(p_order);
+    return worker_count;
+}
+
+#ifdef __linux__
+
+static cpu_set_t s_allowed_mask;
+
+/*
+ * HELPER: read_topology_value
+ *
+ * WHAT:
+ * An integer from /sys/devices/system/cpu/cpuN/topology/<name>, or
+ * `fallback` if the file is missing (some containers hide sysfs).
+ */
+static int read_topology_value(int cpu, const char* name, int fallback)
+{
+    char path[96];
+    char line[32];
+    FILE* fp = NULL;
+    sprintf_s(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/%s", cpu, name);
+    if (fopen_s(&fp, path, "r") != 0 || fp == NULL) return fallback;
+
+    int value = fallback;
+    if (fgets(line, sizeof(line), fp) != NULL)
+    {
+        char* p_end = NULL;
+        long parsed = strtol(line, &p_end, 10);
+        if (p_end != line) value = (int)parsed;
+    }
+    fclose(fp);
+    return value;
+}
+
+/*
+ * HELPER: read_topology
+ *
+ * WHAT:
+ * The allowed CPUs with their package and core, then each CPU's sibling
+ * index and each core's rank in its package. Without sysfs every CPU
+ * counts as its own core.
+ */
+static void read_topology()
+{
+    s_default_team_size = omp_get_max_threads();
+    CPU_ZERO(&s_allowed_mask);
+    if (sched_getaffinity(0, sizeof(s_allowed_mask), &s_allowed_mask) != 0) return;
+
+    for (int cpu = 0; cpu < CPU_SETSIZE && s_cpu_count < PLACEMENT_MAX_CPUS; cpu++)
+    {
+        if (!CPU_ISSET(cpu, &s_allowed_mask)) continue;
+        placement_cpu_t* p_cpu = &s_cpus[s_cpu_count++];
+        p_cpu->cpu = cpu;
+        p_cpu->package = read_topology_value(cpu, "physical_package_id", 0);
+        p_cpu->core_id = read_topology_value(cpu, "core_id", cpu);
+    }
+
+    // CPUs are in ascending order, so earlier CPUs of the same core are the lower siblings
+    for (int i = 0; i < s_cpu_count; i++)
+    {
+        s_cpus[i].sibling = 0;
+        for (int j = 0; j < i; j++)
+        {
+            if (s_cpus[j].package == s_cpus[i].package && s_cpus[j].core_id == s_cpus[i].core_id) s_cpus[i].sibling++;
+        }
+        if (s_cpus[i].sibling == 0) s_core_count++;
+    }
+    for (int i = 0; i < s_cpu_count; i++)
+    {
+        s_cpus[i].core_rank = 0;
+        for (int j = 0; j < s_cpu_count; j++)
+        {
+            if (s_cpus[j].sibling == 0 && s_cpus[j].package == s_cpus[i].package && s_cpus[j].core_id < s_cpus[i].core_id) s_cpus[i].core_rank++;
+        }
+        if (s_cpus[i].sibling == 0 && s_cpus[i].core_rank == 0) s_package_count++;
+    }
+}
+
+/*
+ * FUNCTION: apply_thread_placement
+ *
+ * HOW:
+ * One parallel region of the new team size in which every worker sets its
+ * own mask (`sched_setaffinity(0, ...)` acts on the calling thread). The
+ * runtime keeps those threads for the team's later regions.
+ */
+int apply_thread_placement(int policy)
+{
+    std::call_once(s_topology_once, read_topology);
+
+    int* p_plan = (int*)tracked_malloc(sizeof(int) * (s_cpu_count > 0 ? s_cpu_count : 1));
+    int worker_count = (p_plan != NULL) ? build_placement_plan(policy, p_plan) : 0;
+    int team_size = (worker_count > 0) ? worker_count : s_default_team_size;
+    int failures = 0;
+    int first_error = 0;
+
+    omp_set_num_threads(team_size);
+#pragma omp parallel num_threads(team_size) reduction(+:failures)
+    {
+        cpu_set_t mask = s_allowed_mask;
+        if (worker_count > 0)
+        {
+            CPU_ZERO(&mask);
+            CPU_SET(p_plan[omp_get_thread_num() % worker_count], &mask);
+        }
+        if (sched_setaffinity(0, sizeof(mask), &mask) != 0)
+        {
+            failures++;
+#pragma omp critical
+            first_error = errno;
+        }
+    }
+    if (failures > 0) printf("Warning: Could not pin %d of %d workers (%s).\n", failures, team_size, strerror(first_error));
+
+    tracked_free(p_plan);
+    return team_size;
+}
+
+#else
+
+static void read_topology()
+{
+    s_default_team_size = omp_get_max_threads();
+}
+
+int apply_thread_placement(int policy)
+{
+    (void)policy;
+    std::call_once(s_topology_once, read_topology);
+    omp_set_num_threads(s_default_team_size);
+    return s_default_team_size;
+}
+
+#endif
+
+/*
+ * FUNCTION: print_thread_placement
+ */
+void print_thread_placement(int policy)
+{
+    const int MAX_LISTED_CPUS = 32;
+    std::call_once(s_topology_once, read_topology);
+
+    if (s_cpu_count == 0)
+    {
+        printf("Thread placement: default, %d workers (CPU topology is only read on Linux).\n", s_default_team_size);
+        return;
+    }
+
+    int* p_plan = (int*)tracked_malloc(sizeof(int) * s_cpu_count);
+    int worker_count = (p_plan != NULL) ? build_placement_plan(policy, p_plan) : 0;
+    printf("Thread placement: %s, ", placement_policy_name(policy));
+    if (worker_count == 0) printf("%d workers, not pinned", s_default_team_size);
+    else
+    {
+        printf("%d workers on CPUs ", worker_count);
+        for (int w = 0; w < worker_count && w < MAX_LISTED_CPUS; w++) printf((w == 0) ? "%d" : ",%d", p_plan[w]);
+        if (worker_count > MAX_LISTED_CPUS) printf(",...");
+    }
+    printf(" (%d package%s, %d cores, %d logical CPUs).\n", s_package_count, (s_package_count == 1) ? "" : "s", s_core_count, s_cpu_count);
+    tracked_free(p_plan);
+}
@@ -0,0 +1,107 @@
+/*
+ * FILE: thread_placement.h
+ *
+ * WHAT:
+ * Defines Thread Placement: which logical CPUs the OpenMP workers run on.
+ * The machine's topology (packages, physical cores, SMT siblings) is read
+ * once, a placement policy turns it into an ordered list of CPUs, and each
+ * worker of a team is pinned to its entry in that list.
+ *
+ * WHY:
+ * Left alone, the OpenMP runtime and the scheduler are free to put two
+ * heavy entropy workers on sibling hyperthreads of one core while other
+ * physical cores sit idle. Siblings share the core's execution units and
+ * L1/L2, so the pair runs little faster than one worker. Choosing the
+ * placement, and benchmarking the choices (`--placement-benchmark`), shows
+ * what SMT is worth for these kernels on a given machine.
+ *
+ * HOW:
+ * Linux only: the topology comes from /sys/devices/system/cpu/cpuN/topology
+ * for the CPUs in the process's affinity mask, and workers are pinned with
+ * `sched_setaffinity`. Pinning is per thread and the OpenMP pool threads
+ * persist, so pinning once per team is enough. Elsewhere every policy falls
+ * back to the default placement.
+ *
+ * TEAMS:
+ * Each thread that starts OpenMP work has its own worker team: the main
+ * thread, and the startup pipeline's Compute worker. Both call
+ * `apply_thread_placement` before their first parallel region.
+ */
+
+#pragma once
+#ifndef THREAD_PLACEMENT_H
+#define THREAD_PLACEMENT_H
+
+/*
+ * CONSTANTS: Placement Policies
+ *
+ * WHAT:
+ * - DEFAULT: No pinning; one worker per allowed CPU (the OpenMP default).
+ * - COMPACT: One worker per logical CPU, filling each core's siblings
+ * before moving to the next core.
+ * - SPREAD: One worker per logical CPU, first one per physical core (across
+ * packages), then the second siblings, and so on.
+ * - CORES: One worker per physical core, on its first sibling; the other
+ * siblings stay idle.
+ */
+#define PLACEMENT_DEFAULT 0
+#define PLACEMENT_COMPACT 1
+#define PLACEMENT_SPREAD 2
+#define PLACEMENT_CORES 3
+#define PLACEMENT_POLICY_COUNT 4
+
+/*
+ * CONSTANT: PLACEMENT_MAX_CPUS
+ *
+ * WHAT:
+ * Logical CPUs considered; any beyond are left to the default placement.
+ */
+#define PLACEMENT_MAX_CPUS 1024
+
+/*
+ * GLOBAL: g_placement_policy
+ *
+ * WHAT:
+ * The policy chosen with `--placement=` (PLACEMENT_*).
+ */
+extern int g_placement_policy;
+
+/*
+ * FUNCTION: parse_placement_policy
+ *
+ * WHAT:
+ * "default", "compact", "spread" or "cores" into `*p_policy`.
+ *
+ * RETURNS:
+ * - false for any other name.
+ */
+bool parse_placement_policy(const char* name, int* p_policy);
+
+/*
+ * FUNCTION: placement_policy_name
+ */
+const char* placement_policy_name(int policy);
+
+/*
+ * FUNCTION: apply_thread_placement
+ *
+ * WHAT:
+ * Sets the calling thread's OpenMP team size for `policy` and pins every
+ * worker of that team, the caller included, to its CPU. DEFAULT undoes an
+ * earlier pinning (every worker may run on any allowed CPU again).
+ *
+ * RETURNS:
+ * - The team size now in effect.
+ */
+int apply_thread_placement(int policy);
+
+/*
+ * FUNCTION: print_thread_placement
+ *
+ * WHAT:
+ * One line: the topology found (packages, physical cores, logical CPUs)
+ * and, for `policy`, the workers and the CPUs they are pinned to in order.
+ */
+void print_thread_placement(int policy);
+
+#endif
@@ -0,0 +1,105 @@
+/*
+ * FILE: trace_probes.h
+ *
+ * WHAT:
+ * Static tracepoints (USDT probes, provider "wordle") on the engine's hot
+ * paths. Each macro marks one event; attach to them with bpftrace or perf
+ * on an unmodified binary (see the .bt files in scripts):
+ *
+ *   PROBE             ARGUMENTS                               WHERE
+ *   game__start       target word, strategy name              monte_carlo.cpp
+ *   game__end         target word, guesses, won (0/1)         monte_carlo.cpp
+ *   turn__decision    turn, valid answers, next guess, source monte_carlo.cpp
+ *   decision__start   turn, candidates, valid answers         solver_logic.cpp
+ *   decision__end     turn, chosen guess                      solver_logic.cpp
+ *   entropy__start    pass, guesses, answers, cached (0/1)    entropy_calculator.cpp
+ *   entropy__end      pass, guesses, answers                  entropy_calculator.cpp
+ *   filter__start     words scanned                           solver_logic.cpp
+ *   filter__end       words scanned, words eliminated         solver_logic.cpp
+ *   sort__start       sort, words                             monte_carlo.cpp
+ *   sort__end         sort, words                             monte_carlo.cpp
+ *   cache__lookup     cache, hit (0/1)                        monte_carlo.cpp, entropy_calculator.cpp
+ *
+ * Words and names are NUL-terminated strings (`str(argN)` in bpftrace).
+ * The numeric codes are the TRACE_* constants below.
+ *
+ * WHY:
+ * Slow runs on production machines have to be diagnosed where they happen,
+ * without a rebuild or a restart. A USDT probe is a single NOP in the code
+ * plus a note in the ELF file; the arguments are only read when a tracer is
+ * attached, so the probes stay in release builds.
+ *
+ * HOW:
+ * With `sys/sdt.h` (SystemTap SDT headers, package `systemtap-sdt-dev`) the
+ * CMake build defines WORDLE_USDT and the macros expand to DTRACE_PROBEn.
+ * Without it (and in the Visual Studio build) they expand to nothing and
+ * their arguments are not evaluated.
+ */
+
+#pragma once
+#ifndef TRACE_PROBES_H
+#define TRACE_PROBES_H
+
+/*
+ * CONSTANTS: Probe Codes
+ *
+ * WHAT:
+ * - TRACE_ENTROPY_*: The `pass` of entropy__start/end: every valid word
+ * against the valid set (opener, Hard Mode) or every candidate against the
+ * valid set (Normal Mode).
+ * - TRACE_SORT_*: The `sort` of sort__start/end: the entropy and rank views,
+ * and the Hard Mode compaction of the working dictionary.
+ * - TRACE_CACHE_*: The `cache` of cache__lookup.
+ * - TRACE_DECISION_*: The `source` of turn__decision: where the next guess
+ * came from (COALESCED: another thread's decision, see single_flight.h).
+ */
+#define TRACE_ENTROPY_DICTIONARY 0
+#define TRACE_ENTROPY_CANDIDATES 1
+
+#define TRACE_SORT_ENTROPY_VIEW 0
+#define TRACE_SORT_RANK_VIEW 1
+#define TRACE_SORT_COMPACTION 2
+
+#define TRACE_CACHE_PATTERN_ROW 0
+#define TRACE_CACHE_TURN2_MEMO 1
+#define TRACE_CACHE_SHARED_STATE 2
+
+#define TRACE_DECISION_COMPUTED 0
+#define TRACE_DECISION_TURN2_MEMO 1
+#define TRACE_DECISION_SHARED_STATE 2
+#define TRACE_DECISION_COALESCED 3
+
+#ifdef WORDLE_USDT
+#include <sys/sdt.h>
+
+#define TRACE_GAME_START(word, strategy)                DTRACE_PROBE2(wordle, game__start, word, strategy)
+#define TRACE_GAME_END(word, guesses, won)              DTRACE_PROBE3(wordle, game__end, word, guesses, won)
+#define TRACE_TURN_DECISION(turn, valid, guess, source) DTRACE_PROBE4(wordle, turn__decision, turn, valid, guess, source)
+#define TRACE_DECISION_START(turn, count, valid)        DTRACE_PROBE3(wordle, decision__start, turn, count, valid)
+#define TRACE_DECISION_END(turn, guess)                 DTRACE_PROBE2(wordle, decision__end, turn, guess)
+#define TRACE_ENTROPY_START(pass, guesses, answers, cached) DTRACE_PROBE4(wordle, entropy__start, pass, guesses, answers, cached)
+#define TRACE_ENTROPY_END(pass, guesses, answers)       DTRACE_PROBE3(wordle, entropy__end, pass, guesses, answers)
+#define TRACE_FILTER_START(count)                       DTRACE_PROBE1(wordle, filter__start, count)
+#define TRACE_FILTER_END(count, eliminated)             DTRACE_PROBE2(wordle, filter__end, count, eliminated)
+#define TRACE_SORT_START(sort, count)                   DTRACE_PROBE2(wordle, sort__start, sort, count)
+#define TRACE_SORT_END(sort, count)                     DTRACE_PROBE2(wordle, sort__end, sort, count)
+#define TRACE_CACHE_LOOKUP(cache, hit)                  DTRACE_PROBE2(wordle, cache__lookup, cache, hit)
+
+#else
+
+#define TRACE_GAME_START(word, strategy)                ((void)0)
+#define TRACE_GAME_END(word, guesses, won)              ((void)0)
+#define TRACE_TURN_DECISION(turn, valid, guess, source) ((void)0)
+#define TRACE_DECISION_START(turn, count, valid)        ((void)0)
+#define TRACE_DECISION_END(turn, guess)                 ((void)0)
+#define TRACE_ENTROPY_START(pass, guesses, answers, cached) ((void)0)
+#define TRACE_ENTROPY_END(pass, guesses, answers)       ((void)0)
+#define TRACE_FILTER_START(count)                       ((void)0)
+#define TRACE_FILTER_END(count, eliminated)             ((void)0)
+#define TRACE_SORT_START(sort, count)                   ((void)0)
+#define TRACE_SORT_END(sort, count)                     ((void)0)
+#define TRACE_CACHE_LOOKUP(cache, hit)                  ((void)0)
+
+#endif
+
+#endif
@@ -0,0 +1,915 @@
+/*
+ * FILE: verification.cpp
+ *
+ * WHAT:
+ * Implements the Differential Verifier.
+ *
+ * HOW:
+ * The references are kept as plain as possible: every pattern comes from
+ * the string function `get_feedback_pattern` and is encoded here, so a bug
+ * in the integer encoding cannot hide on both sides of a comparison.
+ * Checks that need the quadratic reference (entropy, partition table) run
+ * on a random sample of the dictionary; everything else uses all of it.
+ */
+
+#include "verification.h"
+#include "entropy_calculator.h"
+#include "solver_logic.h"
+#include "partition_table.h"
+#include "pattern_cache.h"
+#include "game_state.h"
+#include "comparators.h"
+#include "duplicate_dictionary.h"
+#include "monte_carlo.h"
+#include "hybrid_strategies.h"
+#include "auto_tuner.h"
+#include "alloc_tracker.h"
+#include "shared_state_cache.h"
+#include "single_flight.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <omp.h>
+
+extern bool g_isHardMode;
+
+/*
+ * CONSTANTS: Sample Sizes
+ */
+#define VERIFY_RANDOM_PAIRS 200000
+#define VERIFY_ROW_GUESSES 64
+#define VERIFY_ENTROPY_SAMPLE 800
+#define VERIFY_FILTER_TRIALS 300
+#define VERIFY_GAMES_PER_STRATEGY 12
+#define VERIFY_ALLOCATION_TRIALS 16
+
+/*
+ * CONSTANT: VERIFY_SHARED_CACHE_FILE
+ *
+ * WHAT:
+ * Scratch shared cache for the budget check (created and deleted in the
+ * working directory).
+ */
+#define VERIFY_SHARED_CACHE_FILE "WordleChampion.verify.cache"
+
+/*
+ * STRUCT: check_result_t
+ *
+ * WHAT:
+ * One check's tally and the first mismatch, described in words.
+ */
+typedef struct _check_result
+{
+    const char* name;
+    long long comparisons;
+    long long mismatches;
+    char first_mismatch[160];
+} check_result_t;
+
+/*
+ * HELPER: next_random
+ *
+ * WHAT:
+ * SplitMix64 step (same mixer as the Zobrist keys).
+ */
+static unsigned long long next_random(unsigned long long* p_state)
+{
+    unsigned long long x = (*p_state += 0x9E3779B97F4A7C15ULL);
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+/*
+ * HELPER: begin_check / count_comparison / finish_check
+ *
+ * WHAT:
+ * `count_comparison` returns true for the first mismatch, so the caller
+ * formats the description only once.
+ */
+static void begin_check(check_result_t* p_check, const char* name)
+{
+    memset(p_check, 0, sizeof(check_result_t));
+    p_check->name = name;
+}
+
+static bool count_comparison(check_result_t* p_check, bool is_equal)
+{
+    p_check->comparisons++;
+    if (is_equal) return false;
+    return (p_check->mismatches++ == 0);
+}
+
+static bool finish_check(const check_result_t* p_check)
+{
+    if (p_check->mismatches == 0)
+    {
+        printf("  [PASS] %-34s %12lld comparisons\n", p_check->name, p_check->comparisons);
+        return true;
+    }
+    printf("  [FAIL] %-34s %lld of %lld differ. First: %s\n", p_check->name, p_check->mismatches, p_check->comparisons, p_check->first_mismatch);
+    return false;
+}
+
+/*
+ * HELPER: reference_code
+ *
+ * WHAT:
+ * Pattern code of `guess` against `answer` via the string reference
+ * (B=0, Y=1, G=2, position 0 is the least significant digit).
+ */
+static int reference_code(const char* guess, const char* answer)
+{
+    char pattern[WORDLE_WORD_LENGTH + 1];
+    get_feedback_pattern(guess, answer, pattern);
+    int code = 0;
+    for (int i = WORDLE_WORD_LENGTH - 1; i >= 0; i--)
+    {
+        code = code * 3 + ((pattern[i] == 'G') ? 2 : (pattern[i] == 'Y') ? 1 : 0);
+    }
+    return code;
+}
+
+/*
+ * HELPER: reference_entropy
+ *
+ * WHAT:
+ * Histogram from reference codes, entropy from the shared formula (the
+ * formula itself is checked separately against the textbook one).
+ */
+static long long reference_entropy(const char* guess, dictionary_entry_t* const* pp_answers, int answer_count)
+{
+    if (answer_count <= 1) return 0;
+    int counts[MAX_PATTERNS] = { 0 };
+    for (int i = 0; i < answer_count; i++) counts[reference_code(guess, pp_answers[i]->word)]++;
+    return calculate_entropy_score_from_histogram(counts, answer_count);
+}
+
+/*
+ * HELPER: check_feedback
+ *
+ * WHAT:
+ * 1. Named edge cases with hand-checked patterns.
+ * 2. Every pair of words over the alphabet A-D (1,024 words, every shape of
+ * repeated letters on both sides).
+ * 3. Random dictionary pairs.
+ * Each pair: the integer index equals the reference code, and decoding the
+ * index gives back the reference string.
+ */
+static bool check_feedback(const dictionary_entry_t* p_dictionary, int count, unsigned long long* p_rng)
+{
+    check_result_t check;
+    begin_check(&check, "Feedback patterns");
+
+    // 1. Edge cases (guess, answer, expected)
+    static const char* EDGE_CASES[][3] = {
+        { "SPEED", "ABIDE", "BBYBY" }, { "SPEED", "ERASE", "YBYYB" }, { "ERASE", "SPEED", "YBBYY" },
+        { "ABBEY", "BABES", "YYGGB" }, { "LLAMA", "HELLO", "YYBBB" }, { "EERIE", "THREE", "YBGBG" },
+    };
+    for (size_t i = 0; i < sizeof(EDGE_CASES) / sizeof(EDGE_CASES[0]); i++)
+    {
+        char pattern[WORDLE_WORD_LENGTH + 1];
+        get_feedback_pattern(EDGE_CASES[i][0], EDGE_CASES[i][1], pattern);
+        if (count_comparison(&check, strcmp(pattern, EDGE_CASES[i][2]) == 0))
+        {
+            sprintf_s(check.first_mismatch, sizeof(check.first_mismatch), "reference %s vs %s gave %s, expected %s",
+                EDGE_CASES[i][0], EDGE_CASES[i][1], pattern, EDGE_CASES[i][2]);
+        }
+    }
+
+    // 2 + 3. Index against reference
+    const int ALPHABET = 4;
+    int small_words = 1;
+    for (int i = 0; i < WORDLE_WORD_LENGTH; i++) small_words *= ALPHABET;
+
+    char guess[WORDLE_WORD_LENGTH + 1] = "";
+    char answer[WORDLE_WORD_LENGTH + 1] = "";
+    long long total_pairs = (long long)small_words * small_words + VERIFY_RANDOM_PAIRS;
+    for (long long pair = 0; pair < total_pairs; pair++)
+    {
+        if (pair < (long long)small_words * small_words)
+        {
+            int g = (int)(pair / small_words), a = (int)(pair % small_words);
+            for (int i = 0; i < WORDLE_WORD_LENGTH; i++, g /= ALPHABET, a /= ALPHABET)
+            {
+                guess[i] = (char)('A' + g % ALPHABET);
+                answer[i] = (char)('A' + a % ALPHABET);
+            }
+        }
+        else
+        {
+            strcpy_s(guess, sizeof(guess), p_dictionary[next_random(p_rng) % count].word);
+            strcpy_s(answer, sizeof(answer), p_dictionary[next_random(p_rng) % count].word);
+        }
+
+        char reference[WORDLE_WORD_LENGTH + 1], decoded[WORDLE_WORD_LENGTH + 1];
+        get_feedback_pattern(guess, answer, reference);
+        int index = get_feedback_index(guess, answer);
+        decode_feedback_index(index, decoded);
+        bool is_equal = (index == reference_code(guess, answer) && strcmp(decoded, reference) == 0 && encode_feedback_pattern(reference) == index);
+        if (count_comparison(&check, is_equal))
+        {
+            sprintf_s(check.first_mismatch, sizeof(check.first_mismatch), "%s vs %s: reference %s, index %d decodes to %s",
+                guess, answer, reference, index, decoded);
+        }
+    }
+    return finish_check(&check);
+}
+
+/*
+ * HELPER: check_pattern_rows
+ *
+ * WHAT:
+ * Random guesses' cached rows against the reference code of every answer.
+ */
+static bool check_pattern_rows(pattern_cache_t* p_cache, const dictionary_entry_t* p_work, int count, unsigned long long* p_rng)
+{
+    check_result_t check;
+    begin_check(&check, "Pattern cache rows");
+    for (int g = 0; g < VERIFY_ROW_GUESSES; g++)
+    {
+        const dictionary_entry_t* p_guess = &p_work[next_random(p_rng) % count];
+        const unsigned char* p_row = pattern_cache_acquire_row(p_cache, p_guess->dictionary_index);
+        if (p_row == NULL) continue; // Not admitted: nothing cached to check
+
+        for (int a = 0; a < count; a++)
+        {
+            int expected = reference_code(p_guess->word, p_work[a].word);
+            if (count_comparison(&check, p_row[p_work[a].dictionary_index] == expected))
+            {
+                sprintf_s(check.first_mismatch, sizeof(check.first_mismatch), "row %s, answer %s: cached %d, reference %d",
+                    p_guess->word, p_work[a].word, p_row[p_work[a].dictionary_index], expected);
+            }
+        }
+        pattern_cache_release_row(p_cache, p_guess->dictionary_index);
+    }
+    return finish_check(&check);
+}
+
+/*
+ * HELPER: compare_entropy_orders
+ *
+ * WHAT:
+ * Sorts both arrays with the engine's comparator and compares the word
+ * sequences (so ties must break the same way too).
+ */
+static bool compare_entropy_orders(dictionary_entry_t* p_a, dictionary_entry_t* p_b, int count, check_result_t* p_check, const char* label)
+{
+    dictionary_pointer_array_t p_view_a = NULL, p_view_b = NULL;
+    duplicate_dictionary_pointers(p_a, count, &p_view_a, compare_dictionary_entries_by_entropy_no_filter_desc);
+    duplicate_dictionary_pointers(p_b, count, &p_view_b, compare_dictionary_entries_by_entropy_no_filter_desc);
+    bool is_equal = (p_view_a != NULL && p_view_b != NULL);
+    for (int i = 0; is_equal && i < count; i++)
+    {
+        if (strcmp(p_view_a[i]->word, p_view_b[i]->word) != 0)
+        {
+            is_equal = false;
+            if (count_comparison(p_check, false))
+            {
+                sprintf_s(p_check->first_mismatch, sizeof(p_check->first_mismatch), "%s order differs at rank %d: %s vs %s",
+                    label, i, p_view_a[i]->word, p_view_b[i]->word);
+            }
+        }
+    }
+    if (is_equal) count_comparison(p_check, true);
+    tracked_free(p_view_a); tracked_free(p_view_b);
+    return is_equal;
+}
+
+/*
+ * HELPER: check_entropy
+ *
+ * WHAT:
+ * For answer sets of several sizes drawn from the sample:
+ * 1. Direct and row-lookup kernels: the reference score exactly, same order.
+ * 2. The Hard Mode pass (`calculate_entropy_on_dictionary`) likewise.
+ * 3. `calculate_partition_stats`: the same score, expected bucket size to
+ * 1e-9 (it has its own loop), exact bucket maximum and count.
+ * 4. The fixed-point score against -Sum( p * log2(p) ) in doubles, to 1e-9.
+ * 5. `calculate_small_set_stats` (answer sets up to SMALL_SET_MAX_ANSWERS):
+ * the reference score exactly, exact bucket statistics.
+ */
+static bool check_entropy(dictionary_entry_t* p_sample, int sample_count, unsigned long long* p_rng)
+{
+    check_result_t check;
+    begin_check(&check, "Entropy kernels and order");
+
+    dictionary_entry_t* p_reference = (dictionary_entry_t*)tracked_malloc(sizeof(dictionary_entry_t) * sample_count);
+    dictionary_entry_t* p_fast = (dictionary_entry_t*)tracked_malloc(sizeof(dictionary_entry_t) * sample_count);
+    dictionary_entry_t** pp_answers = (dictionary_entry_t**)tracked_malloc(sizeof(dictionary_entry_t*) * sample_count);
+    if (!p_reference || !p_fast || !pp_answers)
+    {
+        tracked_free(p_reference); tracked_free(p_fast); tracked_free(pp_answers);
+        printf("  [FAIL] %-34s out of memory\n", check.name);
+        return false;
+    }
+
+    tuning_config_t saved = g_tuning_config;
+    const int ANSWER_SIZES[] = { 1, 2, 7, SMALL_SET_MAX_ANSWERS, SMALL_SET_MAX_ANSWERS + 1, 60, sample_count };
+    for (size_t s = 0; s < sizeof(ANSWER_SIZES) / sizeof(ANSWER_SIZES[0]); s++)
+    {
+        int answer_count = (ANSWER_SIZES[s] < sample_count) ? ANSWER_SIZES[s] : sample_count;
+        for (int i = 0; i < answer_count; i++) pp_answers[i] = &p_sample[next_random(p_rng) % sample_count];
+
+        memcpy(p_reference, p_sample, sizeof(dictionary_entry_t) * sample_count);
+        for (int i = 0; i < sample_count; i++) p_reference[i].entropy_score = reference_entropy(p_reference[i].word, pp_answers, answer_count);
+
+        // 1. Both kernels
+        for (int kernel = ENTROPY_KERNEL_DIRECT; kernel <= ENTROPY_KERNEL_ROW_LOOKUP; kernel++)
+        {
+            g_tuning_config.entropy_kernel = kernel;
+            memcpy(p_fast, p_sample, sizeof(dictionary_entry_t) * sample_count);
+            calculate_entropy_for_candidates(p_fast, sample_count, pp_answers, answer_count);
+            for (int i = 0; i < sample_count; i++)
+            {
+                if (count_comparison(&check, p_fast[i].entropy_score == p_reference[i].entropy_score))
+                {
+                    sprintf_s(check.first_mismatch, sizeof(check.first_mismatch), "%s kernel, %s vs %d answers: %lld, reference %lld",
+                        (kernel == ENTROPY_KERNEL_DIRECT) ? "direct" : "row-lookup", p_fast[i].word, answer_count, p_fast[i].entropy_score, p_reference[i].entropy_score);
+                }
+            }
+            compare_entropy_orders(p_fast, p_reference, sample_count, &check, (kernel == ENTROPY_KERNEL_DIRECT) ? "direct kernel" : "row-lookup kernel");
+        }
+        g_tuning_config = saved;
+
+        // 3. Partition statistics, 4. the formula and 5. the small-set kernel
+        for (int i = 0; i < sample_count; i += 7)
+        {
+            partition_stats_t stats;
+            calculate_partition_stats(&p_sample[i], pp_answers, answer_count, &stats);
+
+            int counts[MAX_PATTERNS] = { 0 };
+            for (int a = 0; a < answer_count; a++) counts[reference_code(p_sample[i].word, pp_answers[a]->word)]++;
+            long sum_squares = 0;
+            int max_bucket = 0, bucket_count = 0, singleton_count = 0;
+            double textbook = 0.0;
+            for (int b = 0; b < MAX_PATTERNS; b++)
+            {
+                if (counts[b] == 0) continue;
+                double p = (double)counts[b] / answer_count;
+                textbook -= p * log2(p);
+                sum_squares += (long)counts[b] * counts[b];
+                if (counts[b] > max_bucket) max_bucket = counts[b];
+                if (counts[b] == 1) singleton_count++;
+                bucket_count++;
+            }
+            double reference_bits = ENTROPY_SCORE_TO_BITS(p_reference[i].entropy_score);
+            bool is_equal = stats.entropy_score == p_reference[i].entropy_score && stats.max_bucket == max_bucket && stats.bucket_count == bucket_count &&
+                fabs(stats.expected_remaining - (double)sum_squares / answer_count) < 1e-9 && (answer_count <= 1 || fabs(textbook - reference_bits) < 1e-9);
+            if (count_comparison(&check, is_equal))
+            {
+                sprintf_s(check.first_mismatch, sizeof(check.first_mismatch), "partition stats of %s vs %d answers: H %.12f/%.12f/%.12f, max %d/%d, buckets %d/%d",
+                    p_sample[i].word, answer_count, ENTROPY_SCORE_TO_BITS(stats.entropy_score), reference_bits, textbook, stats.max_bucket, max_bucket, stats.bucket_count, bucket_count);
+            }
+
+            if (answer_count > SMALL_SET_MAX_ANSWERS) continue;
+            small_set_stats_t small;
+            calculate_small_set_stats(p_sample[i].word, pp_answers, answer_count, &small);
+            is_equal = small.entropy_score == p_reference[i].entropy_score && small.bucket_count == bucket_count && small.max_bucket == max_bucket &&
+                small.singleton_count == singleton_count && small.sum_squares == sum_squares;
+            if (count_comparison(&check, is_equal))
+            {
+                sprintf_s(check.first_mismatch, sizeof(check.first_mismatch), "small-set stats of %s vs %d answers: H %lld/%lld, buckets %d/%d, singletons %d/%d",
+                    p_sample[i].word, answer_count, small.entropy_score, p_reference[i].entropy_score, small.bucket_count, bucket_count, small.singleton_count, singleton_count);
+            }
+        }
+    }
+
+    // 2. Hard Mode pass: entropy of each live word against the live words
+    memcpy(p_fast, p_sample, sizeof(dictionary_entry_t) * sample_count);
+    int live_count = 0;
+    for (int i = 0; i < sample_count; i++)
+    {
+        p_fast[i].is_eliminated = (next_random(p_rng) & 1) != 0;
+        if (!p_fast[i].is_eliminated) pp_answers[live_count++] = &p_fast[i];
+    }
+    memcpy(p_reference, p_fast, sizeof(dictionary_entry_t) * sample_count);
+    for (int i = 0; i < sample_count; i++)
+    {
+        p_reference[i].entropy_score = p_reference[i].is_eliminated ? 0 : reference_entropy(p_reference[i].word, pp_answers, live_count);
+    }
+    calculate_entropy_on_dictionary(p_fast, sample_count);
+    for (int i = 0; i < sample_count; i++)
+    {
+        if (count_comparison(&check, p_fast[i].entropy_score == p_reference[i].entropy_score))
+        {
+            sprintf_s(check.first_mismatch, sizeof(check.first_mismatch), "Hard Mode pass, %s: %lld, reference %lld",
+                p_fast[i].word, p_fast[i].entropy_score, p_reference[i].entropy_score);
+        }
+    }
+    compare_entropy_orders(p_fast, p_reference, sample_count, &check, "Hard Mode pass");
+
+    tracked_free(p_reference); tracked_free(p_fast); tracked_free(pp_answers);
+    return finish_check(&check);
+}
+
+/*
+ * HELPER: check_entropy_views
+ *
+ * WHAT:
+ * The radix-sorted entropy views (`duplicate_dictionary_pointers`) against
+ * `qsort` with the same comparator, for both entropy comparators. Scores
+ * come from small answer sets and the eliminated flags are random, so most
+ * words tie on score and the order rests on the tie-breaker chain.
+ */
+static bool check_entropy_views(const dictionary_entry_t* p_sample, int sample_count, unsigned long long* p_rng)
+{
+    check_result_t check;
+    begin_check(&check, "Radix entropy views");
+
+    dictionary_entry_t* p_words = (dictionary_entry_t*)tracked_malloc(sizeof(dictionary_entry_t) * sample_count);
+    dictionary_entry_t** pp_answers = (dictionary_entry_t**)tracked_malloc(sizeof(dictionary_entry_t*) * sample_count);
+    dictionary_entry_t** pp_sorted = (dictionary_entry_t**)tracked_malloc(sizeof(dictionary_entry_t*) * sample_count);
+    if (!p_words || !pp_answers || !pp_sorted)
+    {
+        tracked_free(p_words); tracked_free(pp_answers); tracked_free(pp_sorted);
+        printf("  [FAIL] %-34s out of memory\n", check.name);
+        return false;
+    }
+    memcpy(p_words, p_sample, sizeof(dictionary_entry_t) * sample_count);
+
+    const int ANSWER_SIZES[] = { 1, 2, 7, 60 };
+    for (size_t s = 0; s < sizeof(ANSWER_SIZES) / sizeof(ANSWER_SIZES[0]); s++)
+    {
+        int answer_count = (ANSWER_SIZES[s] < sample_count) ? ANSWER_SIZES[s] : sample_count;
+        for (int i = 0; i < answer_count; i++) pp_answers[i] = (dictionary_entry_t*)&p_sample[next_random(p_rng) % sample_count];
+        for (int i = 0; i < sample_count; i++)
+        {
+            p_words[i].entropy_score = reference_entropy(p_words[i].word, pp_answers, answer_count);
+            p_words[i].is_eliminated = (next_random(p_rng) & 1) != 0;
+        }
+
+        for (int is_valid_first = 0; is_valid_first <= 1; is_valid_first++)
+        {
+            int (*compare_func)(const void*, const void*) = is_valid_first ? compare_dictionary_entries_by_entropy_desc : compare_dictionary_entries_by_entropy_no_filter_desc;
+            dictionary_pointer_array_t p_view = NULL;
+            duplicate_dictionary_pointers(p_words, sample_count, &p_view, compare_func);
+            for (int i = 0; i < sample_count; i++) pp_sorted[i] = &p_words[i];
+            qsort(pp_sorted, sample_count, sizeof(dictionary_entry_t*), compare_func);
+
+            int rank = 0;
+            while (p_view != NULL && rank < sample_count && p_view[rank] == pp_sorted[rank]) rank++;
+            if (count_comparison(&check, rank == sample_count))
+            {
+                if (p_view == NULL) strcpy_s(check.first_mismatch, sizeof(check.first_mismatch), "view allocation failed");
+                else sprintf_s(check.first_mismatch, sizeof(check.first_mismatch), "%s view vs %d answers differs at rank %d: %s vs qsort %s",
+                    is_valid_first ? "valid-first" : "no-filter", answer_count, rank, p_view[rank]->word, pp_sorted[rank]->word);
+            }
+            tracked_free(p_view);
+        }
+    }
+
+    tracked_free(p_words); tracked_free(pp_answers); tracked_free(pp_sorted);
+    return finish_check(&check);
+}
+
+/*
+ * HELPER: compare_table_entropy
+ *
+ * WHAT:
+ * After a table update: both the exact and the running-sum entropy equal
+ * the reference score over the current words.
+ */
+static void compare_table_entropy(const partition_table_t* p_table, dictionary_entry_t* p_words, int count, check_result_t* p_check, const char* step)
+{
+    dictionary_entry_t** pp_all = (dictionary_entry_t**)tracked_malloc(sizeof(dictionary_entry_t*) * count);
+    long long* p_running = (long long*)tracked_malloc(sizeof(long long) * count);
+    if (!pp_all || !p_running) { tracked_free(pp_all); tracked_free(p_running); return; }
+    for (int i = 0; i < count; i++) pp_all[i] = &p_words[i];
+
+    partition_table_apply_entropy(p_table, p_words);
+    for (int i = 0; i < count; i++) p_running[i] = p_words[i].entropy_score;
+    partition_table_apply_exact_entropy(p_table, p_words);
+
+    for (int i = 0; i < count; i++)
+    {
+        long long expected = reference_entropy(p_words[i].word, pp_all, count);
+        bool is_equal = (p_words[i].entropy_score == expected && p_running[i] == expected);
+        if (count_comparison(p_check, is_equal))
+        {
+            sprintf_s(p_check->first_mismatch, sizeof(p_check->first_mismatch), "after %s, %s: exact %lld, running %lld, reference %lld",
+                step, p_words[i].word, p_words[i].entropy_score, p_running[i], expected);
+        }
+    }
+    tracked_free(pp_all); tracked_free(p_running);
+}
+
+/*
+ * HELPER: check_partition_table
+ *
+ * WHAT:
+ * Build on the sample, then batch-remove ~10%, remove one more word, and
+ * insert it back, comparing against the reference after every step.
+ */
+static bool check_partition_table(const dictionary_entry_t* p_sample, int sample_count, unsigned long long* p_rng)
+{
+    check_result_t check;
+    begin_check(&check, "Incremental partition table");
+
+    dictionary_entry_t* p_words = (dictionary_entry_t*)tracked_malloc(sizeof(dictionary_entry_t) * sample_count);
+    int* p_indices = (int*)tracked_malloc(sizeof(int) * sample_count);
+    partition_table_t table;
+    if (!p_words || !p_indices || sample_count < 4)
+    {
+        tracked_free(p_words); tracked_free(p_indices);
+        printf("  [FAIL] %-34s out of memory\n", check.name);
+        return false;
+    }
+    memcpy(p_words, p_sample, sizeof(dictionary_entry_t) * sample_count);
+    qsort(p_words, sample_count, sizeof(dictionary_entry_t), compare_master_entries_eliminated_then_alpha);
+    int count = sample_count;
+
+    if (!build_partition_table(&table, p_words, count))
+    {
+        tracked_free(p_words); tracked_free(p_indices);
+        printf("  [FAIL] %-34s out of memory\n", check.name);
+        return false;
+    }
+    compare_table_entropy(&table, p_words, count, &check, "build");
+
+    // Batch removal (ascending indices), mirrored in the word array
+    int removed = 0;
+    for (int i = 0; i < count; i++)
+    {
+        if (next_random(p_rng) % 10 == 0) p_indices[removed++] = i;
+    }
+    partition_table_remove_words(&table, p_words, p_indices, removed);
+    int kept = 0;
+    for (int i = 0, r = 0; i < count; i++)
+    {
+        if (r < removed && p_indices[r] == i) { r++; continue; }
+        p_words[kept++] = p_words[i];
+    }
+    count = kept;
+    compare_table_entropy(&table, p_words, count, &check, "batch removal");
+
+    // Single removal, then insert the same word back where it was
+    int index = (int)(next_random(p_rng) % count);
+    dictionary_entry_t word = p_words[index];
+    partition_table_remove_word(&table, p_words, index);
+    memmove(&p_words[index], &p_words[index + 1], sizeof(dictionary_entry_t) * (count - index - 1));
+    count--;
+    compare_table_entropy(&table, p_words, count, &check, "single removal");
+
+    memmove(&p_words[index + 1], &p_words[index], sizeof(dictionary_entry_t) * (count - index));
+    p_words[index] = word;
+    count++;
+    if (partition_table_insert_word(&table, p_words, count, index)) compare_table_entropy(&table, p_words, count, &check, "insert");
+    else if (count_comparison(&check, false)) strcpy_s(check.first_mismatch, sizeof(check.first_mismatch), "insert failed (out of memory)");
+
+    free_partition_table(&table);
+    tracked_free(p_words); tracked_free(p_indices);
+    return finish_check(&check);
+}
+
+/*
+ * HELPER: check_filter
+ *
+ * WHAT:
+ * Random (guess, answer) pairs over the whole dictionary. A word must be
+ * eliminated exactly when it would not have produced the observed pattern,
+ * and the Zobrist state must match a full rehash.
+ */
+static bool check_filter(const dictionary_entry_t* p_dictionary, int count, unsigned long long* p_rng)
+{
+    check_result_t check;
+    begin_check(&check, "Constraint filter");
+
+    dictionary_entry_t* p_scratch = (dictionary_entry_t*)tracked_malloc(sizeof(dictionary_entry_t) * count);
+    if (!p_scratch)
+    {
+        printf("  [FAIL] %-34s out of memory\n", check.name);
+        return false;
+    }
+
+    for (int trial = 0; trial < VERIFY_FILTER_TRIALS; trial++)
+    {
+        const char* guess = p_dictionary[next_random(p_rng) % count].word;
+        const char* answer = p_dictionary[next_random(p_rng) % count].word;
+        char pattern[WORDLE_WORD_LENGTH + 1];
+        get_feedback_pattern(guess, answer, pattern);
+
+        memcpy(p_scratch, p_dictionary, sizeof(dictionary_entry_t) * count);
+        game_state_t state;
+        init_game_state(&state, p_scratch, count);
+        filter_dictionary_by_constraints(p_scratch, count, guess, pattern, &state);
+
+        int observed = reference_code(guess, answer);
+        for (int i = 0; i < count; i++)
+        {
+            bool expected = p_dictionary[i].is_eliminated || reference_code(guess, p_dictionary[i].word) != observed;
+            if (count_comparison(&check, p_scratch[i].is_eliminated == expected))
+            {
+                sprintf_s(check.first_mismatch, sizeof(check.first_mismatch), "guess %s, answer %s (%s): %s was %s",
+                    guess, answer, pattern, p_dictionary[i].word, p_scratch[i].is_eliminated ? "eliminated" : "kept");
+            }
+        }
+        if (count_comparison(&check, verify_game_state(&state, p_scratch, count)))
+        {
+            sprintf_s(check.first_mismatch, sizeof(check.first_mismatch), "guess %s, answer %s: candidate hash drifted", guess, answer);
+        }
+    }
+
+    tracked_free(p_scratch);
+    return finish_check(&check);
+}
+
+/*
+ * HELPER: count_allocations
+ *
+ * WHAT:
+ * One comparison per hot-path call: it must not have allocated. Nothing
+ * else runs during the verification, so the process-wide count is exact.
+ */
+static void count_allocations(check_result_t* p_check, long long before, const char* path)
+{
+    long long allocations = get_allocation_count() - before;
+    if (count_comparison(p_check, allocations == 0))
+    {
+        sprintf_s(p_check->first_mismatch, sizeof(p_check->first_mismatch), "%s made %lld allocation(s)", path, allocations);
+    }
+}
+
+/*
+ * HELPER: check_allocation_free
+ *
+ * WHAT:
+ * The paths that run for every guess of every game must not touch the heap
+ * (see alloc_tracker.h): feedback codes, the constraint filter, the
+ * small-set kernel, an entropy pass whose pattern rows are already
+ * cached, and a direct-kernel pass with the thread's profile buffer bound
+ * (as game threads do). Buffers are allocated before counting starts.
+ */
+static bool check_allocation_free(const dictionary_entry_t* p_work, int count, unsigned long long* p_rng)
+{
+    check_result_t check;
+    begin_check(&check, "Allocation-free hot paths");
+
+    int guess_count = (count < VERIFY_ROW_GUESSES) ? count : VERIFY_ROW_GUESSES;
+    int answer_count = (count / 32 > SMALL_SET_MAX_ANSWERS) ? count / 32 : ((count < SMALL_SET_MAX_ANSWERS) ? count : SMALL_SET_MAX_ANSWERS);
+    dictionary_entry_t* p_scratch = (dictionary_entry_t*)tracked_malloc(sizeof(dictionary_entry_t) * count);
+    dictionary_entry_t* p_guesses = (dictionary_entry_t*)tracked_malloc(sizeof(dictionary_entry_t) * guess_count);
+    dictionary_entry_t** pp_answers = (dictionary_entry_t**)tracked_malloc(sizeof(dictionary_entry_t*) * answer_count);
+    void* p_profiles = tracked_malloc(entropy_profile_buffer_bytes(answer_count));
+    if (!p_scratch || !p_guesses || !pp_answers || !p_profiles)
+    {
+        tracked_free(p_scratch); tracked_free(p_guesses); tracked_free(pp_answers); tracked_free(p_profiles);
+        printf("  [FAIL] %-34s out of memory\n", check.name);
+        return false;
+    }
+    for (int g = 0; g < guess_count; g++) p_guesses[g] = p_work[next_random(p_rng) % count];
+    for (int a = 0; a < answer_count; a++) pp_answers[a] = (dictionary_entry_t*)&p_work[next_random(p_rng) % count];
+
+    for (int trial = 0; trial < VERIFY_ALLOCATION_TRIALS; trial++)
+    {
+        const char* guess = p_work[next_random(p_rng) % count].word;
+        const char* answer = p_work[next_random(p_rng) % count].word;
+        char pattern[WORDLE_WORD_LENGTH + 1];
+        get_feedback_pattern(guess, answer, pattern);
+        memcpy(p_scratch, p_work, sizeof(dictionary_entry_t) * count);
+        game_state_t state;
+        init_game_state(&state, p_scratch, count);
+
+        long long before = get_allocation_count();
+        volatile int code = get_feedback_index(guess, answer);
+        (void)code;
+        count_allocations(&check, before, "get_feedback_index");
+
+        before = get_allocation_count();
+        filter_dictionary_by_constraints(p_scratch, count, guess, pattern, &state);
+        count_allocations(&check, before, "filter_dictionary_by_constraints");
+
+        small_set_stats_t stats;
+        int small_count = (answer_count < SMALL_SET_MAX_ANSWERS) ? answer_count : SMALL_SET_MAX_ANSWERS;
+        before = get_allocation_count();
+        calculate_small_set_stats(guess, pp_answers, small_count, &stats);
+        count_allocations(&check, before, "calculate_small_set_stats");
+    }
+
+    // The first pass fills the guesses' rows; the second may only read them
+    tuning_config_t saved = g_tuning_config;
+    g_tuning_config.entropy_kernel = ENTROPY_KERNEL_ROW_LOOKUP;
+    calculate_entropy_for_candidates(p_guesses, guess_count, pp_answers, answer_count);
+    long long before = get_allocation_count();
+    calculate_entropy_for_candidates(p_guesses, guess_count, pp_answers, answer_count);
+    count_allocations(&check, before, "warm row-lookup entropy pass");
+
+    // The direct kernel rebuilds the answer profiles in the bound buffer
+    g_tuning_config.entropy_kernel = ENTROPY_KERNEL_DIRECT;
+    bind_entropy_profile_buffer(p_profiles, answer_count);
+    before = get_allocation_count();
+    calculate_entropy_for_candidates(p_guesses, guess_count, pp_answers, answer_count);
+    count_allocations(&check, before, "direct-kernel entropy pass");
+    bind_entropy_profile_buffer(NULL, 0);
+    g_tuning_config = saved;
+
+    tracked_free(p_scratch); tracked_free(p_guesses); tracked_free(pp_answers); tracked_free(p_profiles);
+    return finish_check(&check);
+}
+
+/*
+ * HELPER: find_verify_opener
+ *
+ * WHAT:
+ * SALET if the dictionary has it, else its first word.
+ */
+static const char* find_verify_opener(const dictionary_entry_t* p_work, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        if (strcmp(p_work[i].word, "SALET") == 0) return p_work[i].word;
+    }
+    return p_work[0].word;
+}
+
+/*
+ * HELPER: check_budgeted_publication
+ *
+ * WHAT:
+ * Look Ahead games under a budget too small for any Look Ahead to finish,
+ * with a shared cache open on a scratch file. Complete decisions are
+ * published and cut-short ones are not, so the cache's inserts must equal
+ * the decisions minus the deadline hits (and some decisions must have hit
+ * the deadline, or nothing was tested).
+ */
+static bool check_budgeted_publication(const dictionary_entry_t* p_work, int count, unsigned long long* p_rng)
+{
+    const int LOOK_AHEAD_STRATEGY = 9;
+    const double TINY_BUDGET_MS = 1e-6;
+    check_result_t check;
+    begin_check(&check, "Budgeted decisions not published");
+
+    remove(VERIFY_SHARED_CACHE_FILE);
+    shared_state_cache_t cache;
+    if (!open_shared_state_cache(&cache, VERIFY_SHARED_CACHE_FILE, compute_shared_cache_version(p_work, count, g_isHardMode, TINY_BUDGET_MS)))
+    {
+        remove(VERIFY_SHARED_CACHE_FILE);
+        printf("  [FAIL] %-34s could not create %s\n", check.name, VERIFY_SHARED_CACHE_FILE);
+        return false;
+    }
+
+    shared_state_cache_t* p_saved_cache = g_p_shared_cache;
+    single_flight_t* p_saved_flight = g_p_single_flight;
+    double saved_budget_ms = g_decision_budget_ms;
+    g_p_shared_cache = &cache;
+    g_p_single_flight = NULL;
+    g_decision_budget_ms = TINY_BUDGET_MS;
+
+    const char* opening_word = find_verify_opener(p_work, count);
+    long long completed = 0, deadline_hits = 0;
+    for (int game = 0; game < VERIFY_GAMES_PER_STRATEGY; game++)
+    {
+        const dictionary_entry_t* p_target = &p_work[next_random(p_rng) % count];
+        char guess_log[6][WORDLE_WORD_LENGTH + 1];
+        traced_decisions_t traced;
+        memset(&traced, 0, sizeof(traced));
+        trace_simulated_game(LOOK_AHEAD_STRATEGY, p_work, count, p_target, opening_word, guess_log, &traced);
+        completed += traced.decisions - traced.deadline_hits;
+        deadline_hits += traced.deadline_hits;
+
+        if (count_comparison(&check, cache.inserts == completed))
+        {
+            sprintf_s(check.first_mismatch, sizeof(check.first_mismatch), "answer %s: %lld cache inserts after %lld complete decisions (%lld cut short)",
+                p_target->word, cache.inserts, completed, deadline_hits);
+        }
+    }
+    if (count_comparison(&check, deadline_hits > 0))
+    {
+        strcpy_s(check.first_mismatch, sizeof(check.first_mismatch), "no decision hit the deadline (nothing tested)");
+    }
+
+    g_decision_budget_ms = saved_budget_ms;
+    g_p_single_flight = p_saved_flight;
+    g_p_shared_cache = p_saved_cache;
+    close_shared_state_cache(&cache);
+    remove(VERIFY_SHARED_CACHE_FILE);
+    return finish_check(&check);
+}
+
+/*
+ * HELPER: check_tournament
+ *
+ * WHAT:
+ * The tournament roster plays random answers twice: as configured (pattern
+ * cache, tuned kernel, all threads for the look-ahead) and on the plain path
+ * (no cache, direct kernel, one thread). Every guess of every game must match.
+ */
+static bool check_tournament(pattern_cache_t* p_cache, const dictionary_entry_t* p_work, int count, unsigned long long* p_rng)
+{
+    check_result_t check;
+    begin_check(&check, "Tournament decisions");
+
+    const int ROSTER[] = { 0, 9, 5, 2 };
+    const char* opening_word = find_verify_opener(p_work, count);
+
+    tuning_config_t saved = g_tuning_config;
+    int saved_threads = omp_get_max_threads();
+    for (size_t r = 0; r < sizeof(ROSTER) / sizeof(ROSTER[0]); r++)
+    {
+        for (int game = 0; game < VERIFY_GAMES_PER_STRATEGY; game++)
+        {
+            const dictionary_entry_t* p_target = &p_work[next_random(p_rng) % count];
+            char fast_log[6][WORDLE_WORD_LENGTH + 1], plain_log[6][WORDLE_WORD_LENGTH + 1];
+            memset(fast_log, 0, sizeof(fast_log));
+            memset(plain_log, 0, sizeof(plain_log));
+
+            g_p_pattern_cache = p_cache;
+            g_tuning_config = saved;
+            omp_set_num_threads(saved_threads);
+            int fast_result = trace_simulated_game(ROSTER[r], p_work, count, p_target, opening_word, fast_log, NULL);
+
+            g_p_pattern_cache = NULL;
+            g_tuning_config.entropy_kernel = ENTROPY_KERNEL_DIRECT;
+            g_tuning_config.thread_count = 1;
+            omp_set_num_threads(1);
+            int plain_result = trace_simulated_game(ROSTER[r], p_work, count, p_target, opening_word, plain_log, NULL);
+
+            bool is_equal = (fast_result == plain_result && memcmp(fast_log, plain_log, sizeof(fast_log)) == 0);
+            if (count_comparison(&check, is_equal))
+            {
+                int turn = 0;
+                while (turn < 5 && strcmp(fast_log[turn], plain_log[turn]) == 0) turn++;
+                sprintf_s(check.first_mismatch, sizeof(check.first_mismatch), "%s, answer %s, turn %d: %s vs plain %s",
+                    ALL_STRATEGIES[ROSTER[r]].name, p_target->word, turn + 1, fast_log[turn], plain_log[turn]);
+            }
+        }
+    }
+    g_p_pattern_cache = p_cache;
+    g_tuning_config = saved;
+    omp_set_num_threads(saved_threads);
+    return finish_check(&check);
+}
+
+/*
+ * FUNCTION: run_differential_verification
+ *
+ * WHAT:
+ * 1. Work on a copy with its own pattern cache (so rows are stamped).
+ * 2. Draw the quadratic-check sample.
+ * 3. Run the checks and summarize.
+ */
+bool run_differential_verification(const dictionary_entry_t* p_dictionary, int count, unsigned long long seed)
+{
+    printf("\n=============================================\n");
+    printf("   DIFFERENTIAL VERIFICATION\n");
+    printf("   Words: %d  Seed: %llu\n", count, seed);
+    printf("=============================================\n\n");
+    if (count < 4) { printf("  Need at least 4 words.\n"); return false; }
+
+    // 1. Working copy and cache
+    dictionary_entry_t* p_work = (dictionary_entry_t*)tracked_malloc(sizeof(dictionary_entry_t) * count);
+    if (!p_work) { printf("  Out of memory.\n"); return false; }
+    memcpy(p_work, p_dictionary, sizeof(dictionary_entry_t) * count);
+    for (int i = 0; i < count; i++) p_work[i].is_eliminated = false;
+
+    pattern_cache_t cache;
+    pattern_cache_t* p_saved_cache = g_p_pattern_cache;
+    if (!init_pattern_cache(&cache, p_work, count, (size_t)PATTERN_CACHE_DEFAULT_BUDGET_MB * 1024 * 1024))
+    {
+        printf("  Could not allocate the pattern cache.\n");
+        tracked_free(p_work);
+        return false;
+    }
+    g_p_pattern_cache = &cache;
+
+    // 2. Sample (partial Fisher-Yates over a copy)
+    int sample_count = (count < VERIFY_ENTROPY_SAMPLE) ? count : VERIFY_ENTROPY_SAMPLE;
+    dictionary_entry_t* p_sample = (dictionary_entry_t*)tracked_malloc(sizeof(dictionary_entry_t) * count);
+    if (!p_sample)
+    {
+        g_p_pattern_cache = p_saved_cache;
+        free_pattern_cache(&cache);
+        tracked_free(p_work);
+        printf("  Out of memory.\n");
+        return false;
+    }
+    memcpy(p_sample, p_work, sizeof(dictionary_entry_t) * count);
+    unsigned long long rng = seed;
+    for (int i = 0; i < sample_count; i++)
+    {
+        int j = i + (int)(next_random(&rng) % (unsigned long long)(count - i));
+        dictionary_entry_t tmp = p_sample[i]; p_sample[i] = p_sample[j]; p_sample[j] = tmp;
+    }
+
+    // 3. Checks
+    int failures = 0;
+    if (!check_feedback(p_work, count, &rng)) failures++;
+    if (!check_pattern_rows(&cache, p_work, count, &rng)) failures++;
+    if (!check_entropy(p_sample, sample_count, &rng)) failures++;
+    if (!check_entropy_views(p_sample, sample_count, &rng)) failures++;
+    if (!check_partition_table(p_sample, sample_count, &rng)) failures++;
+    if (!check_filter(p_work, count, &rng)) failures++;
+    if (!check_allocation_free(p_work, count, &rng)) failures++;
+    if (!check_tournament(&cache, p_work, count, &rng)) failures++;
+    if (!check_budgeted_publication(p_work, count, &rng)) failures++;
+
+    g_p_pattern_cache = p_saved_cache;
+    free_pattern_cache(&cache);
+    tracked_free(p_sample);
+    tracked_free(p_work);
+
+    if (failures == 0) printf("\nAll checks passed.\n");
+    else printf("\n%d check(s) FAILED. Re-run with the same seed to reproduce.\n", failures);
+    return failures == 0;
+}
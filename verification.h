@@ -0,0 +1,48 @@
+/*
+ * FILE: verification.h
+ *
+ * WHAT:
+ * Defines the interface for the Differential Verifier (`--verify`). It runs
+ * every optimized path against a deliberately plain reference and reports
+ * the first mismatch of each check:
+ * - Feedback: `get_feedback_index` and the index encoding against the string
+ * reference `get_feedback_pattern`, exhaustively over a 4-letter alphabet
+ * (every duplicate-letter shape), on named edge cases (SPEED/ERASE, ...)
+ * and on random dictionary pairs.
+ * - Pattern rows: cached rows against the reference, byte for byte.
+ * - Entropy: both kernels against a reference histogram built from pattern
+ * strings. Values must be bit-identical and sort in the same order; the
+ * shared histogram formula is checked against the textbook one.
+ * - Partition table: incremental removal against a fresh build.
+ * - Filter: `filter_dictionary_by_constraints` (and its Zobrist state)
+ * against "the word would have produced the same pattern".
+ * - Allocations: feedback, filter, the small-set kernel and a warm
+ * row-lookup entropy pass make no heap allocation (alloc_tracker.h).
+ * - Tournament: whole games with every optimization on against the same
+ * games with the pattern cache off, guess by guess.
+ *
+ * WHY:
+ * Each speed-up (integer patterns, cached rows, incremental histograms,
+ * memoized decisions) is only worth having if it changes nothing. There is
+ * no test suite, so this mode is the safety net: run it after touching any
+ * hot path. Random inputs come from a seed, so a failure can be replayed.
+ */
+
+#pragma once
+#ifndef VERIFICATION_H
+#define VERIFICATION_H
+#include "wordle_types.h"
+
+/*
+ * FUNCTION: run_differential_verification
+ *
+ * WHAT:
+ * Runs every check on `p_dictionary` (not modified) with random samples
+ * drawn from `seed`, printing one PASS/FAIL line per check.
+ *
+ * RETURNS:
+ * - true if every check passed.
+ */
+bool run_differential_verification(const dictionary_entry_t* p_dictionary, int count, unsigned long long seed);
+
+#endif
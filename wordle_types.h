@@ -18,6 +18,7 @@
 
 #include <stdlib.h>
 #include <stdbool.h> 
+#include "platform_compat.h"
 
 /*
  * CONSTANTS: Game Constraints
@@ -27,8 +28,8 @@
  *
  * WHY:
  * WORDLE_WORD_LENGTH is set to 5 for standard Wordle.
- * MAX_DICTIONARY_WORDS creates a safe upper bound for static array allocations
- * if needed, though most heavy lifting is done via dynamic malloc.
+ * MAX_DICTIONARY_WORDS is the initial capacity of the dictionary loader
+ * (which grows past it) and the cap on the used word list.
  */
 const int WORDLE_WORD_LENGTH = 5;
 const int MAX_DICTIONARY_WORDS = 10000; 
@@ -67,17 +68,30 @@ const int MAX_DICTIONARY_WORDS = 10000;
  * 4. is_eliminated (bool):
  * - true  : The word has been ruled out by game logic.
  * - false : The word is still a valid potential answer.
+ *
+ * 5. feedback_mismatches (unsigned char):
+ * - Only used by the noise-tolerant filter (see noise_filter.h).
+ * - Total number of pattern positions, summed over all turns so far, where
+ * the feedback this word WOULD have produced differs from the feedback
+ * that was actually entered. 0 means the word fits every clue exactly.
+ *
+ * 6. dictionary_index (int):
+ * - Only used by the pattern cache (see pattern_cache.h).
+ * - The entry's position in the dictionary the cache was built for, carried
+ * along by every copy. -1 = not part of a cached universe.
  */
 typedef struct _dictionary_entry
 {
     char word[WORDLE_WORD_LENGTH + 1];  /* The five character word + null terminator   */
-    double entropy;                     /* The entropy value of the word (Calculated)  */
+    long long entropy_score;            /* Entropy in bits * 2^32 (Calculated)         */
     int frequency_rank;                 /* Higher values indicate higher frequency     */
                                         /* Values range from 000 to 100                */
     char noun_type;                     /* See Domain Values above ('P','S','N','R')   */
     char verb_type;                     /* See Domain Values above ('T','S','P','N')   */
     bool contains_duplicate_letters;    /* true if the word contains duplicate letters */
     bool is_eliminated;                 /* true if word is ruled out by Hard Mode rule */
+    unsigned char feedback_mismatches;  /* Pattern positions that disagree with input  */
+    int dictionary_index;               /* Row/column in the pattern cache (-1 = none) */
 } dictionary_entry_t;
 
 /*